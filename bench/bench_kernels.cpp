@@ -0,0 +1,234 @@
+// File: bench/bench_kernels.cpp
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "bench_utils.h"
+#include "poisson2d/poisson2d.h"
+
+namespace {
+
+template<typename T, typename Stencil = fluid_dynamics::FivePoint>
+class SolverProbe : public fluid_dynamics::Solver<T, Stencil> {
+ public:
+  using fluid_dynamics::Solver<T, Stencil>::Solver;
+  using fluid_dynamics::Solver<T, Stencil>::MaterializeSource;
+  using fluid_dynamics::Solver<T, Stencil>::Update;
+  using fluid_dynamics::Solver<T, Stencil>::DefaultNorm;
+};
+
+template<typename T, typename Stencil = fluid_dynamics::FivePoint>
+void BM_Update(benchmark::State& state) {
+  auto L = static_cast<size_t>(state.range(0));
+  SolverProbe<T, Stencil> solver;
+  fluid_dynamics::Bound<T> bound = bench_utils::FrameBound<T>(L, L);
+  fluid_dynamics::Grid<T> prev = bench_utils::RandomGrid<T>(L, L);
+  fluid_dynamics::Grid<T> source = solver.MaterializeSource(0, 0, L, L);
+
+  for (auto _ : state) {
+    fluid_dynamics::Grid<T> next = solver.Update(prev, bound, source);
+    benchmark::DoNotOptimize(next.data());
+  }
+
+  bench_utils::SetCellCounters(state, L * L, 3 * sizeof(T));
+}
+
+template<typename T>
+void BM_MaterializeSource(benchmark::State& state) {
+  auto L = static_cast<size_t>(state.range(0));
+  SolverProbe<T> solver;
+
+  solver.source_rows([](size_t, size_t j_begin, size_t j_end, T* out) {
+    std::fill(out, out + (j_end - j_begin), T{1});
+  });
+  for (auto _ : state) {
+    fluid_dynamics::Grid<T> source = solver.MaterializeSource(0, 0, L, L);
+    benchmark::DoNotOptimize(source.data());
+  }
+
+  bench_utils::SetCellCounters(state, L * L, sizeof(T));
+}
+
+template<typename T>
+void BM_DefaultNorm(benchmark::State& state) {
+  auto L = static_cast<size_t>(state.range(0));
+  fluid_dynamics::Grid<T> prev = bench_utils::RandomGrid<T>(L, L);
+  fluid_dynamics::Grid<T> curr = bench_utils::RandomGrid<T>(L, L);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SolverProbe<T>::DefaultNorm(prev, curr, false));
+  }
+
+  bench_utils::SetCellCounters(state, L * L, 2 * sizeof(T));
+}
+
+// Fixed sweep count over a batch of members against the same number of independent solves.
+template<typename T>
+void BM_SolveBatch(benchmark::State& state) {
+  constexpr size_t kL = 128;
+  constexpr size_t kSweeps = 20;
+  auto members = static_cast<size_t>(state.range(0));
+  fluid_dynamics::SolverBatch<T> batch(T{0}, kSweeps);
+  std::vector<fluid_dynamics::Bound<T>> bounds(members, bench_utils::FrameBound<T>(kL, kL));
+
+  for (auto _ : state) {
+    std::vector<fluid_dynamics::Grid<T>> results = batch.Solve(kL, kL, bounds);
+    benchmark::DoNotOptimize(results.data());
+  }
+
+  bench_utils::SetCellCounters(state, kSweeps * kL * kL * members, 3 * sizeof(T));
+}
+
+template<typename T>
+void BM_SolveSequential(benchmark::State& state) {
+  constexpr size_t kL = 128;
+  constexpr size_t kSweeps = 20;
+  auto members = static_cast<size_t>(state.range(0));
+  fluid_dynamics::Solver<T> solver(T{0}, kSweeps);
+  fluid_dynamics::Bound<T> bound = bench_utils::FrameBound<T>(kL, kL);
+
+  for (auto _ : state) {
+    for (size_t m = 0; m < members; ++m) {
+      fluid_dynamics::Grid<T> result = solver.Solve(kL, kL, bound);
+      benchmark::DoNotOptimize(result.data());
+    }
+  }
+
+  bench_utils::SetCellCounters(state, kSweeps * kL * kL * members, 3 * sizeof(T));
+}
+
+// Converged solve of a grounded box with a source in one corner, tile size 0 is the full sweep.
+template<typename T>
+void BM_SolveActiveSet(benchmark::State& state) {
+  constexpr size_t kL = 128;
+  auto tile_size = static_cast<size_t>(state.range(0));
+  fluid_dynamics::Solver<T> solver(static_cast<T>(1e-3), 100000);
+  fluid_dynamics::Bound<T> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+  bound.AddBoundary({[](size_t i, size_t j) { return i == 0 || j == 0 || i == kL - 1 || j == kL - 1; },
+                     [](size_t, size_t) { return T{0}; }});
+  solver.source([](size_t i, size_t j) { return i < kL / 8 && j < kL / 8 ? T{1} : T{0}; });
+  solver.active_set(tile_size);
+  for (auto _ : state) {
+    fluid_dynamics::Grid<T> result = solver.Solve(kL, kL, bound);
+    benchmark::DoNotOptimize(result.data());
+  }
+
+  state.counters["sweeps"] = static_cast<double>(solver.iterations());
+  state.counters["skipped"] = static_cast<double>(solver.active_set().skipped());
+}
+
+// Converged solve of a plate inside a driven cavity, the cell counter reports composite nodes.
+template<typename T>
+void BM_SolveAmr(benchmark::State& state) {
+  auto L = static_cast<size_t>(state.range(0)) + 1;
+  fluid_dynamics::SolverAmr<T> solver(static_cast<T>(1e-6), 1000000);
+  fluid_dynamics::Bound<T> bound = bench_utils::FrameBound<T>(L, L);
+  fluid_dynamics::AmrOptions options;
+
+  bound.AddBoundary({[L](size_t i, size_t j) { return i == L / 2 && j > L / 4 && j < 3 * L / 4; },
+                     [](size_t, size_t) { return T{1}; }});
+  options.levels = 2;
+  options.block_size = 8;
+  solver.options(options);
+  for (auto _ : state) {
+    fluid_dynamics::Grid<T> result = solver.Solve(L, L, bound);
+    benchmark::DoNotOptimize(result.data());
+  }
+
+  state.counters["cells"] = static_cast<double>(solver.cells());
+  state.counters["sweeps"] = static_cast<double>(solver.sweeps());
+}
+
+template<typename T>
+void BM_Gradient(benchmark::State& state) {
+  auto L = static_cast<size_t>(state.range(0));
+  fluid_dynamics::Solver<T> solver;
+  fluid_dynamics::Grid<T> field = bench_utils::RandomGrid<T>(L, L);
+
+  for (auto _ : state) {
+    fluid_dynamics::Grid<std::pair<T, T>> grad = solver.Gradient(field);
+    benchmark::DoNotOptimize(grad.data());
+  }
+
+  bench_utils::SetCellCounters(state, L * L, 3 * sizeof(T));
+}
+
+template<typename T>
+void BM_Velocity(benchmark::State& state) {
+  auto L = static_cast<size_t>(state.range(0));
+  fluid_dynamics::Solver<T> solver;
+  fluid_dynamics::Grid<std::pair<T, T>> grad = solver.Gradient(bench_utils::RandomGrid<T>(L, L));
+
+  for (auto _ : state) {
+    fluid_dynamics::Grid<std::pair<T, T>> velocity = solver.Velocity(grad);
+    benchmark::DoNotOptimize(velocity.data());
+  }
+
+  bench_utils::SetCellCounters(state, L * L, 4 * sizeof(T));
+}
+
+template<typename T>
+void BM_Resize(benchmark::State& state) {
+  auto L = static_cast<size_t>(state.range(0));
+  fluid_dynamics::Grid<T> grid = bench_utils::RandomGrid<T>(L, L);
+
+  for (auto _ : state) {
+    grid.Resize(L + 2, L + 2, {1, 1});
+    grid.Resize(L, L, {-1, -1});
+    benchmark::DoNotOptimize(grid.data());
+  }
+
+  bench_utils::SetCellCounters(state, 2 * L * L, 2 * sizeof(T));
+}
+
+template<typename T>
+void BM_WriteGridBinary(benchmark::State& state) {
+  auto L = static_cast<size_t>(state.range(0));
+  std::string filename = "bench_grid.bin";
+  fluid_dynamics::Grid<T> grid = bench_utils::RandomGrid<T>(L, L);
+
+  for (auto _ : state) {
+    fluid_dynamics::WriteGridBinary(grid, filename);
+  }
+  std::remove(filename.c_str());
+
+  bench_utils::SetCellCounters(state, L * L, sizeof(T));
+}
+
+template<typename T>
+void BM_WriteGridText(benchmark::State& state) {
+  auto L = static_cast<size_t>(state.range(0));
+  std::string filename = "bench_grid.txt";
+  fluid_dynamics::Grid<T> grid = bench_utils::RandomGrid<T>(L, L);
+
+  for (auto _ : state) {
+    fluid_dynamics::WriteGridText(grid, filename);
+  }
+  std::remove(filename.c_str());
+
+  bench_utils::SetCellCounters(state, L * L, sizeof(T));
+}
+
+} // namespace
+
+#define FDSIM_BENCHMARK(func, max_size)                                                     \
+  BENCHMARK(func<float>)->RangeMultiplier(2)->Range(bench_utils::kMinSize, max_size);       \
+  BENCHMARK(func<double>)->RangeMultiplier(2)->Range(bench_utils::kMinSize, max_size)
+
+FDSIM_BENCHMARK(BM_Update, bench_utils::kMaxSize);
+FDSIM_BENCHMARK(BM_MaterializeSource, bench_utils::kMaxSize);
+BENCHMARK(BM_Update<double, fluid_dynamics::NinePoint>)->RangeMultiplier(2)->Range(bench_utils::kMinSize, bench_utils::kMaxSize);
+BENCHMARK(BM_Update<double, fluid_dynamics::FourthOrder>)->RangeMultiplier(2)->Range(bench_utils::kMinSize, bench_utils::kMaxSize);
+FDSIM_BENCHMARK(BM_DefaultNorm, bench_utils::kMaxSize);
+BENCHMARK(BM_SolveBatch<double>)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_SolveSequential<double>)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_SolveActiveSet<double>)->Arg(0)->Arg(8)->Arg(16)->Arg(32)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SolveAmr<double>)->RangeMultiplier(2)->Range(32, 128)->Unit(benchmark::kMillisecond);
+FDSIM_BENCHMARK(BM_Gradient, bench_utils::kMaxSize);
+FDSIM_BENCHMARK(BM_Velocity, bench_utils::kMaxSize);
+FDSIM_BENCHMARK(BM_Resize, bench_utils::kMaxSize);
+FDSIM_BENCHMARK(BM_WriteGridBinary, bench_utils::kMaxSize);
+FDSIM_BENCHMARK(BM_WriteGridText, bench_utils::kMaxSize / 4);
@@ -0,0 +1,94 @@
+// File: bench/bench_mpi.cpp
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "bench_utils.h"
+#include "poisson2d/poisson2d_mpi.h"
+
+namespace {
+
+fluid_dynamics::MpiGrid2D* mpi_grid = nullptr;
+
+template<typename T>
+class SolverMpiProbe : public fluid_dynamics::SolverMpi<T> {
+ public:
+  using fluid_dynamics::SolverMpi<T>::SolverMpi;
+  using fluid_dynamics::SolverMpi<T>::ExchangeBoundaryData;
+};
+
+class NullReporter : public benchmark::BenchmarkReporter {
+ public:
+  bool ReportContext(const Context&) override { return true; }
+  void ReportRuns(const std::vector<Run>&) override {}
+};
+
+// Every rank reports the slowest rank's time, so all ranks agree on the iteration count.
+double MaxTime(double local_time) {
+  double global_time;
+
+  MPI_Allreduce(&local_time, &global_time, 1, MPI_DOUBLE, MPI_MAX, mpi_grid->comm());
+
+  return global_time;
+}
+
+template<typename T>
+void BM_ExchangeBoundaryData(benchmark::State& state) {
+  auto L = static_cast<size_t>(state.range(0));
+  SolverMpiProbe<T> solver;
+  fluid_dynamics::Grid<T> grid = bench_utils::RandomGrid<T>(L + 2, L + 2);
+  double start;
+
+  mpi_grid->CreateHaloTypes(L, L, 1, fluid_dynamics::MpiType<T>());
+
+  for (auto _ : state) {
+    MPI_Barrier(mpi_grid->comm());
+    start = MPI_Wtime();
+    solver.ExchangeBoundaryData(grid, *mpi_grid);
+    state.SetIterationTime(MaxTime(MPI_Wtime() - start));
+  }
+
+  mpi_grid->FreeTypes();
+
+  bench_utils::SetCellCounters(state, 4 * L, 2 * sizeof(T));
+}
+
+template<typename T>
+void BM_Allreduce(benchmark::State& state) {
+  T local_norm = static_cast<T>(mpi_grid->rank());
+  T global_norm;
+  double start;
+
+  for (auto _ : state) {
+    MPI_Barrier(mpi_grid->comm());
+    start = MPI_Wtime();
+    MPI_Allreduce(&local_norm, &global_norm, 1, fluid_dynamics::MpiType<T>(), MPI_SUM, mpi_grid->comm());
+    state.SetIterationTime(MaxTime(MPI_Wtime() - start));
+    benchmark::DoNotOptimize(global_norm);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_ExchangeBoundaryData<float>)->RangeMultiplier(2)->Range(bench_utils::kMinSize, bench_utils::kMaxSize)
+    ->UseManualTime();
+BENCHMARK(BM_ExchangeBoundaryData<double>)->RangeMultiplier(2)->Range(bench_utils::kMinSize, bench_utils::kMaxSize)
+    ->UseManualTime();
+BENCHMARK(BM_Allreduce<float>)->UseManualTime();
+BENCHMARK(BM_Allreduce<double>)->UseManualTime();
+
+int main(int argc, char** argv) {
+  fluid_dynamics::MpiGrid2D grid(argc, argv);
+  NullReporter null_reporter;
+
+  mpi_grid = &grid;
+  benchmark::Initialize(&argc, argv);
+  if (grid.rank() == 0) {
+    benchmark::RunSpecifiedBenchmarks();
+  } else {
+    benchmark::RunSpecifiedBenchmarks(&null_reporter);
+  }
+  benchmark::Shutdown();
+
+  return 0;
+}
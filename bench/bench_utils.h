@@ -0,0 +1,55 @@
+// File: bench/bench_utils.h
+#ifndef FLUID_DYNAMICS_SIMULATION_BENCH_BENCH_UTILS_H_
+#define FLUID_DYNAMICS_SIMULATION_BENCH_BENCH_UTILS_H_
+
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include "poisson2d/poisson2d.h"
+
+namespace bench_utils {
+
+inline constexpr int64_t kMinSize = 64;
+inline constexpr int64_t kMaxSize = 2048;
+
+template<typename T>
+fluid_dynamics::Bound<T> FrameBound(size_t rows, size_t cols) {
+  fluid_dynamics::Bound<T> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+  bound.AddBoundary({
+                        [](size_t i, size_t) -> bool { return i == 0; },
+                        [](size_t, size_t) -> T { return 1; }
+                    });
+  bound.AddBoundary({
+                        [rows, cols](size_t i, size_t j) -> bool {
+                          return i == rows - 1 || j == 0 || j == cols - 1;
+                        },
+                        [](size_t, size_t) -> T { return 0; }
+                    });
+
+  return bound;
+}
+
+template<typename T>
+fluid_dynamics::Grid<T> RandomGrid(size_t rows, size_t cols) {
+  fluid_dynamics::Grid<T> grid(rows, cols);
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+  grid.Fill([&state](size_t, size_t) -> T {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<T>(state % 1000) / static_cast<T>(1000);
+  });
+
+  return grid;
+}
+
+// Reports cells/s as items and the given number of bytes touched per cell as bytes/s.
+inline void SetCellCounters(benchmark::State& state, size_t cells, size_t bytes_per_cell) {
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(cells));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(cells * bytes_per_cell));
+}
+
+} // namespace bench_utils
+
+#endif // FLUID_DYNAMICS_SIMULATION_BENCH_BENCH_UTILS_H_
@@ -0,0 +1,152 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "poisson2d/poisson2d_mpi.h"
+
+struct EnsembleOptions {
+  size_t cases = 64;
+  int group_size = 1;
+  size_t size = 64;
+  double epsilon = 1e-4;
+  size_t max_iter = 2000;
+  std::string output = "plot/ensemble.bin";
+}; // struct EnsembleOptions
+
+void PrintOptions(char* argv[]) {
+  std::cout << "Usage: " << std::endl;
+  std::cout << "  " << argv[0] << " [options]" << std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout << "  -h, --help   Show this help message and exit" << std::endl;
+  std::cout << "  -cases       The number of independent solves (Default 64)" << std::endl;
+  std::cout << "  -group_size  The number of ranks solving one case together (Default 1)" << std::endl;
+  std::cout << "  -L           The grid size of every case (Default 64)" << std::endl;
+  std::cout << "  -epsilon     The convergence threshold (Default 1e-4)" << std::endl;
+  std::cout << "  -max_iter    The maximum number of iterations per case (Default 2000)" << std::endl;
+  std::cout << "  -out         The file the stream function of every case is written to (Default plot/ensemble.bin)" << std::endl;
+}
+
+bool ParseEnsembleArgs(int argc, char* argv[], EnsembleOptions& options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+    if (arg == "-h" || arg == "--help") {
+      PrintOptions(argv);
+      return false;
+    } else if (i + 1 >= argc) {
+      std::cerr << "Missing value for option: " << arg << std::endl;
+      return false;
+    } else if (arg == "-cases") {
+      options.cases = static_cast<size_t>(std::stoll(argv[++i]));
+    } else if (arg == "-group_size") {
+      options.group_size = std::stoi(argv[++i]);
+    } else if (arg == "-L") {
+      options.size = static_cast<size_t>(std::stoll(argv[++i]));
+    } else if (arg == "-epsilon") {
+      options.epsilon = std::stod(argv[++i]);
+    } else if (arg == "-max_iter") {
+      options.max_iter = static_cast<size_t>(std::stoll(argv[++i]));
+    } else if (arg == "-out") {
+      options.output = argv[++i];
+    } else {
+      std::cerr << "Unknown option: " << arg << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Uniform sample in [0, 1) derived from the case id, so every group sees the same parameters for a case.
+double Sample(size_t case_id, uint64_t stream) {
+  uint64_t state = 0x9E3779B97F4A7C15ULL * (case_id + 1) + stream;
+
+  state ^= state >> 33;
+  state *= 0xFF51AFD7ED558CCDULL;
+  state ^= state >> 33;
+  return static_cast<double>(state >> 11) / static_cast<double>(1ULL << 53);
+}
+
+// Lid driven cavity with an uncertain lid value and a uniform source.
+fluid_dynamics::Bound<double> CreateBound(size_t L, double lid) {
+  fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+  bound.AddBoundary({
+                        [](size_t i, size_t j) -> bool {
+                          return i == 0;
+                        },
+                        [lid](size_t i, size_t j) -> double {
+                          return lid;
+                        }
+                    });
+  bound.AddBoundary({
+                        [L](size_t i, size_t j) -> bool {
+                          return i == L - 1 || j == 0 || j == L - 1;
+                        },
+                        [](size_t i, size_t j) -> double {
+                          return 0.0;
+                        }
+                    });
+
+  return bound;
+}
+
+int main(int argc, char** argv) {
+  fluid_dynamics::MpiGrid2D world(argc, argv, MPI_COMM_WORLD);
+  EnsembleOptions options;
+  int valid = 1;
+
+  if (world.rank() == 0) {
+    valid = ParseEnsembleArgs(argc, argv, options) ? 1 : 0;
+  }
+  MPI_Bcast(&valid, 1, MPI_INT, 0, world.comm());
+  if (!valid) {
+    return 0;
+  }
+  ParseEnsembleArgs(argc, argv, options);
+
+  fluid_dynamics::MpiEnsemble ensemble(world.comm(), options.group_size);
+  fluid_dynamics::MpiGrid2D& group_grid = ensemble.grid();
+  size_t L = options.size;
+  size_t local_rows = group_grid.LocalRows(L);
+  size_t local_cols = group_grid.LocalCols(L);
+
+  if (ensemble.rank() == 0) {
+    std::cout << "Running " << options.cases << " cases with L = " << L << " on " << ensemble.groups()
+              << " groups of " << options.group_size << " ranks" << std::endl;
+  }
+
+  ensemble.OpenOutput(options.output, L * L * sizeof(double));
+  double start = MPI_Wtime();
+
+  ensemble.Run(options.cases, [&](size_t case_id) {
+    fluid_dynamics::SolverMpi<double> solver(options.epsilon, options.max_iter);
+    fluid_dynamics::Bound<double> bound = CreateBound(L, 0.5 + Sample(case_id, 0));
+    double source = 0.1 * (Sample(case_id, 1) - 0.5);
+
+    solver.source([source](size_t, size_t) { return source; });
+    fluid_dynamics::Grid<double> grid = solver.Solve(local_rows, local_cols, bound, group_grid);
+    ensemble.WriteRecord(grid, case_id);
+  });
+
+  double elapsed = MPI_Wtime() - start;
+  ensemble.CloseOutput();
+
+  // Only group leaders report, the others contribute 0 so the sum counts every case once.
+  std::vector<unsigned long> per_group(ensemble.groups(), 0);
+  std::vector<unsigned long> counts(ensemble.groups(), 0);
+  if (group_grid.rank() == 0) {
+    per_group[ensemble.group()] = ensemble.cases_run();
+  }
+  MPI_Reduce(per_group.data(), counts.data(), ensemble.groups(), MPI_UNSIGNED_LONG, MPI_SUM, 0, ensemble.comm());
+
+  if (ensemble.rank() == 0) {
+    for (int g = 0; g < ensemble.groups(); ++g) {
+      std::cout << "Group " << g << ": " << counts[g] << " cases" << std::endl;
+    }
+    std::cout << "Time Taken: " << elapsed << "s, " << static_cast<double>(options.cases) / elapsed
+              << " cases/s" << std::endl;
+    std::cout << "Results written to " << options.output << std::endl;
+  }
+
+  return 0;
+}
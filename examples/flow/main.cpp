@@ -0,0 +1,48 @@
+#include <iostream>
+#include <string>
+#include "poisson2d/poisson2d_mpi.h"
+
+// Lid driven cavity: the wall in row 0 moves along the columns, the streamfunction is zero on all walls.
+int main(int argc, char** argv) {
+  fluid_dynamics::MpiGrid2D mpi_grid(MPI_COMM_WORLD);
+  fluid_dynamics::FlowOptions options;
+  size_t L = 64;
+  size_t steps = 1000;
+  double epsilon = 1e-4;
+
+  for (int i = 1; i < argc - 1; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-L") {
+      L = std::stoul(argv[++i]);
+    } else if (arg == "-steps") {
+      steps = std::stoul(argv[++i]);
+    } else if (arg == "-dt") {
+      options.time_step = std::stod(argv[++i]);
+    } else if (arg == "-viscosity") {
+      options.viscosity = std::stod(argv[++i]);
+    } else if (arg == "-epsilon") {
+      epsilon = std::stod(argv[++i]);
+    }
+  }
+  if (mpi_grid.rank() == 0) {
+    std::cout << "Running with L = " << L << ", steps = " << steps << ", dt = " << options.time_step
+              << ", viscosity = " << options.viscosity << ", Re = " << L * options.lid_velocity / options.viscosity
+              << "\n" << std::endl;
+  }
+
+  size_t local_rows = mpi_grid.LocalRows(L);
+  size_t local_cols = mpi_grid.LocalCols(L);
+  fluid_dynamics::FlowSimulationMpi<double> flow(mpi_grid, epsilon, 10000);
+
+  flow.options(options);
+  flow.Initialize(local_rows, local_cols, fluid_dynamics::Bound<double>{});
+  flow.Run(steps, true);
+
+  fluid_dynamics::Grid<std::pair<double, double>> velocities = flow.velocity();
+  WriteGridBinary(velocities, "plot/velocity.bin", mpi_grid);
+  if (mpi_grid.rank() == 0) {
+    std::cout << "Wrote the flow velocity values to plot/velocity.bin" << std::endl;
+  }
+
+  return 0;
+}
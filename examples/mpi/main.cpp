@@ -127,10 +127,12 @@ int main(int argc, char** argv) {
   size_t L;
   double epsilon;
   size_t max_iter;
+  std::string geometry;
+  size_t geometry_length;
   bool terminate;
 
   if (mpi_grid.rank() == 0) {
-    parse_args::ParseArgs(argc, argv, L, epsilon, max_iter, terminate);
+    parse_args::ParseArgs(argc, argv, L, epsilon, max_iter, geometry, terminate);
     if (terminate) {
       MPI_Abort(mpi_grid.comm(), 0);
       return 0;
@@ -139,6 +141,10 @@ int main(int argc, char** argv) {
   MPI_Bcast(&L, 1, MPI_UNSIGNED_LONG, 0, mpi_grid.comm());
   MPI_Bcast(&epsilon, 1, MPI_DOUBLE, 0, mpi_grid.comm());
   MPI_Bcast(&max_iter, 1, MPI_UNSIGNED_LONG, 0, mpi_grid.comm());
+  geometry_length = geometry.size();
+  MPI_Bcast(&geometry_length, 1, MPI_UNSIGNED_LONG, 0, mpi_grid.comm());
+  geometry.resize(geometry_length);
+  MPI_Bcast(geometry.data(), static_cast<int>(geometry_length), MPI_CHAR, 0, mpi_grid.comm());
   if (mpi_grid.rank() == 0) {
     std::cout << "Running with L = " << L << ", epsilon = " << epsilon << ", max_iter = " << max_iter << "\n" << std::endl;
   }
@@ -146,10 +152,11 @@ int main(int argc, char** argv) {
 
   size_t local_rows = mpi_grid.LocalRows(L);
   size_t local_cols = mpi_grid.LocalCols(L);
-  fluid_dynamics::Grid<double> grid(local_rows, local_cols);
-  fluid_dynamics::Grid<std::pair<double, double>> grad(local_rows, local_cols);
-  fluid_dynamics::Grid<std::pair<double, double>> velocities(local_rows, local_cols);
-  fluid_dynamics::Bound<double> bound = CreateBound(L);
+  fluid_dynamics::DistributedGrid<double> grid(mpi_grid, L, L);
+  fluid_dynamics::DistributedGrid<std::pair<double, double>> grad;
+  fluid_dynamics::DistributedGrid<std::pair<double, double>> velocities;
+  fluid_dynamics::Bound<double> bound = geometry.empty() ? CreateBound(L)
+                                                        : fluid_dynamics::ReadGeometry<double>(geometry, L, L);
   fluid_dynamics::SolverMpi<double> solver(epsilon, max_iter);
   int epsilon_precision = 0;
 
@@ -163,18 +170,28 @@ int main(int argc, char** argv) {
     std::cout.precision(epsilon_precision);
   }
 
+#ifdef FDSIM_PROFILING
+  solver.profiler().EnableCounters();
+  solver.profiler().stream_bandwidth(fluid_dynamics::MeasureStreamBandwidth());
+#endif
+  solver.report_peak_memory(true);
+
   if (mpi_grid.rank() == 0) {
     std::cout << "Computing the stream function values on the grid.." << std::endl;
   }
-  grid = solver.Solve(local_rows, local_cols, bound, mpi_grid, true);
+  grid = solver.Solve(grid, bound, true);
+  fluid_dynamics::HaloTraffic traffic = fluid_dynamics::ReduceHaloTraffic(
+      mpi_grid.HaloBytes(local_rows, local_cols, 1, sizeof(double)), mpi_grid);
   if (mpi_grid.rank() == 0) {
+    std::cout << "Halo bytes per exchange on " << mpi_grid.nodes() << " node(s): "
+              << traffic.intra_node_bytes << " intra-node, " << traffic.inter_node_bytes << " inter-node" << std::endl;
     std::cout << std::endl;
   }
 
   if (mpi_grid.rank() == 0) {
     std::cout << "Computing the gradient of the stream function.." << std::endl;
   }
-  grad = solver.Gradient(grid, mpi_grid);
+  grad = solver.Gradient(grid);
   if (mpi_grid.rank() == 0) {
     std::cout << "Done.\n" << std::endl;
   }
@@ -190,10 +207,24 @@ int main(int argc, char** argv) {
   if (mpi_grid.rank() == 0) {
     std::cout << "Writing the flow velocity values to file.." << std::endl;
   }
-  WriteGridBinary(velocities, "plot/velocity.bin", mpi_grid);
+  {
+    FDSIM_PROFILE_SCOPE(solver.profiler(), fluid_dynamics::Phase::kIo);
+    WriteGridBinary(velocities, "plot/velocity.bin");
+  }
+  if (mpi_grid.rank() == 0) {
+    std::cout << "Done.\n" << std::endl;
+  }
+
+#ifdef FDSIM_PROFILING
+  fluid_dynamics::ReduceProfile(solver.profiler(), mpi_grid);
   if (mpi_grid.rank() == 0) {
+    std::cout << "Writing the solver profile to file.." << std::endl;
+    solver.profiler().WriteReport("plot/profile.json");
+    solver.profiler().WriteReport("plot/profile.csv");
+    solver.profiler().WriteSummary(std::cout);
     std::cout << "Done.\n" << std::endl;
   }
+#endif
 
   return 0;
 }
@@ -13,9 +13,11 @@ void PrintOptions(char* argv[]) {
   std::cout << "  -L          The size of the grid (Default 102)" << std::endl;
   std::cout << "  -epsilon    The stopping criterion for the solver (Default 1e-2)" << std::endl;
   std::cout << "  -max_iter   The maximum number of iterations (Default 3000)" << std::endl;
+  std::cout << "  -geometry   A geometry file with the boundaries (Default built in)" << std::endl;
 }
 
-void ParseArgs(int argc, char* argv[], size_t& L, double& epsilon, size_t& max_iter, bool& terminate) {
+void ParseArgs(int argc, char* argv[], size_t& L, double& epsilon, size_t& max_iter, std::string& geometry,
+               bool& terminate) {
   long long L_test;
   long long max_iter_test;
   bool L_flag = false;
@@ -23,6 +25,7 @@ void ParseArgs(int argc, char* argv[], size_t& L, double& epsilon, size_t& max_i
   bool max_iter_flag = false;
 
   terminate = false;
+  geometry.clear();
 
   if (argc == 1) {
     PrintOptions(argv);
@@ -64,6 +67,13 @@ void ParseArgs(int argc, char* argv[], size_t& L, double& epsilon, size_t& max_i
         }
         max_iter = static_cast<size_t>(max_iter_test);
         max_iter_flag = true;
+      } else if (std::string(argv[i]) == "-geometry") {
+        if (i + 1 >= argc) {
+          std::cerr << "-geometry needs a file name" << std::endl;
+          terminate = true;
+          break;
+        }
+        geometry = argv[++i];
       } else {
         std::cerr << "Unknown option: " << argv[i] << std::endl;
         terminate = true;
@@ -83,6 +93,17 @@ void ParseArgs(int argc, char* argv[], size_t& L, double& epsilon, size_t& max_i
   }
 }
 
+// For the examples without geometry files.
+void ParseArgs(int argc, char* argv[], size_t& L, double& epsilon, size_t& max_iter, bool& terminate) {
+  std::string geometry;
+
+  ParseArgs(argc, argv, L, epsilon, max_iter, geometry, terminate);
+  if (!terminate && !geometry.empty()) {
+    std::cerr << "Unknown option: -geometry" << std::endl;
+    terminate = true;
+  }
+}
+
 } // namespace parse_args
 
 #endif // FLUID_DYNAMICS_SIMULATION_EXAMPLES_PARSE_ARGS_H_
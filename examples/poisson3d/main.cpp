@@ -0,0 +1,126 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "poisson2d/poisson2d_mpi.h"
+#include "../parse_args.h"
+
+// Unit cube with a driven lid at x = 0, grounded walls and a plate at half the lid value in its middle.
+fluid_dynamics::Bound3D<double> CreateBound(size_t L) {
+  size_t L_half = L / 2;
+  size_t L_quarter = L / 4;
+  size_t L_three_quarter = 3 * L / 4;
+  fluid_dynamics::Bound3D<double> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+  // x = 0, phi(x, y, z) = 1
+  bound.AddBoundary({
+                        [](size_t i, size_t j, size_t k) -> bool {
+                          return i == 0;
+                        },
+                        [](size_t i, size_t j, size_t k) -> double {
+                          return 1.0;
+                        }
+                    });
+  // Remaining faces of the cube, phi(x, y, z) = 0
+  bound.AddBoundary({
+                        [L](size_t i, size_t j, size_t k) -> bool {
+                          return i == L - 1 || j == 0 || j == L - 1 || k == 0 || k == L - 1;
+                        },
+                        [](size_t i, size_t j, size_t k) -> double {
+                          return 0.0;
+                        }
+                    });
+  // x = L/2, L/4 <= y, z <= 3L/4, phi(x, y, z) = 0.5
+  bound.AddBoundary({
+                        [L_half, L_quarter, L_three_quarter](size_t i, size_t j, size_t k) -> bool {
+                          return i == L_half && j >= L_quarter && j <= L_three_quarter
+                              && k >= L_quarter && k <= L_three_quarter;
+                        },
+                        [](size_t i, size_t j, size_t k) -> double {
+                          return 0.5;
+                        }
+                    });
+
+  return bound;
+}
+
+// Removes "-decomp <slab|pencil|block>" from the arguments before the common options are parsed.
+fluid_dynamics::Decomposition ParseDecomposition(int& argc, char** argv) {
+  fluid_dynamics::Decomposition decomposition = fluid_dynamics::Decomposition::kBlock;
+
+  for (int i = 1; i < argc - 1; ++i) {
+    if (std::string(argv[i]) == "-decomp") {
+      std::string value = argv[i + 1];
+      if (value == "slab") {
+        decomposition = fluid_dynamics::Decomposition::kSlab;
+      } else if (value == "pencil") {
+        decomposition = fluid_dynamics::Decomposition::kPencil;
+      }
+      for (int j = i; j + 2 <= argc; ++j) {
+        argv[j] = j + 2 < argc ? argv[j + 2] : nullptr;
+      }
+      argc -= 2;
+      break;
+    }
+  }
+
+  return decomposition;
+}
+
+int main(int argc, char** argv) {
+  fluid_dynamics::Decomposition decomposition = ParseDecomposition(argc, argv);
+  fluid_dynamics::MpiGrid3D mpi_grid(MPI_COMM_WORLD, decomposition);
+  const char* names[] = {"slab", "pencil", "block"};
+  size_t L;
+  double epsilon;
+  size_t max_iter;
+  bool terminate;
+
+  if (mpi_grid.rank() == 0) {
+    parse_args::ParseArgs(argc, argv, L, epsilon, max_iter, terminate);
+    if (terminate) {
+      std::cout << "  -decomp     slab, pencil or block (Default block)" << std::endl;
+      MPI_Abort(mpi_grid.comm(), 0);
+      return 0;
+    }
+  }
+  MPI_Bcast(&L, 1, MPI_UNSIGNED_LONG, 0, mpi_grid.comm());
+  MPI_Bcast(&epsilon, 1, MPI_DOUBLE, 0, mpi_grid.comm());
+  MPI_Bcast(&max_iter, 1, MPI_UNSIGNED_LONG, 0, mpi_grid.comm());
+  if (mpi_grid.rank() == 0) {
+    std::cout << "Running with L = " << L << ", epsilon = " << epsilon << ", max_iter = " << max_iter
+              << ", decomposition = " << names[static_cast<int>(decomposition)] << " ("
+              << mpi_grid.dims()[0] << "x" << mpi_grid.dims()[1] << "x" << mpi_grid.dims()[2] << ")\n" << std::endl;
+  }
+  MPI_Barrier(mpi_grid.comm());
+
+  size_t nx = mpi_grid.LocalSize(0, L);
+  size_t ny = mpi_grid.LocalSize(1, L);
+  size_t nz = mpi_grid.LocalSize(2, L);
+  fluid_dynamics::Bound3D<double> bound = CreateBound(L);
+  fluid_dynamics::SolverMpi3D<double> solver(epsilon, max_iter);
+  unsigned long halo_cells = mpi_grid.HaloCells(nx, ny, nz);
+  unsigned long max_halo_cells;
+
+  MPI_Reduce(&halo_cells, &max_halo_cells, 1, MPI_UNSIGNED_LONG, MPI_MAX, 0, mpi_grid.comm());
+  if (mpi_grid.rank() == 0) {
+    std::cout << "Halo cells sent per iteration by the busiest rank: " << max_halo_cells << "\n" << std::endl;
+    std::cout << "Computing the velocity potential on the grid.." << std::endl;
+  }
+  fluid_dynamics::Grid3D<double> grid = solver.Solve(nx, ny, nz, bound, mpi_grid, true);
+  if (mpi_grid.rank() == 0) {
+    std::cout << std::endl;
+    std::cout << "Computing the flow velocities.." << std::endl;
+  }
+  fluid_dynamics::Grid3D<std::array<double, 3>> velocities = solver.Velocity(solver.Gradient(grid, mpi_grid));
+  if (mpi_grid.rank() == 0) {
+    std::cout << "Done.\n" << std::endl;
+    std::cout << "Writing the flow velocity values to file.." << std::endl;
+  }
+  WriteGridBinary(velocities, "plot/velocity3d.bin", mpi_grid);
+  if (mpi_grid.rank() == 0) {
+    std::cout << "Done.\n" << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,219 @@
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <omp.h>
+#include "poisson2d/poisson2d_mpi.h"
+
+struct ScalingOptions {
+  std::string mode = "strong";
+  std::vector<size_t> sizes = {256, 512, 1024};
+  std::vector<int> threads = {};
+  size_t iterations = 200;
+  std::string output = "scaling.csv";
+  bool reference = true;
+}; // struct ScalingOptions
+
+struct ScalingResult {
+  size_t global_rows;
+  size_t global_cols;
+  size_t local_rows;
+  size_t local_cols;
+  double time_per_iter;
+  double comm_fraction;
+  double halo_fraction;
+  double allreduce_fraction;
+}; // struct ScalingResult
+
+template<typename T>
+std::vector<T> ParseList(const std::string& arg) {
+  std::vector<T> values;
+  std::stringstream stream(arg);
+  std::string item;
+
+  while (std::getline(stream, item, ',')) {
+    values.push_back(static_cast<T>(std::stoll(item)));
+  }
+
+  return values;
+}
+
+void PrintOptions(char* argv[]) {
+  std::cout << "Usage: " << std::endl;
+  std::cout << "  " << argv[0] << " [options]" << std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout << "  -h, --help  Show this help message and exit" << std::endl;
+  std::cout << "  -mode       strong: L is the global grid size, weak: L is the grid size per rank (Default strong)" << std::endl;
+  std::cout << "  -L          Comma separated list of grid sizes (Default 256,512,1024)" << std::endl;
+  std::cout << "  -threads    Comma separated list of OpenMP thread counts (Default OMP_NUM_THREADS)" << std::endl;
+  std::cout << "  -iter       The number of iterations per solve (Default 200)" << std::endl;
+  std::cout << "  -out        The CSV file the results are appended to (Default scaling.csv)" << std::endl;
+  std::cout << "  -no_ref     Skip the serial reference solve, efficiency is reported as 0" << std::endl;
+}
+
+bool ParseScalingArgs(int argc, char* argv[], ScalingOptions& options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+    if (arg == "-h" || arg == "--help") {
+      PrintOptions(argv);
+      return false;
+    } else if (arg == "-no_ref") {
+      options.reference = false;
+    } else if (i + 1 >= argc) {
+      std::cerr << "Missing value for option: " << arg << std::endl;
+      return false;
+    } else if (arg == "-mode") {
+      options.mode = argv[++i];
+      if (options.mode != "strong" && options.mode != "weak") {
+        std::cerr << "mode must be strong or weak" << std::endl;
+        return false;
+      }
+    } else if (arg == "-L") {
+      options.sizes = ParseList<size_t>(argv[++i]);
+    } else if (arg == "-threads") {
+      options.threads = ParseList<int>(argv[++i]);
+    } else if (arg == "-iter") {
+      options.iterations = static_cast<size_t>(std::stoll(argv[++i]));
+    } else if (arg == "-out") {
+      options.output = argv[++i];
+    } else {
+      std::cerr << "Unknown option: " << arg << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Lid driven cavity: phi = 1 on the top edge, 0 on the remaining edges.
+fluid_dynamics::Bound<double> CreateBound(size_t rows, size_t cols) {
+  fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+  bound.AddBoundary({
+                        [](size_t i, size_t j) -> bool {
+                          return i == 0;
+                        },
+                        [](size_t i, size_t j) -> double {
+                          return 1.0;
+                        }
+                    });
+  bound.AddBoundary({
+                        [rows, cols](size_t i, size_t j) -> bool {
+                          return i == rows - 1 || j == 0 || j == cols - 1;
+                        },
+                        [](size_t i, size_t j) -> double {
+                          return 0.0;
+                        }
+                    });
+
+  return bound;
+}
+
+double ReferenceTimePerIter(size_t rows, size_t cols, size_t iterations) {
+  fluid_dynamics::Solver<double> solver(iterations);
+  fluid_dynamics::Bound<double> bound = CreateBound(rows, cols);
+
+  solver.epsilon(0.0);
+  auto start = MPI_Wtime();
+  static_cast<void>(solver.Solve(rows, cols, bound));
+  return (MPI_Wtime() - start) / static_cast<double>(iterations);
+}
+
+ScalingResult RunSolve(size_t global_rows, size_t global_cols, size_t iterations,
+                       fluid_dynamics::MpiGrid2D& mpi_grid) {
+  size_t local_rows = global_rows / mpi_grid.rows();
+  size_t local_cols = global_cols / mpi_grid.cols();
+  fluid_dynamics::SolverMpi<double> solver(iterations);
+  fluid_dynamics::Bound<double> bound = CreateBound(global_rows, global_cols);
+  double local_time, time;
+
+  solver.epsilon(0.0);
+  MPI_Barrier(mpi_grid.comm());
+  local_time = MPI_Wtime();
+  static_cast<void>(solver.Solve(local_rows, local_cols, bound, mpi_grid));
+  local_time = MPI_Wtime() - local_time;
+  MPI_Allreduce(&local_time, &time, 1, MPI_DOUBLE, MPI_MAX, mpi_grid.comm());
+
+  fluid_dynamics::ReduceProfile(solver.profiler(), mpi_grid);
+  const auto& stats = solver.profiler().rank_stats();
+  double halo = stats[static_cast<size_t>(fluid_dynamics::Phase::kHaloExchange)].mean;
+  double allreduce = stats[static_cast<size_t>(fluid_dynamics::Phase::kAllreduce)].mean;
+  double total = halo + allreduce
+      + stats[static_cast<size_t>(fluid_dynamics::Phase::kStencil)].mean
+      + stats[static_cast<size_t>(fluid_dynamics::Phase::kNorm)].mean;
+
+  return {global_rows, global_cols, local_rows, local_cols, time / static_cast<double>(iterations),
+          total > 0.0 ? (halo + allreduce) / total : 0.0,
+          total > 0.0 ? halo / total : 0.0,
+          total > 0.0 ? allreduce / total : 0.0};
+}
+
+int main(int argc, char** argv) {
+  fluid_dynamics::MpiGrid2D mpi_grid(argc, argv, MPI_COMM_WORLD);
+  ScalingOptions options;
+  int valid = 1;
+
+  if (mpi_grid.rank() == 0) {
+    valid = ParseScalingArgs(argc, argv, options) ? 1 : 0;
+  }
+  MPI_Bcast(&valid, 1, MPI_INT, 0, mpi_grid.comm());
+  if (!valid) {
+    return 0;
+  }
+  ParseScalingArgs(argc, argv, options);
+  if (options.threads.empty()) {
+    options.threads.push_back(omp_get_max_threads());
+  }
+
+  std::ofstream csv;
+  if (mpi_grid.rank() == 0) {
+    bool write_header = !std::ifstream(options.output).good();
+    csv.open(options.output, std::ios::app);
+    if (write_header) {
+      csv << "mode,ranks,threads,global_rows,global_cols,local_rows,local_cols,iterations,"
+          << "time_per_iter,ref_time_per_iter,efficiency,comm_fraction,halo_fraction,allreduce_fraction\n";
+    }
+  }
+
+  for (size_t L : options.sizes) {
+    bool strong = options.mode == "strong";
+    size_t global_rows = strong ? L : L * mpi_grid.rows();
+    size_t global_cols = strong ? L : L * mpi_grid.cols();
+    double ref_time = 0.0;
+
+    if (global_rows % mpi_grid.rows() != 0 || global_cols % mpi_grid.cols() != 0) {
+      if (mpi_grid.rank() == 0) {
+        std::cout << "Skipping L = " << L << ", not divisible by the " << mpi_grid.rows() << "x"
+                  << mpi_grid.cols() << " process grid." << std::endl;
+      }
+      continue;
+    }
+
+    // Serial single thread reference: the global problem for strong scaling, one rank's block for weak scaling.
+    if (options.reference && mpi_grid.rank() == 0) {
+      ref_time = ReferenceTimePerIter(L, L, options.iterations);
+    }
+
+    for (int threads : options.threads) {
+      omp_set_num_threads(threads);
+      ScalingResult result = RunSolve(global_rows, global_cols, options.iterations, mpi_grid);
+
+      if (mpi_grid.rank() == 0) {
+        double cells_ratio = static_cast<double>(global_rows * global_cols) / static_cast<double>(L * L);
+        double efficiency = ref_time * cells_ratio / (mpi_grid.size() * threads * result.time_per_iter);
+        csv << options.mode << "," << mpi_grid.size() << "," << threads << ","
+            << result.global_rows << "," << result.global_cols << ","
+            << result.local_rows << "," << result.local_cols << "," << options.iterations << ","
+            << result.time_per_iter << "," << ref_time << "," << efficiency << ","
+            << result.comm_fraction << "," << result.halo_fraction << "," << result.allreduce_fraction << "\n";
+        std::cout << options.mode << " L = " << L << ", ranks = " << mpi_grid.size() << ", threads = " << threads
+                  << ": " << result.time_per_iter * 1e3 << " ms/iter, efficiency " << efficiency
+                  << ", communication " << result.comm_fraction * 100.0 << "%" << std::endl;
+      }
+    }
+  }
+
+  return 0;
+}
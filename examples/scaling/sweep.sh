@@ -0,0 +1,16 @@
+#!/usr/bin/env bash
+# Sweeps MPI ranks x OpenMP threads for FDSimScaling and appends all runs to one CSV file.
+# Usage: examples/scaling/sweep.sh <build dir> <strong|weak> <L list> <rank list> <thread list> [output]
+set -euo pipefail
+
+BUILD_DIR=${1:-build}
+MODE=${2:-strong}
+SIZES=${3:-256,512,1024}
+RANKS=${4:-"1 2 4"}
+THREADS=${5:-1,2}
+OUTPUT=${6:-scaling.csv}
+
+for NP in ${RANKS}; do
+  mpirun -np "${NP}" --oversubscribe "${BUILD_DIR}/FDSimScaling" \
+    -mode "${MODE}" -L "${SIZES}" -threads "${THREADS}" -out "${OUTPUT}"
+done
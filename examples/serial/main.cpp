@@ -126,9 +126,10 @@ int main(int argc, char* argv[]) {
   size_t L;
   double epsilon;
   size_t max_iter;
+  std::string geometry;
   bool terminate;
 
-  parse_args::ParseArgs(argc, argv, L, epsilon, max_iter, terminate);
+  parse_args::ParseArgs(argc, argv, L, epsilon, max_iter, geometry, terminate);
   if (terminate) {
     return 0;
   }
@@ -136,7 +137,8 @@ int main(int argc, char* argv[]) {
 
   fluid_dynamics::Grid<double> grid;
   fluid_dynamics::Grid<std::pair<double, double>> grad(L), velocities(L);
-  fluid_dynamics::Bound<double> bound = CreateBound(L);
+  fluid_dynamics::Bound<double> bound = geometry.empty() ? CreateBound(L)
+                                                        : fluid_dynamics::ReadGeometry<double>(geometry, L, L);
   fluid_dynamics::Solver<double> solver(epsilon, max_iter);
   int epsilon_precision = 0;
 
@@ -148,6 +150,12 @@ int main(int argc, char* argv[]) {
   std::cout.setf(std::ios_base::fixed);
   std::cout.precision(epsilon_precision);
 
+#ifdef FDSIM_PROFILING
+  solver.profiler().EnableCounters();
+  solver.profiler().stream_bandwidth(fluid_dynamics::MeasureStreamBandwidth());
+#endif
+  solver.report_peak_memory(true);
+
   std::cout << "Computing the stream function values on the grid.." << std::endl;
   grid = solver.Solve(L, L, bound, true);
   std::cout << std::endl;
@@ -164,7 +172,18 @@ int main(int argc, char* argv[]) {
   std::cout << "Done.\n" << std::endl;
 
   std::cout << "Writing the flow velocity values to file.." << std::endl;
-  WriteGridBinary(velocities, "plot/velocity.bin");
+  {
+    FDSIM_PROFILE_SCOPE(solver.profiler(), fluid_dynamics::Phase::kIo);
+    WriteGridBinary(velocities, "plot/velocity.bin");
+  }
+  std::cout << "Done.\n" << std::endl;
+
+#ifdef FDSIM_PROFILING
+  std::cout << "Writing the solver profile to file.." << std::endl;
+  solver.profiler().WriteReport("plot/profile.json");
+  solver.profiler().WriteReport("plot/profile.csv");
+  solver.profiler().WriteSummary(std::cout);
   std::cout << "Done.\n" << std::endl;
+#endif
   return 0;
 }
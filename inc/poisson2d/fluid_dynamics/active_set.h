@@ -0,0 +1,74 @@
+// File: inc/poisson2d/fluid_dynamics/active_set.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_ACTIVE_SET_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_ACTIVE_SET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace fluid_dynamics {
+
+// Splits a rows x cols block into square tiles and tracks which of them are still relaxed. After a
+// sweep, tiles whose squared change stayed below the threshold are frozen, and tiles next to a tile
+// that changed by at least the threshold are woken up again. Frozen tiles contribute no change, so
+// the sum of the recorded changes equals the squared norm of the whole sweep.
+template<typename T>
+class ActiveSet {
+ public:
+  ActiveSet();
+  ActiveSet(const ActiveSet&) = default;
+  ActiveSet(ActiveSet&&) noexcept = default;
+  ActiveSet(size_t rows, size_t cols, size_t tile_size, T threshold, bool periodic = false);
+  ~ActiveSet() = default;
+
+  ActiveSet& operator=(const ActiveSet&) = default;
+  ActiveSet& operator=(ActiveSet&&) noexcept = default;
+
+  [[nodiscard]] size_t rows() const;
+  [[nodiscard]] size_t cols() const;
+  [[nodiscard]] size_t tile_size() const;
+  [[nodiscard]] size_t tile_rows() const;
+  [[nodiscard]] size_t tile_cols() const;
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] T threshold() const;
+  [[nodiscard]] const std::vector<size_t>& active() const;
+  [[nodiscard]] bool frozen(size_t tile) const;
+  [[nodiscard]] size_t frozen_count() const;
+  [[nodiscard]] size_t updates() const;
+  [[nodiscard]] size_t skipped() const;
+  [[nodiscard]] T norm() const;
+
+  [[nodiscard]] size_t RowBegin(size_t tile) const;
+  [[nodiscard]] size_t RowEnd(size_t tile) const;
+  [[nodiscard]] size_t ColBegin(size_t tile) const;
+  [[nodiscard]] size_t ColEnd(size_t tile) const;
+  [[nodiscard]] size_t TileOf(size_t i, size_t j) const;
+
+  void Record(size_t tile, T change);
+  void Activate(size_t tile);
+  void ActivateAll();
+  void Advance();
+
+ private:
+  size_t rows_;
+  size_t cols_;
+  size_t tile_size_;
+  size_t tile_rows_;
+  size_t tile_cols_;
+  T threshold_;
+  bool periodic_;
+  std::vector<unsigned char> active_flags_;
+  std::vector<size_t> active_;
+  std::vector<T> changes_;
+  size_t updates_;
+  size_t skipped_;
+
+  [[nodiscard]] size_t Cells(size_t tile) const;
+}; // class ActiveSet
+
+} // namespace fluid_dynamics
+
+#include "active_set.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_ACTIVE_SET_H_
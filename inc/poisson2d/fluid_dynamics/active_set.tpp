@@ -0,0 +1,198 @@
+// File: inc/poisson2d/fluid_dynamics/active_set.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+ActiveSet<T>::ActiveSet()
+    : rows_{0}, cols_{0}, tile_size_{0}, tile_rows_{0}, tile_cols_{0}, threshold_{0}, periodic_{false},
+      updates_{0}, skipped_{0} {}
+
+template<typename T>
+ActiveSet<T>::ActiveSet(size_t rows, size_t cols, size_t tile_size, T threshold, bool periodic)
+    : rows_{rows}, cols_{cols}, tile_size_{tile_size}, threshold_{threshold}, periodic_{periodic},
+      updates_{0}, skipped_{0} {
+  if (tile_size == 0) {
+    throw std::invalid_argument("Tile size must be greater than zero");
+  }
+  tile_rows_ = (rows + tile_size - 1) / tile_size;
+  tile_cols_ = (cols + tile_size - 1) / tile_size;
+  active_flags_.assign(tile_rows_ * tile_cols_, 1);
+  changes_.assign(tile_rows_ * tile_cols_, 0);
+  active_.resize(tile_rows_ * tile_cols_);
+  for (size_t t = 0; t < active_.size(); ++t) {
+    active_[t] = t;
+  }
+}
+
+template<typename T>
+size_t ActiveSet<T>::rows() const {
+  return rows_;
+}
+
+template<typename T>
+size_t ActiveSet<T>::cols() const {
+  return cols_;
+}
+
+template<typename T>
+size_t ActiveSet<T>::tile_size() const {
+  return tile_size_;
+}
+
+template<typename T>
+size_t ActiveSet<T>::tile_rows() const {
+  return tile_rows_;
+}
+
+template<typename T>
+size_t ActiveSet<T>::tile_cols() const {
+  return tile_cols_;
+}
+
+template<typename T>
+size_t ActiveSet<T>::size() const {
+  return active_flags_.size();
+}
+
+template<typename T>
+T ActiveSet<T>::threshold() const {
+  return threshold_;
+}
+
+template<typename T>
+const std::vector<size_t>& ActiveSet<T>::active() const {
+  return active_;
+}
+
+template<typename T>
+bool ActiveSet<T>::frozen(size_t tile) const {
+  return !active_flags_[tile];
+}
+
+template<typename T>
+size_t ActiveSet<T>::frozen_count() const {
+  return size() - active_.size();
+}
+
+template<typename T>
+size_t ActiveSet<T>::updates() const {
+  return updates_;
+}
+
+template<typename T>
+size_t ActiveSet<T>::skipped() const {
+  return skipped_;
+}
+
+template<typename T>
+T ActiveSet<T>::norm() const {
+  T norm = 0;
+
+  for (size_t t : active_) {
+    norm += changes_[t];
+  }
+
+  return norm;
+}
+
+template<typename T>
+size_t ActiveSet<T>::RowBegin(size_t tile) const {
+  return (tile / tile_cols_) * tile_size_;
+}
+
+template<typename T>
+size_t ActiveSet<T>::RowEnd(size_t tile) const {
+  return std::min(RowBegin(tile) + tile_size_, rows_);
+}
+
+template<typename T>
+size_t ActiveSet<T>::ColBegin(size_t tile) const {
+  return (tile % tile_cols_) * tile_size_;
+}
+
+template<typename T>
+size_t ActiveSet<T>::ColEnd(size_t tile) const {
+  return std::min(ColBegin(tile) + tile_size_, cols_);
+}
+
+template<typename T>
+size_t ActiveSet<T>::TileOf(size_t i, size_t j) const {
+  return (i / tile_size_) * tile_cols_ + j / tile_size_;
+}
+
+template<typename T>
+void ActiveSet<T>::Record(size_t tile, T change) {
+  changes_[tile] = change;
+}
+
+template<typename T>
+void ActiveSet<T>::Activate(size_t tile) {
+  if (!active_flags_[tile]) {
+    active_flags_[tile] = 1;
+    changes_[tile] = 0;
+    active_.push_back(tile);
+  }
+}
+
+template<typename T>
+void ActiveSet<T>::ActivateAll() {
+  for (size_t t = 0; t < size(); ++t) {
+    Activate(t);
+  }
+}
+
+// Called once per sweep after the changes of all active tiles are recorded. Neighbours include the
+// diagonal ones so wider stencils see their whole footprint woken up, and wrap around if periodic.
+template<typename T>
+void ActiveSet<T>::Advance() {
+  std::vector<size_t> woken;
+
+  for (size_t t : active_) {
+    updates_ += Cells(t);
+    if (changes_[t] < threshold_) {
+      continue;
+    }
+    auto ti = static_cast<std::ptrdiff_t>(t / tile_cols_);
+    auto tj = static_cast<std::ptrdiff_t>(t % tile_cols_);
+    auto rows = static_cast<std::ptrdiff_t>(tile_rows_);
+    auto cols = static_cast<std::ptrdiff_t>(tile_cols_);
+    for (std::ptrdiff_t di = -1; di <= 1; ++di) {
+      for (std::ptrdiff_t dj = -1; dj <= 1; ++dj) {
+        std::ptrdiff_t ni = ti + di;
+        std::ptrdiff_t nj = tj + dj;
+        if (periodic_) {
+          ni = (ni + rows) % rows;
+          nj = (nj + cols) % cols;
+        } else if (ni < 0 || nj < 0 || ni >= rows || nj >= cols) {
+          continue;
+        }
+        woken.push_back(static_cast<size_t>(ni * cols + nj));
+      }
+    }
+  }
+  for (size_t t = 0; t < size(); ++t) {
+    if (!active_flags_[t]) {
+      skipped_ += Cells(t);
+    }
+  }
+
+  std::vector<size_t> active;
+  for (size_t t : active_) {
+    if (changes_[t] >= threshold_) {
+      active.push_back(t);
+    } else {
+      active_flags_[t] = 0;
+      changes_[t] = 0;
+    }
+  }
+  active_ = std::move(active);
+  for (size_t t : woken) {
+    Activate(t);
+  }
+}
+
+template<typename T>
+size_t ActiveSet<T>::Cells(size_t tile) const {
+  return (RowEnd(tile) - RowBegin(tile)) * (ColEnd(tile) - ColBegin(tile));
+}
+
+} // namespace fluid_dynamics
@@ -2,6 +2,8 @@
 #ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_BOUND_H_
 #define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_BOUND_H_
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 #include <functional>
 #include "grid.h"
@@ -13,10 +15,28 @@ enum class BoundaryType {
   kPeriodic
 }; // enum class BoundaryType
 
+// Half-open ranges of rows and columns.
+struct CellBox {
+  size_t row_begin;
+  size_t row_end;
+  size_t col_begin;
+  size_t col_end;
+
+  [[nodiscard]] static CellBox All();
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] bool Contains(size_t i, size_t j) const;
+  [[nodiscard]] CellBox Intersect(const CellBox& other) const;
+}; // struct CellBox
+
+// Covers the cells where condition holds. Boundaries built from the primitives in geometry.h also
+// carry a box around their cells and list the cells within a box, so solvers can skip the cells and
+// ranks they do not reach. Without cells, condition is evaluated on every cell of the box.
 template<typename T>
 struct Boundary {
   std::function<bool(size_t, size_t)> condition;
   std::function<T(size_t, size_t)> value;
+  CellBox box = CellBox::All();
+  std::function<void(const CellBox&, const std::function<void(size_t, size_t)>&)> cells{};
 }; // struct Boundary
 
 template<typename T>
@@ -28,6 +48,7 @@ class Bound {
   explicit Bound(BoundaryType type);
   Bound(BoundaryType type, const std::vector<Boundary<T>>& boundaries);
   Bound(BoundaryType type, std::vector<Boundary<T>>&& boundaries);
+  template<typename U> explicit Bound(const Bound<U>& other);
   ~Bound() = default;
 
   Bound& operator=(const Bound&) = default;
@@ -1,6 +1,23 @@
 // File inc/poisson2d/fluid_dynamics/bound.tpp
 namespace fluid_dynamics {
 
+inline CellBox CellBox::All() {
+  return {0, std::numeric_limits<size_t>::max(), 0, std::numeric_limits<size_t>::max()};
+}
+
+inline bool CellBox::empty() const {
+  return row_begin >= row_end || col_begin >= col_end;
+}
+
+inline bool CellBox::Contains(size_t i, size_t j) const {
+  return i >= row_begin && i < row_end && j >= col_begin && j < col_end;
+}
+
+inline CellBox CellBox::Intersect(const CellBox& other) const {
+  return {std::max(row_begin, other.row_begin), std::min(row_end, other.row_end),
+          std::max(col_begin, other.col_begin), std::min(col_end, other.col_end)};
+}
+
 template<typename T>
 Bound<T>::Bound() : type_{BoundaryType::kDirichlet}, boundaries_{} {}
 
@@ -15,6 +32,17 @@ template<typename T>
 Bound<T>::Bound(BoundaryType type, std::vector<Boundary<T>>&& boundaries)
     : type_{type}, boundaries_{std::move(boundaries)} {}
 
+// Keeps the conditions and converts the values with static_cast.
+template<typename T>
+template<typename U>
+Bound<T>::Bound(const Bound<U>& other) : type_{other.type()}, boundaries_{} {
+  for (const Boundary<U>& boundary : other.boundaries()) {
+    boundaries_.push_back({boundary.condition, [value = boundary.value](size_t i, size_t j) -> T {
+      return static_cast<T>(value(i, j));
+    }, boundary.box, boundary.cells});
+  }
+}
+
 template<typename T>
 BoundaryType Bound<T>::type() const {
   return type_;
@@ -0,0 +1,50 @@
+// File: inc/poisson2d/fluid_dynamics/bound3d.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_BOUND3D_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_BOUND3D_H_
+
+#include <vector>
+#include <functional>
+#include "bound.h"
+#include "grid3d.h"
+
+namespace fluid_dynamics {
+
+template<typename T>
+struct Boundary3D {
+  std::function<bool(size_t, size_t, size_t)> condition;
+  std::function<T(size_t, size_t, size_t)> value;
+}; // struct Boundary3D
+
+template<typename T>
+class Bound3D {
+ public:
+  Bound3D();
+  Bound3D(const Bound3D&) = default;
+  Bound3D(Bound3D&&) noexcept = default;
+  explicit Bound3D(BoundaryType type);
+  Bound3D(BoundaryType type, const std::vector<Boundary3D<T>>& boundaries);
+  Bound3D(BoundaryType type, std::vector<Boundary3D<T>>&& boundaries);
+  ~Bound3D() = default;
+
+  Bound3D& operator=(const Bound3D&) = default;
+  Bound3D& operator=(Bound3D&&) noexcept = default;
+
+  [[nodiscard]] BoundaryType type() const;
+  [[nodiscard]] const std::vector<Boundary3D<T>>& boundaries() const;
+  [[nodiscard]] std::vector<Boundary3D<T>>& boundaries();
+  [[nodiscard]] size_t size() const;
+
+  void type(BoundaryType type);
+  void AddBoundary(const Boundary3D<T>& boundary);
+  void AddBoundary(Boundary3D<T>&& boundary);
+
+ private:
+  BoundaryType type_;
+  std::vector<Boundary3D<T>> boundaries_;
+}; // class Bound3D
+
+} // namespace fluid_dynamics
+
+#include "bound3d.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_BOUND3D_H_
@@ -0,0 +1,53 @@
+// File: inc/poisson2d/fluid_dynamics/bound3d.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+Bound3D<T>::Bound3D() : type_{BoundaryType::kDirichlet}, boundaries_{} {}
+
+template<typename T>
+Bound3D<T>::Bound3D(BoundaryType type) : type_{type}, boundaries_{} {}
+
+template<typename T>
+Bound3D<T>::Bound3D(BoundaryType type, const std::vector<Boundary3D<T>>& boundaries)
+    : type_{type}, boundaries_{boundaries} {}
+
+template<typename T>
+Bound3D<T>::Bound3D(BoundaryType type, std::vector<Boundary3D<T>>&& boundaries)
+    : type_{type}, boundaries_{std::move(boundaries)} {}
+
+template<typename T>
+BoundaryType Bound3D<T>::type() const {
+  return type_;
+}
+
+template<typename T>
+const std::vector<Boundary3D<T>>& Bound3D<T>::boundaries() const {
+  return boundaries_;
+}
+
+template<typename T>
+std::vector<Boundary3D<T>>& Bound3D<T>::boundaries() {
+  return boundaries_;
+}
+
+template<typename T>
+size_t Bound3D<T>::size() const {
+  return boundaries_.size();
+}
+
+template<typename T>
+void Bound3D<T>::type(BoundaryType type) {
+  type_ = type;
+}
+
+template<typename T>
+void Bound3D<T>::AddBoundary(const Boundary3D<T>& boundary) {
+  boundaries_.push_back(boundary);
+}
+
+template<typename T>
+void Bound3D<T>::AddBoundary(Boundary3D<T>&& boundary) {
+  boundaries_.push_back(std::move(boundary));
+}
+
+} // namespace fluid_dynamics
@@ -0,0 +1,61 @@
+// File: inc/poisson2d/fluid_dynamics/bound_mask.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_BOUND_MASK_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_BOUND_MASK_H_
+
+#include "grid.h"
+#include "bound.h"
+
+namespace fluid_dynamics {
+
+enum class CellKind : unsigned char {
+  kOutside,
+  kFixed,
+  kBoundary,
+  kFallback,
+  kInterior
+}; // enum class CellKind
+
+// A Bound evaluated once on a block padded by halo cells. Cells covered by a boundary hold its value,
+// uncovered cells on the edge of the global domain keep their value, cells closer than the stencil
+// radius to that edge fall back to the 5-point stencil and halo cells beyond the domain are outside.
+// Without keep_edges the uncovered edge cells are relaxed against the halo like any other cell, as
+// SolverMpi does. Periodic bounds wrap the halo around the domain and fix no edge cells, boundaries
+// are only painted inside the domain. Indices are those of the padded block.
+template<typename T>
+class BoundMask {
+ public:
+  BoundMask();
+  BoundMask(const BoundMask&) = default;
+  BoundMask(BoundMask&&) noexcept = default;
+  BoundMask(const Bound<T>& bound, size_t rows, size_t cols, size_t halo, size_t radius);
+  BoundMask(const Bound<T>& bound, size_t rows, size_t cols, size_t halo, size_t radius,
+            size_t origin_row, size_t origin_col, size_t global_rows, size_t global_cols, bool keep_edges = true);
+  ~BoundMask() = default;
+
+  BoundMask& operator=(const BoundMask&) = default;
+  BoundMask& operator=(BoundMask&&) noexcept = default;
+
+  [[nodiscard]] size_t rows() const;
+  [[nodiscard]] size_t cols() const;
+  [[nodiscard]] size_t halo() const;
+  [[nodiscard]] size_t origin_row() const;
+  [[nodiscard]] size_t origin_col() const;
+  [[nodiscard]] CellKind kind(size_t i, size_t j) const;
+  [[nodiscard]] T value(size_t i, size_t j) const;
+  [[nodiscard]] bool fluid(size_t i, size_t j) const;
+
+ private:
+  size_t rows_;
+  size_t cols_;
+  size_t halo_;
+  size_t origin_row_;
+  size_t origin_col_;
+  Grid<CellKind> kinds_;
+  Grid<T> values_;
+}; // class BoundMask
+
+} // namespace fluid_dynamics
+
+#include "bound_mask.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_BOUND_MASK_H_
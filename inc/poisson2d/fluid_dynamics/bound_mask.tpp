@@ -0,0 +1,117 @@
+// File: inc/poisson2d/fluid_dynamics/bound_mask.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+BoundMask<T>::BoundMask() : rows_{0}, cols_{0}, halo_{0}, origin_row_{0}, origin_col_{0} {}
+
+template<typename T>
+BoundMask<T>::BoundMask(const Bound<T>& bound, size_t rows, size_t cols, size_t halo, size_t radius)
+    : BoundMask(bound, rows, cols, halo, radius, 0, 0, rows, cols) {}
+
+template<typename T>
+BoundMask<T>::BoundMask(const Bound<T>& bound, size_t rows, size_t cols, size_t halo, size_t radius,
+                        size_t origin_row, size_t origin_col, size_t global_rows, size_t global_cols,
+                        bool keep_edges)
+    : rows_{rows}, cols_{cols}, halo_{halo}, origin_row_{origin_row}, origin_col_{origin_col},
+      kinds_{rows + 2 * halo, cols + 2 * halo}, values_{rows + 2 * halo, cols + 2 * halo} {
+  bool periodic = bound.type() == BoundaryType::kPeriodic;
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) \
+          shared(origin_row, origin_col, global_rows, global_cols, halo, radius, keep_edges, periodic)
+#endif
+  for (size_t i = 0; i < kinds_.rows(); ++i) {
+    for (size_t j = 0; j < kinds_.cols(); ++j) {
+      // Unsigned wrap around puts the cells before the global origin beyond the domain as well.
+      size_t gi = origin_row + i - halo;
+      size_t gj = origin_col + j - halo;
+      CellKind kind = CellKind::kOutside;
+      if (periodic) {
+        gi = (gi + global_rows) % global_rows;
+        gj = (gj + global_cols) % global_cols;
+      }
+      if (gi < global_rows && gj < global_cols) {
+        kind = CellKind::kInterior;
+        if (keep_edges && !periodic && (gi == 0 || gj == 0 || gi == global_rows - 1 || gj == global_cols - 1)) {
+          kind = CellKind::kFixed;
+        } else if (radius > 1 && (gi < radius || gj < radius
+                                  || gi >= global_rows - radius || gj >= global_cols - radius)) {
+          kind = CellKind::kFallback;
+        }
+      }
+      kinds_(i, j) = kind;
+    }
+  }
+
+  // Boundaries are painted last to first, so a cell keeps the value of the first boundary covering it.
+  // Only the cells a boundary lists, or the cells of its box, are visited.
+  CellBox block{origin_row > halo ? origin_row - halo : 0, std::min(origin_row + rows + halo, global_rows),
+                origin_col > halo ? origin_col - halo : 0, std::min(origin_col + cols + halo, global_cols)};
+  auto paint = [this, origin_row, origin_col, halo](const Boundary<T>& boundary, size_t gi, size_t gj) {
+    kinds_(gi + halo - origin_row, gj + halo - origin_col) = CellKind::kBoundary;
+    values_(gi + halo - origin_row, gj + halo - origin_col) = boundary.value(gi, gj);
+  };
+  for (auto it = bound.boundaries().rbegin(); it != bound.boundaries().rend(); ++it) {
+    const Boundary<T>& boundary = *it;
+    CellBox clip = boundary.box.Intersect(block);
+    if (clip.empty()) {
+      continue;
+    }
+    if (boundary.cells) {
+      boundary.cells(clip, [&paint, &boundary](size_t gi, size_t gj) { paint(boundary, gi, gj); });
+      continue;
+    }
+#ifdef _OPENMP
+    #pragma omp parallel for default(none) shared(boundary, clip, paint)
+#endif
+    for (size_t gi = clip.row_begin; gi < clip.row_end; ++gi) {
+      for (size_t gj = clip.col_begin; gj < clip.col_end; ++gj) {
+        if (boundary.condition(gi, gj)) {
+          paint(boundary, gi, gj);
+        }
+      }
+    }
+  }
+}
+
+template<typename T>
+size_t BoundMask<T>::rows() const {
+  return rows_;
+}
+
+template<typename T>
+size_t BoundMask<T>::cols() const {
+  return cols_;
+}
+
+template<typename T>
+size_t BoundMask<T>::halo() const {
+  return halo_;
+}
+
+template<typename T>
+size_t BoundMask<T>::origin_row() const {
+  return origin_row_;
+}
+
+template<typename T>
+size_t BoundMask<T>::origin_col() const {
+  return origin_col_;
+}
+
+template<typename T>
+CellKind BoundMask<T>::kind(size_t i, size_t j) const {
+  return kinds_(i, j);
+}
+
+template<typename T>
+T BoundMask<T>::value(size_t i, size_t j) const {
+  return values_(i, j);
+}
+
+template<typename T>
+bool BoundMask<T>::fluid(size_t i, size_t j) const {
+  return kinds_(i, j) == CellKind::kInterior || kinds_(i, j) == CellKind::kFallback;
+}
+
+} // namespace fluid_dynamics
@@ -0,0 +1,74 @@
+// File: inc/poisson2d/fluid_dynamics/distributed_grid.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_DISTRIBUTED_GRID_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_DISTRIBUTED_GRID_H_
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <mpi.h>
+#include "grid.h"
+#include "mpi_util.h"
+
+namespace fluid_dynamics {
+
+// A global rows x cols grid split into equal blocks over the process grid of an MpiGrid2D, every
+// rank holds the block at its Cartesian coordinates. The MpiGrid2D is referenced, not copied, and
+// has to outlive the grid. Cells travel as raw bytes, so T only has to be trivially copyable.
+// Fetch, Gather, Scatter and Redistribute are collective over the communicator of the layout.
+template<typename T>
+class DistributedGrid {
+ public:
+  DistributedGrid();
+  DistributedGrid(const DistributedGrid&) = default;
+  DistributedGrid(DistributedGrid&&) noexcept = default;
+  DistributedGrid(MpiGrid2D& mpi_grid, size_t global_rows, size_t global_cols);
+  DistributedGrid(MpiGrid2D& mpi_grid, Grid<T> local);
+  ~DistributedGrid() = default;
+
+  DistributedGrid& operator=(const DistributedGrid&) = default;
+  DistributedGrid& operator=(DistributedGrid&&) noexcept = default;
+
+  [[nodiscard]] Grid<T>& local();
+  [[nodiscard]] const Grid<T>& local() const;
+  [[nodiscard]] MpiGrid2D& mpi_grid() const;
+  [[nodiscard]] size_t global_rows() const;
+  [[nodiscard]] size_t global_cols() const;
+  [[nodiscard]] size_t origin_row() const;
+  [[nodiscard]] size_t origin_col() const;
+
+  [[nodiscard]] bool Owns(size_t i, size_t j) const;
+  [[nodiscard]] int Owner(size_t i, size_t j) const;
+
+  // Global indices, only valid for cells this rank owns.
+  T& operator()(size_t i, size_t j);
+  const T& operator()(size_t i, size_t j) const;
+
+  // Reads cells at global indices from whichever rank owns them. Collective: every rank of the
+  // layout has to call it, with its own points or none, since each call creates and frees a window.
+  T Fetch(size_t i, size_t j) const;
+  std::vector<T> Fetch(const std::vector<std::pair<size_t, size_t>>& points) const;
+
+  Grid<T> Gather(int root = 0) const;
+  Grid<T> Gather(const std::vector<int>& ranks) const;
+  static DistributedGrid Scatter(const Grid<T>& global, MpiGrid2D& mpi_grid, int root = 0);
+  DistributedGrid Redistribute(MpiGrid2D& target) const;
+
+ private:
+  MpiGrid2D* mpi_grid_;
+  Grid<T> local_;
+  size_t global_rows_;
+  size_t global_cols_;
+
+  static void Block(MpiGrid2D& mpi_grid, int rank, size_t rows, size_t cols, size_t* origin);
+}; // class DistributedGrid
+
+template<typename T> void WriteGridBinary(DistributedGrid<T>& grid, const std::string& filename);
+
+} // namespace fluid_dynamics
+
+#include "distributed_grid.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_DISTRIBUTED_GRID_H_
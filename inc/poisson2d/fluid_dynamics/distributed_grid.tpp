@@ -0,0 +1,327 @@
+// File: inc/poisson2d/fluid_dynamics/distributed_grid.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+DistributedGrid<T>::DistributedGrid() : mpi_grid_{nullptr}, global_rows_{0}, global_cols_{0} {}
+
+template<typename T>
+DistributedGrid<T>::DistributedGrid(MpiGrid2D& mpi_grid, size_t global_rows, size_t global_cols)
+    : mpi_grid_{&mpi_grid}, local_{mpi_grid.LocalRows(global_rows), mpi_grid.LocalCols(global_cols)},
+      global_rows_{global_rows}, global_cols_{global_cols} {}
+
+template<typename T>
+DistributedGrid<T>::DistributedGrid(MpiGrid2D& mpi_grid, Grid<T> local)
+    : mpi_grid_{&mpi_grid}, local_{std::move(local)},
+      global_rows_{local_.rows() * mpi_grid.rows()}, global_cols_{local_.cols() * mpi_grid.cols()} {}
+
+template<typename T>
+Grid<T>& DistributedGrid<T>::local() {
+  return local_;
+}
+
+template<typename T>
+const Grid<T>& DistributedGrid<T>::local() const {
+  return local_;
+}
+
+template<typename T>
+MpiGrid2D& DistributedGrid<T>::mpi_grid() const {
+  return *mpi_grid_;
+}
+
+template<typename T>
+size_t DistributedGrid<T>::global_rows() const {
+  return global_rows_;
+}
+
+template<typename T>
+size_t DistributedGrid<T>::global_cols() const {
+  return global_cols_;
+}
+
+template<typename T>
+size_t DistributedGrid<T>::origin_row() const {
+  return mpi_grid_->GlobalRow(0, local_.rows());
+}
+
+template<typename T>
+size_t DistributedGrid<T>::origin_col() const {
+  return mpi_grid_->GlobalCol(0, local_.cols());
+}
+
+template<typename T>
+bool DistributedGrid<T>::Owns(size_t i, size_t j) const {
+  return i >= origin_row() && i < origin_row() + local_.rows()
+      && j >= origin_col() && j < origin_col() + local_.cols();
+}
+
+template<typename T>
+int DistributedGrid<T>::Owner(size_t i, size_t j) const {
+  int coords[2] = {static_cast<int>(j / local_.cols()), static_cast<int>(i / local_.rows())};
+  int rank;
+
+  MPI_Cart_rank(mpi_grid_->comm(), coords, &rank);
+  return rank;
+}
+
+template<typename T>
+T& DistributedGrid<T>::operator()(size_t i, size_t j) {
+  return local_(i - origin_row(), j - origin_col());
+}
+
+template<typename T>
+const T& DistributedGrid<T>::operator()(size_t i, size_t j) const {
+  return local_(i - origin_row(), j - origin_col());
+}
+
+template<typename T>
+T DistributedGrid<T>::Fetch(size_t i, size_t j) const {
+  return Fetch(std::vector<std::pair<size_t, size_t>>{{i, j}})[0];
+}
+
+// Every rank exposes its block in a window for one passive target epoch, owned points are read
+// directly and the others with one MPI_Get each. Ranks without points still have to take part, as
+// MPI_Win_create and MPI_Win_free are collective. Batch the points of a step into one call rather
+// than fetching them one by one. A single rank owns every point and needs no window, which some MPI
+// implementations cannot create on a communicator of one process.
+template<typename T>
+std::vector<T> DistributedGrid<T>::Fetch(const std::vector<std::pair<size_t, size_t>>& points) const {
+  std::vector<T> values(points.size());
+  size_t rows = local_.rows();
+  size_t cols = local_.cols();
+  MPI_Win window;
+
+  for (const auto& [i, j] : points) {
+    if (i >= global_rows_ || j >= global_cols_) {
+      throw std::out_of_range("Point outside of the distributed grid");
+    }
+  }
+  if (mpi_grid_->size() == 1) {
+    for (size_t p = 0; p < points.size(); ++p) {
+      values[p] = (*this)(points[p].first, points[p].second);
+    }
+    return values;
+  }
+
+  MPI_Win_create(const_cast<T*>(&local_(0, 0)), static_cast<MPI_Aint>(rows * cols * sizeof(T)), 1,
+                 MPI_INFO_NULL, mpi_grid_->comm(), &window);
+  MPI_Win_lock_all(0, window);
+  for (size_t p = 0; p < points.size(); ++p) {
+    auto [i, j] = points[p];
+    int owner = Owner(i, j);
+    if (owner == mpi_grid_->rank()) {
+      values[p] = (*this)(i, j);
+    } else {
+      auto displacement = static_cast<MPI_Aint>(((i % rows) * cols + j % cols) * sizeof(T));
+      MPI_Get(&values[p], sizeof(T), MPI_BYTE, owner, displacement, sizeof(T), MPI_BYTE, window);
+    }
+  }
+  MPI_Win_unlock_all(window);
+  MPI_Win_free(&window);
+
+  return values;
+}
+
+// Returns the global grid on root and an empty grid on the other ranks.
+template<typename T>
+Grid<T> DistributedGrid<T>::Gather(int root) const {
+  size_t rows = local_.rows();
+  size_t cols = local_.cols();
+  MPI_Datatype block = ContiguousType(rows * cols * sizeof(T), MPI_BYTE);
+  bool is_root = mpi_grid_->rank() == root;
+  std::vector<T> blocks(is_root ? rows * cols * mpi_grid_->size() : 0);
+  Grid<T> global;
+  size_t origin[2];
+
+  MPI_Gather(&local_(0, 0), 1, block, blocks.data(), 1, block, root, mpi_grid_->comm());
+  MPI_Type_free(&block);
+  if (is_root) {
+    global = Grid<T>{global_rows_, global_cols_};
+    for (int r = 0; r < mpi_grid_->size(); ++r) {
+      Block(*mpi_grid_, r, rows, cols, origin);
+      for (size_t i = 0; i < rows; ++i) {
+        const T* row = blocks.data() + (static_cast<size_t>(r) * rows + i) * cols;
+        std::copy(row, row + cols, &global(origin[0] + i, origin[1]));
+      }
+    }
+  }
+
+  return global;
+}
+
+// Gathers to the first listed rank and broadcasts to the others, ranks not in the list get an
+// empty grid.
+template<typename T>
+Grid<T> DistributedGrid<T>::Gather(const std::vector<int>& ranks) const {
+  if (ranks.empty()) {
+    throw std::invalid_argument("Gather needs at least one receiving rank");
+  }
+
+  Grid<T> global = Gather(ranks[0]);
+  auto position = std::find(ranks.begin(), ranks.end(), mpi_grid_->rank());
+  bool receiver = position != ranks.end();
+  MPI_Comm receivers;
+
+  MPI_Comm_split(mpi_grid_->comm(), receiver ? 0 : MPI_UNDEFINED,
+                 static_cast<int>(position - ranks.begin()), &receivers);
+  if (receiver) {
+    if (mpi_grid_->rank() != ranks[0]) {
+      global = Grid<T>{global_rows_, global_cols_};
+    }
+    MPI_Datatype grid_type = ContiguousType(global_rows_ * global_cols_ * sizeof(T), MPI_BYTE);
+    MPI_Bcast(&global(0, 0), 1, grid_type, 0, receivers);
+    MPI_Type_free(&grid_type);
+    MPI_Comm_free(&receivers);
+  }
+
+  return global;
+}
+
+// Only the grid on root is read.
+template<typename T>
+DistributedGrid<T> DistributedGrid<T>::Scatter(const Grid<T>& global, MpiGrid2D& mpi_grid, int root) {
+  unsigned long long dims[2] = {global.rows(), global.cols()};
+
+  MPI_Bcast(dims, 2, MPI_UNSIGNED_LONG_LONG, root, mpi_grid.comm());
+
+  DistributedGrid grid{mpi_grid, dims[0], dims[1]};
+  size_t rows = grid.local_.rows();
+  size_t cols = grid.local_.cols();
+  MPI_Datatype block = ContiguousType(rows * cols * sizeof(T), MPI_BYTE);
+  bool is_root = mpi_grid.rank() == root;
+  std::vector<T> blocks(is_root ? rows * cols * mpi_grid.size() : 0);
+  size_t origin[2];
+
+  if (is_root) {
+    for (int r = 0; r < mpi_grid.size(); ++r) {
+      Block(mpi_grid, r, rows, cols, origin);
+      for (size_t i = 0; i < rows; ++i) {
+        std::copy(&global(origin[0] + i, origin[1]), &global(origin[0] + i, origin[1]) + cols,
+                  blocks.data() + (static_cast<size_t>(r) * rows + i) * cols);
+      }
+    }
+  }
+  MPI_Scatter(blocks.data(), 1, block, &grid.local_(0, 0), 1, block, root, mpi_grid.comm());
+  MPI_Type_free(&block);
+
+  return grid;
+}
+
+// Moves the grid onto the decomposition of target, which has to span the same processes. Every
+// rank sends the overlap of its block with each target block in one message. Point to point
+// messages with derived types replace MPI_Alltoallv, whose int displacements overflow for blocks
+// beyond 2 GB.
+template<typename T>
+DistributedGrid<T> DistributedGrid<T>::Redistribute(MpiGrid2D& target) const {
+  int size = mpi_grid_->size();
+  MPI_Group source_group, target_group;
+  std::vector<int> source_ranks(size);
+  std::vector<int> target_ranks(size);
+
+  if (target.size() != size) {
+    throw std::invalid_argument("Redistribution needs process grids over the same processes");
+  }
+  for (int r = 0; r < size; ++r) {
+    source_ranks[r] = r;
+  }
+  MPI_Comm_group(mpi_grid_->comm(), &source_group);
+  MPI_Comm_group(target.comm(), &target_group);
+  MPI_Group_translate_ranks(source_group, size, source_ranks.data(), target_group, target_ranks.data());
+  MPI_Group_free(&source_group);
+  MPI_Group_free(&target_group);
+  if (std::find(target_ranks.begin(), target_ranks.end(), MPI_UNDEFINED) != target_ranks.end()) {
+    throw std::invalid_argument("Redistribution needs process grids over the same processes");
+  }
+
+  DistributedGrid result{target, global_rows_, global_cols_};
+  size_t rows = local_.rows();
+  size_t cols = local_.cols();
+  size_t target_rows = result.local_.rows();
+  size_t target_cols = result.local_.cols();
+  size_t own[2] = {origin_row(), origin_col()};
+  size_t own_target[2] = {result.origin_row(), result.origin_col()};
+  std::vector<size_t> send_counts(size), send_displs(size), recv_counts(size), recv_displs(size);
+  std::vector<MPI_Request> requests;
+  std::vector<T> send, recv;
+  size_t origin[2];
+
+  // Overlap of [a, a + a_size) and [b, b + b_size), empty if begin >= end.
+  auto overlap = [](size_t a, size_t a_size, size_t b, size_t b_size) {
+    return std::pair<size_t, size_t>{std::max(a, b), std::min(a + a_size, b + b_size)};
+  };
+
+  for (int p = 0; p < size; ++p) {
+    Block(target, target_ranks[p], target_rows, target_cols, origin);
+    auto [row_begin, row_end] = overlap(own[0], rows, origin[0], target_rows);
+    auto [col_begin, col_end] = overlap(own[1], cols, origin[1], target_cols);
+    send_displs[p] = send.size();
+    for (size_t i = row_begin; col_begin < col_end && i < row_end; ++i) {
+      const T* row = &local_(i - own[0], col_begin - own[1]);
+      send.insert(send.end(), row, row + (col_end - col_begin));
+    }
+    send_counts[p] = send.size() - send_displs[p];
+  }
+
+  size_t recv_size = 0;
+  for (int p = 0; p < size; ++p) {
+    Block(*mpi_grid_, p, rows, cols, origin);
+    auto [row_begin, row_end] = overlap(own_target[0], target_rows, origin[0], rows);
+    auto [col_begin, col_end] = overlap(own_target[1], target_cols, origin[1], cols);
+    size_t cells = row_begin < row_end && col_begin < col_end ? (row_end - row_begin) * (col_end - col_begin) : 0;
+    recv_displs[p] = recv_size;
+    recv_counts[p] = cells;
+    recv_size += cells;
+  }
+  recv.resize(recv_size);
+
+  auto post = [&requests, this](T* data, size_t count, int peer, bool receive) {
+    if (count == 0) {
+      return;
+    }
+    MPI_Datatype type = ContiguousType(count * sizeof(T), MPI_BYTE);
+    requests.emplace_back();
+    if (receive) {
+      MPI_Irecv(data, 1, type, peer, 0, mpi_grid_->comm(), &requests.back());
+    } else {
+      MPI_Isend(data, 1, type, peer, 0, mpi_grid_->comm(), &requests.back());
+    }
+    MPI_Type_free(&type);
+  };
+  for (int p = 0; p < size; ++p) {
+    post(recv.data() + recv_displs[p], recv_counts[p], p, true);
+  }
+  for (int p = 0; p < size; ++p) {
+    post(send.data() + send_displs[p], send_counts[p], p, false);
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+
+  const T* next = recv.data();
+  for (int p = 0; p < size; ++p) {
+    Block(*mpi_grid_, p, rows, cols, origin);
+    auto [row_begin, row_end] = overlap(own_target[0], target_rows, origin[0], rows);
+    auto [col_begin, col_end] = overlap(own_target[1], target_cols, origin[1], cols);
+    for (size_t i = row_begin; col_begin < col_end && i < row_end; ++i) {
+      std::copy(next, next + (col_end - col_begin), &result.local_(i - own_target[0], col_begin - own_target[1]));
+      next += col_end - col_begin;
+    }
+  }
+
+  return result;
+}
+
+// Origin, as global row and column, of the block that rank holds in mpi_grid.
+template<typename T>
+void DistributedGrid<T>::Block(MpiGrid2D& mpi_grid, int rank, size_t rows, size_t cols, size_t* origin) {
+  int coords[2];
+
+  MPI_Cart_coords(mpi_grid.comm(), rank, 2, coords);
+  origin[0] = static_cast<size_t>(coords[1]) * rows;
+  origin[1] = static_cast<size_t>(coords[0]) * cols;
+}
+
+template<typename T>
+void WriteGridBinary(DistributedGrid<T>& grid, const std::string& filename) {
+  WriteGridBinary(grid.local(), filename, grid.mpi_grid());
+}
+
+} // namespace fluid_dynamics
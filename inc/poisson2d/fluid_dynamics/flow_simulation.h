@@ -0,0 +1,85 @@
+// File: inc/poisson2d/fluid_dynamics/flow_simulation.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_FLOW_SIMULATION_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_FLOW_SIMULATION_H_
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include "grid.h"
+#include "bound.h"
+#include "bound_mask.h"
+#include "solver.h"
+
+namespace fluid_dynamics {
+
+// spacing: distance between neighbouring cells.
+// time_step: explicit Euler step of the vorticity transport.
+// viscosity: kinematic viscosity.
+// lid_velocity: velocity along the columns of the wall in row 0, all other walls are at rest.
+struct FlowOptions {
+  double spacing = 1.0;
+  double time_step = 0.1;
+  double viscosity = 0.1;
+  double lid_velocity = 1.0;
+}; // struct FlowOptions
+
+namespace flow_detail {
+
+inline void CheckOptions(const FlowOptions& options);
+template<typename T> void WallVorticity(const Grid<T>& psi, Grid<T>& omega, const BoundMask<T>& mask,
+                                        const FlowOptions& options);
+template<typename T> void Advect(const Grid<T>& psi, const Grid<T>& omega, Grid<T>& next, const BoundMask<T>& mask,
+                                 const FlowOptions& options);
+template<typename T> Grid<std::pair<T, T>> Velocity(const Grid<T>& psi, const BoundMask<T>& mask,
+                                                    const FlowOptions& options);
+template<typename T> Grid<T> Block(const Grid<T>& padded, const BoundMask<T>& mask);
+
+} // namespace flow_detail
+
+// Unsteady incompressible flow in the vorticity-streamfunction form. Every step sets the wall
+// vorticity from the streamfunction, advects and diffuses the vorticity, and solves
+// laplace(psi) = -omega with the Jacobi iteration of Solver, starting from the previous
+// streamfunction. Initialize compiles the bound and allocates all buffers, Step allocates nothing.
+// Cells covered by the bound or on the edge of the domain are walls; the velocity is
+// (d psi / d row, -d psi / d col) as in Solver::Velocity.
+template<typename T, typename Stencil = FivePoint>
+class FlowSimulation : public Solver<T, Stencil> {
+ public:
+  using Solver<T, Stencil>::Solver;
+
+  [[nodiscard]] const FlowOptions& options() const;
+  [[nodiscard]] double time() const;
+  [[nodiscard]] size_t steps() const;
+  [[nodiscard]] size_t poisson_iterations() const;
+  [[nodiscard]] Grid<T> streamfunction() const;
+  [[nodiscard]] Grid<T> vorticity() const;
+  [[nodiscard]] Grid<std::pair<T, T>> velocity() const;
+
+  void options(const FlowOptions& options);
+
+  void Initialize(size_t rows, size_t cols, const Bound<T>& bound);
+  void Step();
+  void Run(size_t steps, bool verbose = false);
+
+ private:
+  static constexpr size_t kHalo = Stencil::kRadius;
+
+  FlowOptions options_;
+  BoundMask<T> mask_;
+  Grid<T> psi_;
+  Grid<T> psi_scratch_;
+  Grid<T> omega_;
+  Grid<T> omega_next_;
+  double time_ = 0.0;
+  size_t steps_ = 0;
+  size_t poisson_iterations_ = 0;
+}; // class FlowSimulation
+
+} // namespace fluid_dynamics
+
+#include "flow_simulation.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_FLOW_SIMULATION_H_
@@ -0,0 +1,236 @@
+// File: inc/poisson2d/fluid_dynamics/flow_simulation.tpp
+namespace fluid_dynamics {
+
+namespace flow_detail {
+
+// The explicit step is stable for diffusion numbers up to 1/4 and Courant numbers up to 1.
+inline void CheckOptions(const FlowOptions& options) {
+  if (options.spacing <= 0 || options.time_step <= 0 || options.viscosity < 0) {
+    throw std::invalid_argument("Spacing and time step must be positive and viscosity non-negative");
+  }
+  if (options.viscosity * options.time_step > 0.25 * options.spacing * options.spacing) {
+    throw std::invalid_argument("Time step exceeds the diffusive stability limit");
+  }
+  if (std::abs(options.lid_velocity) * options.time_step > options.spacing) {
+    throw std::invalid_argument("Time step exceeds the advective stability limit");
+  }
+}
+
+// Thom's formula, averaged over the fluid neighbours of a wall cell. Cells in row 0 of the global
+// domain move with the lid.
+template<typename T>
+void WallVorticity(const Grid<T>& psi, Grid<T>& omega, const BoundMask<T>& mask, const FlowOptions& options) {
+  auto h = static_cast<T>(options.spacing);
+  T wall = static_cast<T>(-2.0) / (h * h);
+  T lid = static_cast<T>(2.0 * options.lid_velocity / options.spacing);
+  size_t halo = mask.halo();
+  size_t end_row = halo + mask.rows();
+  size_t end_col = halo + mask.cols();
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(psi, omega, mask, wall, lid, halo, end_row, end_col)
+#endif
+  for (size_t i = halo; i < end_row; ++i) {
+    for (size_t j = halo; j < end_col; ++j) {
+      if (mask.fluid(i, j)) {
+        continue;
+      }
+      T sum = 0;
+      size_t neighbours = 0;
+      const std::pair<size_t, size_t> around[4] = {{i - 1, j}, {i + 1, j}, {i, j - 1}, {i, j + 1}};
+      for (const auto& [ni, nj] : around) {
+        if (mask.fluid(ni, nj)) {
+          sum += psi(ni, nj) - psi(i, j);
+          ++neighbours;
+        }
+      }
+      if (neighbours == 0) {
+        omega(i, j) = 0;
+      } else {
+        omega(i, j) = wall * sum / static_cast<T>(neighbours);
+        if (mask.origin_row() + i - halo == 0) {
+          omega(i, j) += lid;
+        }
+      }
+    }
+  }
+}
+
+// Explicit Euler step of d omega / dt + u . grad(omega) = viscosity * laplace(omega) with central
+// differences. Wall cells carry their vorticity over unchanged.
+template<typename T>
+void Advect(const Grid<T>& psi, const Grid<T>& omega, Grid<T>& next, const BoundMask<T>& mask,
+            const FlowOptions& options) {
+  auto dt = static_cast<T>(options.time_step);
+  auto half = static_cast<T>(0.5 / options.spacing);
+  auto diffusion = static_cast<T>(options.viscosity / (options.spacing * options.spacing));
+  size_t halo = mask.halo();
+  size_t end_row = halo + mask.rows();
+  size_t end_col = halo + mask.cols();
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(psi, omega, next, mask, dt, half, diffusion, halo, end_row, end_col)
+#endif
+  for (size_t i = halo; i < end_row; ++i) {
+    for (size_t j = halo; j < end_col; ++j) {
+      if (!mask.fluid(i, j)) {
+        next(i, j) = omega(i, j);
+        continue;
+      }
+      T u = half * (psi(i + 1, j) - psi(i - 1, j));
+      T v = -half * (psi(i, j + 1) - psi(i, j - 1));
+      T d_col = half * (omega(i, j + 1) - omega(i, j - 1));
+      T d_row = half * (omega(i + 1, j) - omega(i - 1, j));
+      T laplace = omega(i + 1, j) + omega(i - 1, j) + omega(i, j + 1) + omega(i, j - 1) - 4 * omega(i, j);
+      next(i, j) = omega(i, j) + dt * (diffusion * laplace - u * d_col - v * d_row);
+    }
+  }
+}
+
+template<typename T>
+Grid<std::pair<T, T>> Velocity(const Grid<T>& psi, const BoundMask<T>& mask, const FlowOptions& options) {
+  Grid<std::pair<T, T>> velocity{mask.rows(), mask.cols()};
+  auto half = static_cast<T>(0.5 / options.spacing);
+  auto lid = static_cast<T>(options.lid_velocity);
+  size_t halo = mask.halo();
+
+  for (size_t i = 0; i < mask.rows(); ++i) {
+    for (size_t j = 0; j < mask.cols(); ++j) {
+      size_t pi = i + halo;
+      size_t pj = j + halo;
+      if (mask.fluid(pi, pj)) {
+        velocity(i, j) = {half * (psi(pi + 1, pj) - psi(pi - 1, pj)), -half * (psi(pi, pj + 1) - psi(pi, pj - 1))};
+      } else if (mask.origin_row() + i == 0) {
+        velocity(i, j) = {lid, 0};
+      } else {
+        velocity(i, j) = {0, 0};
+      }
+    }
+  }
+
+  return velocity;
+}
+
+template<typename T>
+Grid<T> Block(const Grid<T>& padded, const BoundMask<T>& mask) {
+  Grid<T> block{mask.rows(), mask.cols()};
+
+  for (size_t i = 0; i < mask.rows(); ++i) {
+    std::copy_n(&padded(i + mask.halo(), mask.halo()), mask.cols(), block.data(i, 0));
+  }
+
+  return block;
+}
+
+} // namespace flow_detail
+
+template<typename T, typename Stencil>
+const FlowOptions& FlowSimulation<T, Stencil>::options() const {
+  return options_;
+}
+
+template<typename T, typename Stencil>
+double FlowSimulation<T, Stencil>::time() const {
+  return time_;
+}
+
+template<typename T, typename Stencil>
+size_t FlowSimulation<T, Stencil>::steps() const {
+  return steps_;
+}
+
+template<typename T, typename Stencil>
+size_t FlowSimulation<T, Stencil>::poisson_iterations() const {
+  return poisson_iterations_;
+}
+
+template<typename T, typename Stencil>
+Grid<T> FlowSimulation<T, Stencil>::streamfunction() const {
+  return flow_detail::Block(psi_, mask_);
+}
+
+template<typename T, typename Stencil>
+Grid<T> FlowSimulation<T, Stencil>::vorticity() const {
+  return flow_detail::Block(omega_, mask_);
+}
+
+template<typename T, typename Stencil>
+Grid<std::pair<T, T>> FlowSimulation<T, Stencil>::velocity() const {
+  return flow_detail::Velocity(psi_, mask_, options_);
+}
+
+template<typename T, typename Stencil>
+void FlowSimulation<T, Stencil>::options(const FlowOptions& options) {
+  flow_detail::CheckOptions(options);
+  options_ = options;
+}
+
+// The fluid starts at rest, walls take the streamfunction values of the bound.
+template<typename T, typename Stencil>
+void FlowSimulation<T, Stencil>::Initialize(size_t rows, size_t cols, const Bound<T>& bound) {
+  flow_detail::CheckOptions(options_);
+  if (bound.type() == BoundaryType::kPeriodic) {
+    throw std::invalid_argument("FlowSimulation does not support periodic bounds");
+  }
+  mask_ = BoundMask<T>{bound, rows, cols, kHalo, Stencil::kRadius};
+  psi_ = Grid<T>{rows + 2 * kHalo, cols + 2 * kHalo};
+  for (size_t i = 0; i < psi_.rows(); ++i) {
+    for (size_t j = 0; j < psi_.cols(); ++j) {
+      if (mask_.kind(i, j) == CellKind::kBoundary) {
+        psi_(i, j) = mask_.value(i, j);
+      }
+    }
+  }
+  psi_scratch_ = psi_;
+  omega_ = Grid<T>{psi_.rows(), psi_.cols()};
+  omega_next_ = omega_;
+  time_ = 0.0;
+  steps_ = 0;
+  poisson_iterations_ = 0;
+  Solver<T, Stencil>::profiler().Reset();
+}
+
+template<typename T, typename Stencil>
+void FlowSimulation<T, Stencil>::Step() {
+  if (psi_.rows() == 0) {
+    throw std::runtime_error("FlowSimulation must be initialized before stepping");
+  }
+
+  flow_detail::WallVorticity(psi_, omega_, mask_, options_);
+  flow_detail::Advect(psi_, omega_, omega_next_, mask_, options_);
+  std::swap(omega_, omega_next_);
+  auto scale = static_cast<T>(options_.spacing * options_.spacing);
+  poisson_iterations_ = Solver<T, Stencil>::IterateInPlace(psi_, psi_scratch_, omega_, scale, mask_);
+  time_ += options_.time_step;
+  ++steps_;
+}
+
+template<typename T, typename Stencil>
+void FlowSimulation<T, Stencil>::Run(size_t steps, bool verbose) {
+  size_t poisson_total = 0;
+  size_t progress_intervals = static_cast<size_t>(steps * 0.05);
+  size_t progress_steps = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (size_t step = 0; step < steps; ++step) {
+    Step();
+    poisson_total += poisson_iterations_;
+    if (verbose && step == progress_steps * progress_intervals) {
+      Solver<T, Stencil>::Progress(step, steps);
+      ++progress_steps;
+    }
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<long double> time_taken = end - start;
+
+  if (verbose) {
+    Solver<T, Stencil>::Progress(steps, steps);
+    std::cout << "Time steps: " << steps << ", simulated time: " << time_ << std::endl;
+    std::cout << "Poisson iterations per step: " << static_cast<double>(poisson_total) / std::max<size_t>(steps, 1)
+              << std::endl;
+    std::cout << std::setprecision(6) << "Time Taken: " << time_taken.count() << "s" << std::endl;
+  }
+}
+
+} // namespace fluid_dynamics
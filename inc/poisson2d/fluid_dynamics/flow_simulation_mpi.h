@@ -0,0 +1,70 @@
+// File: inc/poisson2d/fluid_dynamics/flow_simulation_mpi.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_FLOW_SIMULATION_MPI_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_FLOW_SIMULATION_MPI_H_
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include "grid.h"
+#include "bound.h"
+#include "bound_mask.h"
+#include "flow_simulation.h"
+#include "solver_mpi.h"
+#include "mpi_util.h"
+
+namespace fluid_dynamics {
+
+// FlowSimulation on the local blocks of an MpiGrid2D. The MpiGrid2D is bound at construction and
+// referenced, not copied, so it has to outlive the simulation. Its halo types are created by
+// Initialize and kept until the simulation is destroyed, so other solves must not use the same
+// MpiGrid2D in between.
+template<typename T, typename Stencil = FivePoint>
+class FlowSimulationMpi : public SolverMpi<T, Stencil> {
+ public:
+  explicit FlowSimulationMpi(MpiGrid2D& mpi_grid);
+  FlowSimulationMpi(MpiGrid2D& mpi_grid, T epsilon, size_t max_iter);
+  FlowSimulationMpi(const FlowSimulationMpi&) = delete;
+  FlowSimulationMpi(FlowSimulationMpi&&) noexcept = delete;
+  ~FlowSimulationMpi();
+
+  FlowSimulationMpi& operator=(const FlowSimulationMpi&) = delete;
+  FlowSimulationMpi& operator=(FlowSimulationMpi&&) noexcept = delete;
+
+  [[nodiscard]] MpiGrid2D& mpi_grid() const;
+  [[nodiscard]] const FlowOptions& options() const;
+  [[nodiscard]] double time() const;
+  [[nodiscard]] size_t steps() const;
+  [[nodiscard]] size_t poisson_iterations() const;
+  [[nodiscard]] Grid<T> streamfunction() const;
+  [[nodiscard]] Grid<T> vorticity() const;
+  [[nodiscard]] Grid<std::pair<T, T>> velocity() const;
+
+  void options(const FlowOptions& options);
+
+  void Initialize(size_t rows, size_t cols, const Bound<T>& global_bound);
+  void Step();
+  void Run(size_t steps, bool verbose = false);
+
+ private:
+  static constexpr size_t kHalo = Stencil::kRadius;
+
+  MpiGrid2D& mpi_grid_;
+  bool initialized_ = false;
+  FlowOptions options_;
+  BoundMask<T> mask_;
+  Grid<T> psi_;
+  Grid<T> psi_scratch_;
+  Grid<T> omega_;
+  Grid<T> omega_next_;
+  double time_ = 0.0;
+  size_t steps_ = 0;
+  size_t poisson_iterations_ = 0;
+}; // class FlowSimulationMpi
+
+} // namespace fluid_dynamics
+
+#include "flow_simulation_mpi.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_FLOW_SIMULATION_MPI_H_
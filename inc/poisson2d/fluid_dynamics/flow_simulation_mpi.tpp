@@ -0,0 +1,156 @@
+// File: inc/poisson2d/fluid_dynamics/flow_simulation_mpi.tpp
+namespace fluid_dynamics {
+
+template<typename T, typename Stencil>
+FlowSimulationMpi<T, Stencil>::FlowSimulationMpi(MpiGrid2D& mpi_grid)
+    : SolverMpi<T, Stencil>(), mpi_grid_{mpi_grid} {}
+
+template<typename T, typename Stencil>
+FlowSimulationMpi<T, Stencil>::FlowSimulationMpi(MpiGrid2D& mpi_grid, T epsilon, size_t max_iter)
+    : SolverMpi<T, Stencil>(epsilon, max_iter), mpi_grid_{mpi_grid} {}
+
+template<typename T, typename Stencil>
+FlowSimulationMpi<T, Stencil>::~FlowSimulationMpi() {
+  int finalized;
+
+  MPI_Finalized(&finalized);
+  if (initialized_ && !finalized) {
+    mpi_grid_.FreeTypes();
+  }
+}
+
+template<typename T, typename Stencil>
+MpiGrid2D& FlowSimulationMpi<T, Stencil>::mpi_grid() const {
+  return mpi_grid_;
+}
+
+template<typename T, typename Stencil>
+const FlowOptions& FlowSimulationMpi<T, Stencil>::options() const {
+  return options_;
+}
+
+template<typename T, typename Stencil>
+double FlowSimulationMpi<T, Stencil>::time() const {
+  return time_;
+}
+
+template<typename T, typename Stencil>
+size_t FlowSimulationMpi<T, Stencil>::steps() const {
+  return steps_;
+}
+
+template<typename T, typename Stencil>
+size_t FlowSimulationMpi<T, Stencil>::poisson_iterations() const {
+  return poisson_iterations_;
+}
+
+template<typename T, typename Stencil>
+Grid<T> FlowSimulationMpi<T, Stencil>::streamfunction() const {
+  return flow_detail::Block(psi_, mask_);
+}
+
+template<typename T, typename Stencil>
+Grid<T> FlowSimulationMpi<T, Stencil>::vorticity() const {
+  return flow_detail::Block(omega_, mask_);
+}
+
+template<typename T, typename Stencil>
+Grid<std::pair<T, T>> FlowSimulationMpi<T, Stencil>::velocity() const {
+  return flow_detail::Velocity(psi_, mask_, options_);
+}
+
+template<typename T, typename Stencil>
+void FlowSimulationMpi<T, Stencil>::options(const FlowOptions& options) {
+  flow_detail::CheckOptions(options);
+  options_ = options;
+}
+
+// rows and cols are the dimensions of the local block, the bound is given in global coordinates.
+template<typename T, typename Stencil>
+void FlowSimulationMpi<T, Stencil>::Initialize(size_t rows, size_t cols, const Bound<T>& global_bound) {
+  flow_detail::CheckOptions(options_);
+  if (global_bound.type() == BoundaryType::kPeriodic) {
+    throw std::invalid_argument("FlowSimulationMpi does not support periodic bounds");
+  }
+  if (initialized_) {
+    mpi_grid_.FreeTypes();
+  }
+  mask_ = BoundMask<T>{global_bound, rows, cols, kHalo, Stencil::kRadius, mpi_grid_.GlobalRow(0, rows),
+                       mpi_grid_.GlobalCol(0, cols), rows * mpi_grid_.rows(), cols * mpi_grid_.cols()};
+  psi_ = Grid<T>{rows + 2 * kHalo, cols + 2 * kHalo};
+  for (size_t i = 0; i < psi_.rows(); ++i) {
+    for (size_t j = 0; j < psi_.cols(); ++j) {
+      if (mask_.kind(i, j) == CellKind::kBoundary) {
+        psi_(i, j) = mask_.value(i, j);
+      }
+    }
+  }
+  psi_scratch_ = psi_;
+  omega_ = Grid<T>{psi_.rows(), psi_.cols()};
+  omega_next_ = omega_;
+  time_ = 0.0;
+  steps_ = 0;
+  poisson_iterations_ = 0;
+  mpi_grid_.CreateHaloTypes(rows, cols, kHalo, MpiType<T>());
+  initialized_ = true;
+  SolverMpi<T, Stencil>::ExchangeBoundaryData(psi_, mpi_grid_);
+  Solver<T, Stencil>::profiler().Reset();
+}
+
+// The streamfunction halo is refreshed at the end of every step, so the wall vorticity and the
+// velocity always see the neighbouring blocks.
+template<typename T, typename Stencil>
+void FlowSimulationMpi<T, Stencil>::Step() {
+  if (!initialized_) {
+    throw std::runtime_error("FlowSimulationMpi must be initialized before stepping");
+  }
+
+  [[maybe_unused]] Profiler& profiler = Solver<T, Stencil>::profiler();
+
+  flow_detail::WallVorticity(psi_, omega_, mask_, options_);
+  {
+    FDSIM_PROFILE_SCOPE(profiler, Phase::kHaloExchange);
+    SolverMpi<T, Stencil>::ExchangeBoundaryData(omega_, mpi_grid_);
+  }
+  flow_detail::Advect(psi_, omega_, omega_next_, mask_, options_);
+  std::swap(omega_, omega_next_);
+  auto scale = static_cast<T>(options_.spacing * options_.spacing);
+  poisson_iterations_ = SolverMpi<T, Stencil>::IterateInPlace(psi_, psi_scratch_, omega_, scale, mask_, mpi_grid_);
+  {
+    FDSIM_PROFILE_SCOPE(profiler, Phase::kHaloExchange);
+    SolverMpi<T, Stencil>::ExchangeBoundaryData(psi_, mpi_grid_);
+  }
+  time_ += options_.time_step;
+  ++steps_;
+}
+
+template<typename T, typename Stencil>
+void FlowSimulationMpi<T, Stencil>::Run(size_t steps, bool verbose) {
+  bool report = verbose && mpi_grid_.rank() == 0;
+  size_t poisson_total = 0;
+  size_t progress_intervals = static_cast<size_t>(steps * 0.05);
+  size_t progress_steps = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (size_t step = 0; step < steps; ++step) {
+    Step();
+    poisson_total += poisson_iterations_;
+    if (report && step == progress_steps * progress_intervals) {
+      Solver<T, Stencil>::Progress(step, steps);
+      ++progress_steps;
+    }
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<long double> time_taken = end - start;
+
+  if (report) {
+    Solver<T, Stencil>::Progress(steps, steps);
+    std::cout << "Time steps: " << steps << ", simulated time: " << time_ << std::endl;
+    std::cout << "Poisson iterations per step: " << static_cast<double>(poisson_total) / std::max<size_t>(steps, 1)
+              << std::endl;
+    std::cout << std::setprecision(6) << "Time Taken: " << time_taken.count() << "s" << std::endl;
+  }
+}
+
+} // namespace fluid_dynamics
@@ -0,0 +1,55 @@
+// File: inc/poisson2d/fluid_dynamics/geometry.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GEOMETRY_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GEOMETRY_H_
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "bound.h"
+
+namespace fluid_dynamics {
+
+// Row and column of a cell.
+using Cell = std::pair<size_t, size_t>;
+
+template<typename T> std::function<T(size_t, size_t)> ConstantValue(T value);
+template<typename T> std::function<T(size_t, size_t)> LinearValue(T value, T row_slope, T col_slope,
+                                                              Cell anchor = {0, 0});
+
+// Boundary primitives with a bounding box and a list of their cells. The end points and corners
+// are covered as well.
+template<typename T> Boundary<T> SegmentBoundary(Cell from, Cell to, std::function<T(size_t, size_t)> value);
+template<typename T> Boundary<T> RectangleBoundary(Cell corner, Cell opposite, std::function<T(size_t, size_t)> value,
+                                                   bool filled = true);
+template<typename T> Boundary<T> PolylineBoundary(const std::vector<Cell>& points,
+                                                  std::function<T(size_t, size_t)> value);
+
+// Reads a Bound from a geometry file, see README.md for the format. Coordinates may refer to the
+// extent of their axis, so one file describes the geometry for any grid size.
+template<typename T> Bound<T> ReadGeometry(std::istream& in, size_t rows, size_t cols);
+template<typename T> Bound<T> ReadGeometry(const std::string& filename, size_t rows, size_t cols);
+
+namespace geometry_detail {
+
+template<typename T> Boundary<T> BoxBoundary(const CellBox& box, std::function<T(size_t, size_t)> value);
+template<typename T> Boundary<T> CellListBoundary(std::vector<Cell> cells, std::function<T(size_t, size_t)> value);
+void Rasterize(Cell from, Cell to, std::vector<Cell>& cells);
+size_t ParseCoordinate(const std::string& token, size_t extent);
+double ParseNumber(const std::string& token);
+double ParseSlope(const std::string& token, size_t extent);
+
+} // namespace geometry_detail
+
+} // namespace fluid_dynamics
+
+#include "geometry.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GEOMETRY_H_
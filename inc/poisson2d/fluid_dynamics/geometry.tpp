@@ -0,0 +1,304 @@
+// File: inc/poisson2d/fluid_dynamics/geometry.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+std::function<T(size_t, size_t)> ConstantValue(T value) {
+  return [value](size_t, size_t) { return value; };
+}
+
+// value at the anchor cell, changing by row_slope per row and col_slope per column.
+template<typename T>
+std::function<T(size_t, size_t)> LinearValue(T value, T row_slope, T col_slope, Cell anchor) {
+  return [value, row_slope, col_slope, anchor](size_t i, size_t j) {
+    return value + row_slope * (static_cast<T>(i) - static_cast<T>(anchor.first))
+           + col_slope * (static_cast<T>(j) - static_cast<T>(anchor.second));
+  };
+}
+
+// Axis aligned segments are a box one cell wide, others are rasterized like a polyline.
+template<typename T>
+Boundary<T> SegmentBoundary(Cell from, Cell to, std::function<T(size_t, size_t)> value) {
+  if (from.first != to.first && from.second != to.second) {
+    return PolylineBoundary<T>({from, to}, std::move(value));
+  }
+
+  return geometry_detail::BoxBoundary<T>({std::min(from.first, to.first), std::max(from.first, to.first) + 1,
+                                          std::min(from.second, to.second), std::max(from.second, to.second) + 1},
+                                         std::move(value));
+}
+
+template<typename T>
+Boundary<T> RectangleBoundary(Cell corner, Cell opposite, std::function<T(size_t, size_t)> value, bool filled) {
+  if (!filled) {
+    return PolylineBoundary<T>({corner, {corner.first, opposite.second}, opposite, {opposite.first, corner.second},
+                                corner}, std::move(value));
+  }
+
+  return geometry_detail::BoxBoundary<T>({std::min(corner.first, opposite.first),
+                                          std::max(corner.first, opposite.first) + 1,
+                                          std::min(corner.second, opposite.second),
+                                          std::max(corner.second, opposite.second) + 1},
+                                         std::move(value));
+}
+
+template<typename T>
+Boundary<T> PolylineBoundary(const std::vector<Cell>& points, std::function<T(size_t, size_t)> value) {
+  std::vector<Cell> cells;
+
+  if (points.empty()) {
+    throw std::invalid_argument("A polyline needs at least one point");
+  }
+  cells.push_back(points.front());
+  for (size_t k = 1; k < points.size(); ++k) {
+    geometry_detail::Rasterize(points[k - 1], points[k], cells);
+  }
+
+  return geometry_detail::CellListBoundary<T>(std::move(cells), std::move(value));
+}
+
+template<typename T>
+Bound<T> ReadGeometry(const std::string& filename, size_t rows, size_t cols) {
+  std::ifstream file{filename};
+
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  return ReadGeometry<T>(file, rows, cols);
+}
+
+// One primitive per line, points are given as row and column:
+//   type dirichlet|periodic
+//   segment <row> <col> <row> <col> <value>
+//   rectangle <row> <col> <row> <col> [filled|outline] <value>
+//   polyline <row> <col> <row> <col> ... <value>
+// with <value> either "constant <v>" or "linear <v> <row slope> <col slope> [<row> <col>]", the
+// linear value is anchored at the first point unless given. Everything after # is a comment.
+template<typename T>
+Bound<T> ReadGeometry(std::istream& in, size_t rows, size_t cols) {
+  Bound<T> bound;
+  std::string line;
+  size_t line_number = 0;
+
+  while (std::getline(in, line)) {
+    std::istringstream stream{line.substr(0, line.find('#'))};
+    std::vector<std::string> words;
+    std::string word;
+    size_t next = 1;
+
+    ++line_number;
+    while (stream >> word) {
+      words.push_back(word);
+    }
+    if (words.empty()) {
+      continue;
+    }
+
+    auto take = [&words, &next]() -> const std::string& {
+      if (next >= words.size()) {
+        throw std::invalid_argument("unexpected end of line");
+      }
+      return words[next++];
+    };
+    auto take_cell = [&take, rows, cols]() -> Cell {
+      size_t row = geometry_detail::ParseCoordinate(take(), rows);
+      return {row, geometry_detail::ParseCoordinate(take(), cols)};
+    };
+    auto take_value = [&](Cell first) -> std::function<T(size_t, size_t)> {
+      const std::string& kind = take();
+      auto value = static_cast<T>(geometry_detail::ParseNumber(take()));
+      if (kind == "constant") {
+        return ConstantValue<T>(value);
+      } else if (kind != "linear") {
+        throw std::invalid_argument("unknown value " + kind);
+      }
+      auto row_slope = static_cast<T>(geometry_detail::ParseSlope(take(), rows));
+      auto col_slope = static_cast<T>(geometry_detail::ParseSlope(take(), cols));
+      Cell anchor = next < words.size() ? take_cell() : first;
+      return LinearValue<T>(value, row_slope, col_slope, anchor);
+    };
+
+    try {
+      if (words[0] == "type") {
+        const std::string& type = take();
+        if (type != "dirichlet" && type != "periodic") {
+          throw std::invalid_argument("unknown boundary type " + type);
+        }
+        bound.type(type == "periodic" ? BoundaryType::kPeriodic : BoundaryType::kDirichlet);
+      } else if (words[0] == "segment") {
+        Cell from = take_cell();
+        Cell to = take_cell();
+        bound.AddBoundary(SegmentBoundary<T>(from, to, take_value(from)));
+      } else if (words[0] == "rectangle") {
+        Cell corner = take_cell();
+        Cell opposite = take_cell();
+        bool filled = true;
+        if (next < words.size() && (words[next] == "filled" || words[next] == "outline")) {
+          filled = take() == "filled";
+        }
+        bound.AddBoundary(RectangleBoundary<T>(corner, opposite, take_value(corner), filled));
+      } else if (words[0] == "polyline") {
+        std::vector<Cell> points;
+        while (next < words.size() && words[next] != "constant" && words[next] != "linear") {
+          points.push_back(take_cell());
+        }
+        if (points.empty()) {
+          throw std::invalid_argument("a polyline needs at least one point");
+        }
+        bound.AddBoundary(PolylineBoundary<T>(points, take_value(points.front())));
+      } else {
+        throw std::invalid_argument("unknown primitive " + words[0]);
+      }
+      if (next != words.size()) {
+        throw std::invalid_argument("unexpected " + words[next]);
+      }
+    } catch (const std::invalid_argument& error) {
+      throw std::runtime_error("Geometry line " + std::to_string(line_number) + ": " + error.what());
+    }
+  }
+
+  return bound;
+}
+
+namespace geometry_detail {
+
+template<typename T>
+Boundary<T> BoxBoundary(const CellBox& box, std::function<T(size_t, size_t)> value) {
+  return {[box](size_t i, size_t j) { return box.Contains(i, j); }, std::move(value), box,
+          [box](const CellBox& clip, const std::function<void(size_t, size_t)>& visit) {
+            CellBox covered = box.Intersect(clip);
+            for (size_t i = covered.row_begin; i < covered.row_end; ++i) {
+              for (size_t j = covered.col_begin; j < covered.col_end; ++j) {
+                visit(i, j);
+              }
+            }
+          }};
+}
+
+// The cells are kept sorted, so the cells within a clip box are found by binary search on its
+// first row.
+template<typename T>
+Boundary<T> CellListBoundary(std::vector<Cell> cells, std::function<T(size_t, size_t)> value) {
+  CellBox box{cells.front().first, cells.front().first + 1, cells.front().second, cells.front().second + 1};
+
+  std::sort(cells.begin(), cells.end());
+  cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+  for (const Cell& cell : cells) {
+    box.row_begin = std::min(box.row_begin, cell.first);
+    box.row_end = std::max(box.row_end, cell.first + 1);
+    box.col_begin = std::min(box.col_begin, cell.second);
+    box.col_end = std::max(box.col_end, cell.second + 1);
+  }
+  auto list = std::make_shared<const std::vector<Cell>>(std::move(cells));
+
+  return {[list, box](size_t i, size_t j) {
+            return box.Contains(i, j) && std::binary_search(list->begin(), list->end(), Cell{i, j});
+          },
+          std::move(value), box,
+          [list](const CellBox& clip, const std::function<void(size_t, size_t)>& visit) {
+            auto it = std::lower_bound(list->begin(), list->end(), Cell{clip.row_begin, 0});
+            for (; it != list->end() && it->first < clip.row_end; ++it) {
+              if (clip.Contains(it->first, it->second)) {
+                visit(it->first, it->second);
+              }
+            }
+          }};
+}
+
+// Appends the cells after from up to and including to. Diagonal steps are split into a column and
+// a row step, so the cells are edge connected and a slanted wall has no gaps.
+inline void Rasterize(Cell from, Cell to, std::vector<Cell>& cells) {
+  auto row = static_cast<long long>(from.first);
+  auto col = static_cast<long long>(from.second);
+  auto row_end = static_cast<long long>(to.first);
+  auto col_end = static_cast<long long>(to.second);
+  long long d_col = std::llabs(col_end - col);
+  long long d_row = -std::llabs(row_end - row);
+  long long step_row = row < row_end ? 1 : -1;
+  long long step_col = col < col_end ? 1 : -1;
+  long long error = d_col + d_row;
+
+  while (row != row_end || col != col_end) {
+    long long twice = 2 * error;
+    if (twice >= d_row) {
+      error += d_row;
+      col += step_col;
+      if (twice <= d_col) {
+        cells.emplace_back(static_cast<size_t>(row), static_cast<size_t>(col));
+      }
+    }
+    if (twice <= d_col) {
+      error += d_col;
+      row += step_row;
+    }
+    cells.emplace_back(static_cast<size_t>(row), static_cast<size_t>(col));
+  }
+}
+
+// Either a non-negative integer or [a]L[/b][+c|-c], which is a * extent / b rounded down, shifted
+// by c.
+inline size_t ParseCoordinate(const std::string& token, size_t extent) {
+  auto parse = [&token](size_t begin, size_t end) -> size_t {
+    if (begin >= end || token.find_first_not_of("0123456789", begin) < end) {
+      throw std::invalid_argument("invalid coordinate " + token);
+    }
+    return std::stoull(token.substr(begin, end - begin));
+  };
+  size_t symbol = token.find('L');
+
+  if (symbol == std::string::npos) {
+    return parse(0, token.size());
+  }
+
+  size_t multiple = symbol == 0 ? 1 : parse(0, symbol);
+  size_t shift_at = std::min(token.find_first_of("+-", symbol), token.size());
+  size_t divisor = 1;
+  if (symbol + 1 < shift_at) {
+    if (token[symbol + 1] != '/') {
+      throw std::invalid_argument("invalid coordinate " + token);
+    }
+    divisor = parse(symbol + 2, shift_at);
+    if (divisor == 0) {
+      throw std::invalid_argument("division by zero in " + token);
+    }
+  }
+  size_t coordinate = multiple * extent / divisor;
+  if (shift_at < token.size()) {
+    size_t shift = parse(shift_at + 1, token.size());
+    if (token[shift_at] == '-' && shift > coordinate) {
+      throw std::invalid_argument("coordinate " + token + " lies before the first cell");
+    }
+    coordinate = token[shift_at] == '-' ? coordinate - shift : coordinate + shift;
+  }
+
+  return coordinate;
+}
+
+inline double ParseNumber(const std::string& token) {
+  size_t parsed = 0;
+  double value = 0;
+
+  try {
+    value = std::stod(token, &parsed);
+  } catch (const std::exception&) {
+    parsed = 0;
+  }
+  if (parsed == 0 || parsed != token.size()) {
+    throw std::invalid_argument("invalid number " + token);
+  }
+
+  return value;
+}
+
+// A number, or a number followed by /L, which divides it by the extent.
+inline double ParseSlope(const std::string& token, size_t extent) {
+  if (token.size() > 2 && token.compare(token.size() - 2, 2, "/L") == 0) {
+    return ParseNumber(token.substr(0, token.size() - 2)) / static_cast<double>(extent);
+  }
+
+  return ParseNumber(token);
+}
+
+} // namespace geometry_detail
+
+} // namespace fluid_dynamics
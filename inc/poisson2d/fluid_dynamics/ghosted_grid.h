@@ -0,0 +1,56 @@
+// File: inc/poisson2d/fluid_dynamics/ghosted_grid.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GHOSTED_GRID_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GHOSTED_GRID_H_
+
+#include <algorithm>
+#include <stdexcept>
+#include "grid.h"
+
+namespace fluid_dynamics {
+
+// A rows x cols grid stored inside a frame of ghost cells that is allocated once, so halos never
+// have to be added or removed by copying. Indices are interior indices, ghost cells are reached
+// with negative offsets from data() or through the padded storage.
+template<typename T>
+class GhostedGrid {
+ public:
+  GhostedGrid();
+  GhostedGrid(const GhostedGrid&) = default;
+  GhostedGrid(GhostedGrid&&) noexcept = default;
+  GhostedGrid(size_t rows, size_t cols, size_t ghost);
+  GhostedGrid(size_t rows, size_t cols, size_t ghost, std::pmr::memory_resource* resource);
+  GhostedGrid(const Grid<T>& interior, size_t ghost);
+  GhostedGrid(const Grid<T>& interior, size_t ghost, std::pmr::memory_resource* resource);
+  ~GhostedGrid() = default;
+
+  GhostedGrid& operator=(const GhostedGrid&) = default;
+  GhostedGrid& operator=(GhostedGrid&&) noexcept = default;
+
+  [[nodiscard]] size_t rows() const;
+  [[nodiscard]] size_t cols() const;
+  [[nodiscard]] size_t ghost() const;
+  [[nodiscard]] size_t stride() const;
+  [[nodiscard]] Grid<T>& padded();
+  [[nodiscard]] const Grid<T>& padded() const;
+  [[nodiscard]] T* data(size_t i, size_t j);
+  [[nodiscard]] const T* data(size_t i, size_t j) const;
+
+  T& operator()(size_t i, size_t j);
+  const T& operator()(size_t i, size_t j) const;
+
+  void Assign(const Grid<T>& interior);
+  void FillGhosts(T value);
+  [[nodiscard]] Grid<T> Interior() const;
+
+ private:
+  Grid<T> storage_;
+  size_t rows_;
+  size_t cols_;
+  size_t ghost_;
+}; // class GhostedGrid
+
+} // namespace fluid_dynamics
+
+#include "ghosted_grid.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GHOSTED_GRID_H_
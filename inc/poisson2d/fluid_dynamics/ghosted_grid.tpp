@@ -0,0 +1,113 @@
+// File: inc/poisson2d/fluid_dynamics/ghosted_grid.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+GhostedGrid<T>::GhostedGrid() : storage_{}, rows_{0}, cols_{0}, ghost_{0} {}
+
+template<typename T>
+GhostedGrid<T>::GhostedGrid(size_t rows, size_t cols, size_t ghost)
+    : storage_{rows + 2 * ghost, cols + 2 * ghost}, rows_{rows}, cols_{cols}, ghost_{ghost} {}
+
+template<typename T>
+GhostedGrid<T>::GhostedGrid(size_t rows, size_t cols, size_t ghost, std::pmr::memory_resource* resource)
+    : storage_{rows + 2 * ghost, cols + 2 * ghost, resource}, rows_{rows}, cols_{cols}, ghost_{ghost} {}
+
+template<typename T>
+GhostedGrid<T>::GhostedGrid(const Grid<T>& interior, size_t ghost)
+    : GhostedGrid(interior.rows(), interior.cols(), ghost) {
+  Assign(interior);
+}
+
+template<typename T>
+GhostedGrid<T>::GhostedGrid(const Grid<T>& interior, size_t ghost, std::pmr::memory_resource* resource)
+    : GhostedGrid(interior.rows(), interior.cols(), ghost, resource) {
+  Assign(interior);
+}
+
+template<typename T>
+size_t GhostedGrid<T>::rows() const {
+  return rows_;
+}
+
+template<typename T>
+size_t GhostedGrid<T>::cols() const {
+  return cols_;
+}
+
+template<typename T>
+size_t GhostedGrid<T>::ghost() const {
+  return ghost_;
+}
+
+template<typename T>
+size_t GhostedGrid<T>::stride() const {
+  return cols_ + 2 * ghost_;
+}
+
+template<typename T>
+Grid<T>& GhostedGrid<T>::padded() {
+  return storage_;
+}
+
+template<typename T>
+const Grid<T>& GhostedGrid<T>::padded() const {
+  return storage_;
+}
+
+template<typename T>
+T* GhostedGrid<T>::data(size_t i, size_t j) {
+  return &storage_(i + ghost_, j + ghost_);
+}
+
+template<typename T>
+const T* GhostedGrid<T>::data(size_t i, size_t j) const {
+  return &storage_(i + ghost_, j + ghost_);
+}
+
+template<typename T>
+T& GhostedGrid<T>::operator()(size_t i, size_t j) {
+  return storage_(i + ghost_, j + ghost_);
+}
+
+template<typename T>
+const T& GhostedGrid<T>::operator()(size_t i, size_t j) const {
+  return storage_(i + ghost_, j + ghost_);
+}
+
+// Copies interior row by row, the ghost cells keep their values.
+template<typename T>
+void GhostedGrid<T>::Assign(const Grid<T>& interior) {
+  if (interior.rows() != rows_ || interior.cols() != cols_) {
+    throw std::invalid_argument("Grid dimensions do not match the interior of the ghosted grid");
+  }
+
+  for (size_t i = 0; i < rows_; ++i) {
+    std::copy(&interior(i, 0), &interior(i, 0) + cols_, data(i, 0));
+  }
+}
+
+template<typename T>
+void GhostedGrid<T>::FillGhosts(T value) {
+  for (size_t i = 0; i < storage_.rows(); ++i) {
+    bool ghost_row = i < ghost_ || i >= ghost_ + rows_;
+    for (size_t j = 0; j < storage_.cols(); ++j) {
+      if (ghost_row || j < ghost_ || j >= ghost_ + cols_) {
+        storage_(i, j) = value;
+      }
+    }
+  }
+}
+
+// Allocated from the resource of the storage.
+template<typename T>
+Grid<T> GhostedGrid<T>::Interior() const {
+  Grid<T> interior{rows_, cols_, storage_.resource()};
+
+  for (size_t i = 0; i < rows_; ++i) {
+    std::copy(data(i, 0), data(i, 0) + cols_, &interior(i, 0));
+  }
+
+  return interior;
+}
+
+} // namespace fluid_dynamics
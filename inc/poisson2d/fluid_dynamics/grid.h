@@ -2,6 +2,8 @@
 #ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_GRID_H_
 #define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_GRID_H_
 
+#include <cstddef>
+#include <memory_resource>
 #include <utility>
 #include <vector>
 #include <functional>
@@ -20,6 +22,9 @@ class Grid {
   Grid(size_t rows, size_t cols);
   Grid(size_t rows, size_t cols, const std::vector<T>& data);
   Grid(size_t rows, size_t cols, std::vector<T>&& data);
+  Grid(size_t rows, size_t cols, std::pmr::memory_resource* resource);
+  Grid(const Grid& other, std::pmr::memory_resource* resource);
+  template<typename U> explicit Grid(const Grid<U>& other);
   ~Grid() = default;
 
   Grid& operator=(const Grid&) = default;
@@ -30,6 +35,7 @@ class Grid {
 
   [[nodiscard]] size_t rows() const;
   [[nodiscard]] size_t cols() const;
+  [[nodiscard]] std::pmr::memory_resource* resource() const;
 
   T& operator()(size_t i, size_t j);
   const T& operator()(size_t i, size_t j) const;
@@ -43,7 +49,7 @@ class Grid {
   void Fill(std::function<T(size_t, size_t)> value_func);
 
  private:
-  std::vector<T> data_;
+  std::pmr::vector<T> data_;
   size_t rows_;
   size_t cols_;
 }; // class Grid
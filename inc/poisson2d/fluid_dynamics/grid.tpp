@@ -9,11 +9,14 @@ Grid<T>::Grid(size_t dim) : data_(dim * dim), rows_{dim}, cols_{dim} {}
 
 template<typename T>
 Grid<T>::Grid(size_t dim, const std::vector<T>& data)
-    : data_{data}, rows_{dim}, cols_{dim} {}
+    : data_(data.begin(), data.end()), rows_{dim}, cols_{dim} {}
 
+// The storage is polymorphic, so the elements are moved out of data, which is left empty.
 template<typename T>
 Grid<T>::Grid(size_t dim, std::vector<T>&& data)
-    : data_{std::move(data)}, rows_{dim}, cols_{dim} {}
+    : data_(std::make_move_iterator(data.begin()), std::make_move_iterator(data.end())), rows_{dim}, cols_{dim} {
+  std::vector<T>{}.swap(data);
+}
 
 template<typename T>
 Grid<T>::Grid(size_t rows, size_t cols)
@@ -21,11 +24,34 @@ Grid<T>::Grid(size_t rows, size_t cols)
 
 template<typename T>
 Grid<T>::Grid(size_t rows, size_t cols, const std::vector<T>& data)
-    : data_{data}, rows_{rows}, cols_{cols} {}
+    : data_(data.begin(), data.end()), rows_{rows}, cols_{cols} {}
 
 template<typename T>
 Grid<T>::Grid(size_t rows, size_t cols, std::vector<T>&& data)
-    : data_{std::move(data)}, rows_{rows}, cols_{cols} {}
+    : data_(std::make_move_iterator(data.begin()), std::make_move_iterator(data.end())), rows_{rows}, cols_{cols} {
+  std::vector<T>{}.swap(data);
+}
+
+// Storage comes from resource, e.g. a GridPool, and is given back to it when the grid is freed.
+// Copies of the grid allocate from the default resource, moves keep the buffer.
+template<typename T>
+Grid<T>::Grid(size_t rows, size_t cols, std::pmr::memory_resource* resource)
+    : data_(rows * cols, resource), rows_{rows}, cols_{cols} {}
+
+template<typename T>
+Grid<T>::Grid(const Grid& other, std::pmr::memory_resource* resource)
+    : data_(other.data_, resource), rows_{other.rows_}, cols_{other.cols_} {}
+
+// Converts every value with static_cast, e.g. between precisions.
+template<typename T>
+template<typename U>
+Grid<T>::Grid(const Grid<U>& other) : data_(other.rows() * other.cols()), rows_{other.rows()}, cols_{other.cols()} {
+  for (size_t i = 0; i < rows_; ++i) {
+    for (size_t j = 0; j < cols_; ++j) {
+      data_[i * cols_ + j] = static_cast<T>(other(i, j));
+    }
+  }
+}
 
 template<typename T>
 T* Grid<T>::data() {
@@ -47,6 +73,11 @@ size_t Grid<T>::cols() const {
   return cols_;
 }
 
+template<typename T>
+std::pmr::memory_resource* Grid<T>::resource() const {
+  return data_.get_allocator().resource();
+}
+
 template<typename T>
 T& Grid<T>::operator()(size_t i, size_t j) {
   return data_[i * cols_ + j];
@@ -59,15 +90,17 @@ const T& Grid<T>::operator()(size_t i, size_t j) const {
 
 template<typename T>
 void Grid<T>::Resize(size_t rows, size_t cols, std::pair<int, int> offset) {
-  std::vector<T> new_data(rows * cols);
+  std::pmr::vector<T> new_data(rows * cols, data_.get_allocator());
 
   for (size_t i = 0; i < rows; ++i) {
     for (size_t j = 0; j < cols; ++j) {
-      if (static_cast<int>(i) < offset.first || static_cast<int>(i) >= offset.first + rows_
-          || static_cast<int>(j) < offset.second || static_cast<int>(j) >= offset.second + cols_) {
+      auto old_i = static_cast<std::ptrdiff_t>(i) - offset.first;
+      auto old_j = static_cast<std::ptrdiff_t>(j) - offset.second;
+      if (old_i < 0 || old_i >= static_cast<std::ptrdiff_t>(rows_) || old_j < 0
+          || old_j >= static_cast<std::ptrdiff_t>(cols_)) {
         new_data[i * cols + j] = T{};
       } else {
-        new_data[i * cols + j] = data_[(i - offset.first) * cols_ + j - offset.second];
+        new_data[i * cols + j] = data_[static_cast<size_t>(old_i) * cols_ + static_cast<size_t>(old_j)];
       }
     }
   }
@@ -88,12 +121,13 @@ void Grid<T>::Fill(T value) {
 
 template<typename T>
 void Grid<T>::Fill(const std::vector<T>& values) {
-  data_ = values;
+  data_.assign(values.begin(), values.end());
 }
 
 template<typename T>
 void Grid<T>::Fill(std::vector<T>&& values) {
-  data_ = std::move(values);
+  data_.assign(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+  std::vector<T>{}.swap(values);
 }
 
 template<typename T>
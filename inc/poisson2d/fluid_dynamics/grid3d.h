@@ -0,0 +1,58 @@
+// File: inc/poisson2d/fluid_dynamics/grid3d.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GRID3D_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GRID3D_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace fluid_dynamics {
+
+// Row-major 3D grid, k is the contiguous index.
+template<typename T>
+class Grid3D {
+ public:
+  Grid3D();
+  Grid3D(const Grid3D&) = default;
+  Grid3D(Grid3D&&) noexcept = default;
+  explicit Grid3D(size_t dim);
+  Grid3D(size_t nx, size_t ny, size_t nz);
+  Grid3D(size_t nx, size_t ny, size_t nz, const std::vector<T>& data);
+  Grid3D(size_t nx, size_t ny, size_t nz, std::vector<T>&& data);
+  ~Grid3D() = default;
+
+  Grid3D& operator=(const Grid3D&) = default;
+  Grid3D& operator=(Grid3D&&) noexcept = default;
+
+  [[nodiscard]] T* data();
+  [[nodiscard]] const T* data() const;
+  [[nodiscard]] T* data(size_t i, size_t j, size_t k);
+
+  [[nodiscard]] size_t nx() const;
+  [[nodiscard]] size_t ny() const;
+  [[nodiscard]] size_t nz() const;
+  [[nodiscard]] size_t size() const;
+
+  T& operator()(size_t i, size_t j, size_t k);
+  const T& operator()(size_t i, size_t j, size_t k) const;
+
+  void Resize(size_t nx, size_t ny, size_t nz, std::array<int, 3> offset);
+  void Resize(size_t nx, size_t ny, size_t nz);
+
+  void Fill(T value);
+  void Fill(std::function<T(size_t, size_t, size_t)> value_func);
+
+ private:
+  std::vector<T> data_;
+  size_t nx_;
+  size_t ny_;
+  size_t nz_;
+}; // class Grid3D
+
+} // namespace fluid_dynamics
+
+#include "grid3d.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GRID3D_H_
@@ -0,0 +1,120 @@
+// File: inc/poisson2d/fluid_dynamics/grid3d.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+Grid3D<T>::Grid3D() : data_{}, nx_{0}, ny_{0}, nz_{0} {}
+
+template<typename T>
+Grid3D<T>::Grid3D(size_t dim) : data_(dim * dim * dim), nx_{dim}, ny_{dim}, nz_{dim} {}
+
+template<typename T>
+Grid3D<T>::Grid3D(size_t nx, size_t ny, size_t nz)
+    : data_(nx * ny * nz), nx_{nx}, ny_{ny}, nz_{nz} {}
+
+template<typename T>
+Grid3D<T>::Grid3D(size_t nx, size_t ny, size_t nz, const std::vector<T>& data)
+    : data_{data}, nx_{nx}, ny_{ny}, nz_{nz} {}
+
+template<typename T>
+Grid3D<T>::Grid3D(size_t nx, size_t ny, size_t nz, std::vector<T>&& data)
+    : data_{std::move(data)}, nx_{nx}, ny_{ny}, nz_{nz} {}
+
+template<typename T>
+T* Grid3D<T>::data() {
+  return data_.data();
+}
+
+template<typename T>
+const T* Grid3D<T>::data() const {
+  return data_.data();
+}
+
+template<typename T>
+T* Grid3D<T>::data(size_t i, size_t j, size_t k) {
+  return data_.data() + (i * ny_ + j) * nz_ + k;
+}
+
+template<typename T>
+size_t Grid3D<T>::nx() const {
+  return nx_;
+}
+
+template<typename T>
+size_t Grid3D<T>::ny() const {
+  return ny_;
+}
+
+template<typename T>
+size_t Grid3D<T>::nz() const {
+  return nz_;
+}
+
+template<typename T>
+size_t Grid3D<T>::size() const {
+  return data_.size();
+}
+
+template<typename T>
+T& Grid3D<T>::operator()(size_t i, size_t j, size_t k) {
+  return data_[(i * ny_ + j) * nz_ + k];
+}
+
+template<typename T>
+const T& Grid3D<T>::operator()(size_t i, size_t j, size_t k) const {
+  return data_[(i * ny_ + j) * nz_ + k];
+}
+
+// Cells of the new grid that the shifted old grid does not cover are value initialized.
+template<typename T>
+void Grid3D<T>::Resize(size_t nx, size_t ny, size_t nz, std::array<int, 3> offset) {
+  std::vector<T> new_data(nx * ny * nz);
+  std::ptrdiff_t old_dims[3] = {static_cast<std::ptrdiff_t>(nx_), static_cast<std::ptrdiff_t>(ny_),
+                                static_cast<std::ptrdiff_t>(nz_)};
+
+  for (size_t i = 0; i < nx; ++i) {
+    std::ptrdiff_t oi = static_cast<std::ptrdiff_t>(i) - offset[0];
+    if (oi < 0 || oi >= old_dims[0]) {
+      continue;
+    }
+    for (size_t j = 0; j < ny; ++j) {
+      std::ptrdiff_t oj = static_cast<std::ptrdiff_t>(j) - offset[1];
+      if (oj < 0 || oj >= old_dims[1]) {
+        continue;
+      }
+      for (size_t k = 0; k < nz; ++k) {
+        std::ptrdiff_t ok = static_cast<std::ptrdiff_t>(k) - offset[2];
+        if (ok >= 0 && ok < old_dims[2]) {
+          new_data[(i * ny + j) * nz + k] = data_[(static_cast<size_t>(oi) * ny_ + static_cast<size_t>(oj)) * nz_
+                                                  + static_cast<size_t>(ok)];
+        }
+      }
+    }
+  }
+  data_ = std::move(new_data);
+  nx_ = nx;
+  ny_ = ny;
+  nz_ = nz;
+}
+
+template<typename T>
+void Grid3D<T>::Resize(size_t nx, size_t ny, size_t nz) {
+  Resize(nx, ny, nz, {0, 0, 0});
+}
+
+template<typename T>
+void Grid3D<T>::Fill(T value) {
+  std::fill(data_.begin(), data_.end(), value);
+}
+
+template<typename T>
+void Grid3D<T>::Fill(std::function<T(size_t, size_t, size_t)> value_func) {
+  for (size_t i = 0; i < nx_; ++i) {
+    for (size_t j = 0; j < ny_; ++j) {
+      for (size_t k = 0; k < nz_; ++k) {
+        data_[(i * ny_ + j) * nz_ + k] = value_func(i, j, k);
+      }
+    }
+  }
+}
+
+} // namespace fluid_dynamics
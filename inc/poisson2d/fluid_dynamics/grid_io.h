@@ -2,17 +2,42 @@
 #ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GRID_IO_H_
 #define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GRID_IO_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include "grid.h"
+#include "grid3d.h"
 
 namespace fluid_dynamics {
 
+// Pyramid files start with kPyramidMagic, the level count and the size of one cell in bytes,
+// followed by one PyramidLevel entry per level. Level 0 is the full resolution grid, every
+// further level averages 2x2 blocks of the previous one. Level data is page aligned.
+inline constexpr char kPyramidMagic[8] = {'F', 'D', 'S', 'P', 'Y', 'R', '0', '1'};
+inline constexpr uint64_t kPyramidAlignment = 4096;
+
+struct PyramidLevel {
+  uint64_t rows;
+  uint64_t cols;
+  uint64_t offset;
+}; // struct PyramidLevel
+
 template<typename T> void WriteGridBinary(const Grid<T>& grid, const std::string& filename);
 template<typename T> void WriteGridBinary(const Grid<std::pair<T, T>>& grid, const std::string& filename);
+template<typename T> void WriteGridBinary(const Grid3D<T>& grid, const std::string& filename);
+template<typename T> void WriteGridBinary(const Grid3D<std::array<T, 3>>& grid, const std::string& filename);
 template<typename T> void WriteGridText(const Grid<T>& grid, const std::string& filename);
 template<typename T> void WriteGridText(const Grid<std::pair<T, T>>& grid, const std::string& filename);
 
+template<typename T> Grid<T> Downsample(const Grid<T>& grid, size_t factor);
+template<typename T> Grid<std::pair<T, T>> Downsample(const Grid<std::pair<T, T>>& grid, size_t factor);
+template<typename T> void WriteGridPyramid(const Grid<T>& grid, const std::string& filename, size_t levels);
+inline std::vector<PyramidLevel> ReadPyramidLevels(const std::string& filename, uint64_t value_size);
+
 } // namespace fluid_dynamics
 
 #include "grid_io.tpp"
@@ -34,6 +34,32 @@ void WriteGridBinary(const Grid<std::pair<T, T>>& grid, const std::string& filen
   file.close();
 }
 
+template<typename T>
+void WriteGridBinary(const Grid3D<T>& grid, const std::string& filename) {
+  std::ofstream file(filename, std::ios::binary);
+
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  file.write(reinterpret_cast<const char*>(grid.data()), static_cast<std::streamsize>(grid.size() * sizeof(T)));
+  file.close();
+}
+
+template<typename T>
+void WriteGridBinary(const Grid3D<std::array<T, 3>>& grid, const std::string& filename) {
+  std::ofstream file(filename, std::ios::binary);
+
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  for (size_t i = 0; i < grid.size(); ++i) {
+    file.write(reinterpret_cast<const char*>(grid.data()[i].data()), 3 * sizeof(T));
+  }
+  file.close();
+}
+
 template<typename T>
 void WriteGridText(const Grid<T>& grid, const std::string& filename) {
   std::ofstream file(filename);
@@ -66,4 +92,119 @@ void WriteGridText(const Grid<std::pair<T, T>>& grid, const std::string& filenam
   file.close();
 }
 
+template<typename T>
+Grid<T> Downsample(const Grid<T>& grid, size_t factor) {
+  Grid<T> coarse{(grid.rows() + factor - 1) / factor, (grid.cols() + factor - 1) / factor};
+
+  for (size_t i = 0; i < coarse.rows(); ++i) {
+    for (size_t j = 0; j < coarse.cols(); ++j) {
+      size_t end_row = std::min((i + 1) * factor, grid.rows());
+      size_t end_col = std::min((j + 1) * factor, grid.cols());
+      T sum{};
+      for (size_t k = i * factor; k < end_row; ++k) {
+        for (size_t l = j * factor; l < end_col; ++l) {
+          sum += grid(k, l);
+        }
+      }
+      coarse(i, j) = sum / static_cast<T>((end_row - i * factor) * (end_col - j * factor));
+    }
+  }
+
+  return coarse;
+}
+
+template<typename T>
+Grid<std::pair<T, T>> Downsample(const Grid<std::pair<T, T>>& grid, size_t factor) {
+  Grid<std::pair<T, T>> coarse{(grid.rows() + factor - 1) / factor, (grid.cols() + factor - 1) / factor};
+
+  for (size_t i = 0; i < coarse.rows(); ++i) {
+    for (size_t j = 0; j < coarse.cols(); ++j) {
+      size_t end_row = std::min((i + 1) * factor, grid.rows());
+      size_t end_col = std::min((j + 1) * factor, grid.cols());
+      auto count = static_cast<T>((end_row - i * factor) * (end_col - j * factor));
+      T first{}, second{};
+      for (size_t k = i * factor; k < end_row; ++k) {
+        for (size_t l = j * factor; l < end_col; ++l) {
+          first += grid(k, l).first;
+          second += grid(k, l).second;
+        }
+      }
+      coarse(i, j) = {first / count, second / count};
+    }
+  }
+
+  return coarse;
+}
+
+template<typename T>
+void WriteGridPyramid(const Grid<T>& grid, const std::string& filename, size_t levels) {
+  std::ofstream file(filename, std::ios::binary);
+  std::vector<Grid<T>> pyramid;
+  std::vector<PyramidLevel> index(levels);
+  uint64_t num_levels = levels;
+  uint64_t value_size = sizeof(T);
+  uint64_t offset = sizeof(kPyramidMagic) + 2 * sizeof(uint64_t) + levels * sizeof(PyramidLevel);
+
+  if (levels == 0) {
+    throw std::invalid_argument("Pyramid needs at least one level");
+  }
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  pyramid.reserve(levels - 1);
+  for (size_t level = 0; level < levels; ++level) {
+    if (level > 0) {
+      pyramid.push_back(Downsample(level == 1 ? grid : pyramid.back(), 2));
+    }
+    const Grid<T>& curr = (level == 0) ? grid : pyramid.back();
+    offset = (offset + kPyramidAlignment - 1) / kPyramidAlignment * kPyramidAlignment;
+    index[level] = {curr.rows(), curr.cols(), offset};
+    offset += curr.rows() * curr.cols() * sizeof(T);
+  }
+
+  file.write(kPyramidMagic, sizeof(kPyramidMagic));
+  file.write(reinterpret_cast<const char*>(&num_levels), sizeof(num_levels));
+  file.write(reinterpret_cast<const char*>(&value_size), sizeof(value_size));
+  file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(levels * sizeof(PyramidLevel)));
+
+  for (size_t level = 0; level < levels; ++level) {
+    const Grid<T>& curr = (level == 0) ? grid : pyramid[level - 1];
+    file.seekp(static_cast<std::streamoff>(index[level].offset));
+    for (size_t i = 0; i < curr.rows(); ++i) {
+      file.write(reinterpret_cast<const char*>(&curr(i, 0)), static_cast<std::streamsize>(curr.cols() * sizeof(T)));
+    }
+  }
+  file.close();
+}
+
+inline std::vector<PyramidLevel> ReadPyramidLevels(const std::string& filename, uint64_t value_size) {
+  std::ifstream file(filename, std::ios::binary);
+  char magic[sizeof(kPyramidMagic)];
+  uint64_t num_levels = 0;
+  uint64_t file_value_size = 0;
+
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char*>(&num_levels), sizeof(num_levels));
+  file.read(reinterpret_cast<char*>(&file_value_size), sizeof(file_value_size));
+  if (!file || std::memcmp(magic, kPyramidMagic, sizeof(magic)) != 0) {
+    throw std::runtime_error("Not a grid pyramid: " + filename);
+  }
+  if (file_value_size != value_size) {
+    throw std::runtime_error("Cell size mismatch in grid pyramid: " + filename);
+  }
+
+  std::vector<PyramidLevel> levels(num_levels);
+  file.read(reinterpret_cast<char*>(levels.data()), static_cast<std::streamsize>(num_levels * sizeof(PyramidLevel)));
+  if (!file) {
+    throw std::runtime_error("Truncated grid pyramid: " + filename);
+  }
+
+  return levels;
+}
+
 } // namespace fluid_dynamics
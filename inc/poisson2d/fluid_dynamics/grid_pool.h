@@ -0,0 +1,69 @@
+// File: inc/poisson2d/fluid_dynamics/grid_pool.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GRID_POOL_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GRID_POOL_H_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace fluid_dynamics {
+
+struct PoolStats {
+  size_t requests;
+  size_t recycled;
+  size_t allocations;
+  size_t allocated_bytes;
+  size_t bytes_in_use;
+  size_t peak_bytes_in_use;
+  size_t cached_bytes;
+}; // struct PoolStats
+
+// Memory resource for grid buffers that keeps freed buffers in size classes, eight per power of two,
+// and hands them out again instead of going to the upstream resource. allocations and
+// allocated_bytes count the upstream allocations, so they stay at zero once the pool has seen every
+// size in use. A pool owned by a shared_ptr keeps itself alive while any of its buffers is, so grids
+// may outlive the solver that made them. Thread safe.
+class GridPool : public std::pmr::memory_resource, public std::enable_shared_from_this<GridPool> {
+ public:
+  GridPool();
+  explicit GridPool(std::pmr::memory_resource* upstream);
+  GridPool(const GridPool&) = delete;
+  GridPool(GridPool&&) noexcept = delete;
+  ~GridPool() override;
+
+  GridPool& operator=(const GridPool&) = delete;
+  GridPool& operator=(GridPool&&) noexcept = delete;
+
+  [[nodiscard]] PoolStats stats() const;
+  [[nodiscard]] std::pmr::memory_resource* upstream() const;
+
+  void ResetStats();
+  void Release();
+
+  [[nodiscard]] static size_t SizeClass(size_t bytes);
+
+  static constexpr size_t kAlignment = 64;
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  std::pmr::memory_resource* upstream_;
+  std::map<size_t, std::vector<void*>> free_;
+  PoolStats stats_;
+  size_t outstanding_;
+  std::shared_ptr<GridPool> self_;
+  mutable std::mutex mutex_;
+}; // class GridPool
+
+} // namespace fluid_dynamics
+
+#include "grid_pool.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_GRID_POOL_H_
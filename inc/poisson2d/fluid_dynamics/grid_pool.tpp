@@ -0,0 +1,108 @@
+// File: inc/poisson2d/fluid_dynamics/grid_pool.tpp
+namespace fluid_dynamics {
+
+inline GridPool::GridPool() : GridPool(std::pmr::new_delete_resource()) {}
+
+inline GridPool::GridPool(std::pmr::memory_resource* upstream)
+    : upstream_{upstream}, stats_{}, outstanding_{0} {}
+
+inline GridPool::~GridPool() {
+  Release();
+}
+
+inline PoolStats GridPool::stats() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return stats_;
+}
+
+inline std::pmr::memory_resource* GridPool::upstream() const {
+  return upstream_;
+}
+
+// Zeroes the counters, the bytes in use and cached are kept and the peak restarts from them.
+inline void GridPool::ResetStats() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  stats_.requests = 0;
+  stats_.recycled = 0;
+  stats_.allocations = 0;
+  stats_.allocated_bytes = 0;
+  stats_.peak_bytes_in_use = stats_.bytes_in_use;
+}
+
+// Returns the cached buffers to the upstream resource, buffers in use are not affected.
+inline void GridPool::Release() {
+  std::lock_guard<std::mutex> lock{mutex_};
+
+  for (auto& [size, buffers] : free_) {
+    for (void* buffer : buffers) {
+      upstream_->deallocate(buffer, size, kAlignment);
+    }
+  }
+  free_.clear();
+  stats_.cached_bytes = 0;
+}
+
+// Multiples of kAlignment up to 512 bytes, above that eight classes per power of two, so a buffer
+// is at most an eighth larger than requested.
+inline size_t GridPool::SizeClass(size_t bytes) {
+  size_t step = bytes > 1 ? std::bit_floor(bytes - 1) / 8 : 0;
+
+  step = step > kAlignment ? step : kAlignment;
+  return bytes == 0 ? step : (bytes + step - 1) / step * step;
+}
+
+inline void* GridPool::do_allocate(size_t bytes, size_t alignment) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  size_t size = SizeClass(bytes);
+  void* buffer;
+
+  ++stats_.requests;
+  if (alignment > kAlignment) {
+    buffer = upstream_->allocate(bytes, alignment);
+    size = bytes;
+    ++stats_.allocations;
+    stats_.allocated_bytes += size;
+  } else if (auto it = free_.find(size); it != free_.end() && !it->second.empty()) {
+    buffer = it->second.back();
+    it->second.pop_back();
+    ++stats_.recycled;
+    stats_.cached_bytes -= size;
+  } else {
+    buffer = upstream_->allocate(size, kAlignment);
+    ++stats_.allocations;
+    stats_.allocated_bytes += size;
+  }
+  stats_.bytes_in_use += size;
+  stats_.peak_bytes_in_use = std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
+  if (outstanding_++ == 0) {
+    self_ = weak_from_this().lock();
+  }
+
+  return buffer;
+}
+
+// The last buffer of a pool owned by a shared_ptr may release the pool, which happens after the
+// lock is gone.
+inline void GridPool::do_deallocate(void* pointer, size_t bytes, size_t alignment) {
+  std::shared_ptr<GridPool> self;
+  std::lock_guard<std::mutex> lock{mutex_};
+  size_t size = SizeClass(bytes);
+
+  if (alignment > kAlignment) {
+    upstream_->deallocate(pointer, bytes, alignment);
+    size = bytes;
+  } else {
+    free_[size].push_back(pointer);
+    stats_.cached_bytes += size;
+  }
+  stats_.bytes_in_use -= size;
+  if (--outstanding_ == 0) {
+    self = std::move(self_);
+  }
+}
+
+inline bool GridPool::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+} // namespace fluid_dynamics
@@ -0,0 +1,60 @@
+// File: inc/poisson2d/fluid_dynamics/mapped_grid.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_MAPPED_GRID_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_MAPPED_GRID_H_
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "grid.h"
+#include "grid_io.h"
+
+namespace fluid_dynamics {
+
+template<typename T>
+class MappedGrid {
+ public:
+  MappedGrid();
+  MappedGrid(const MappedGrid&) = delete;
+  MappedGrid(MappedGrid&& other) noexcept;
+  explicit MappedGrid(const std::string& filename);
+  MappedGrid(const std::string& filename, size_t rows, size_t cols, size_t offset = 0);
+  ~MappedGrid();
+
+  MappedGrid& operator=(const MappedGrid&) = delete;
+  MappedGrid& operator=(MappedGrid&& other) noexcept;
+
+  [[nodiscard]] const T* data() const;
+  [[nodiscard]] const T* data(size_t i, size_t j) const;
+
+  [[nodiscard]] size_t rows() const;
+  [[nodiscard]] size_t cols() const;
+
+  const T& operator()(size_t i, size_t j) const;
+
+  [[nodiscard]] Grid<T> Region(size_t row, size_t col, size_t rows, size_t cols) const;
+  [[nodiscard]] Grid<T> ToGrid() const;
+
+  static MappedGrid Level(const std::string& filename, size_t level);
+  static size_t Levels(const std::string& filename);
+
+ private:
+  void* mapping_;
+  size_t mapping_size_;
+  const T* data_;
+  size_t rows_;
+  size_t cols_;
+
+  void Map(const std::string& filename, size_t offset);
+  void Unmap();
+}; // class MappedGrid
+
+} // namespace fluid_dynamics
+
+#include "mapped_grid.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_MAPPED_GRID_H_
@@ -0,0 +1,159 @@
+// File: inc/poisson2d/fluid_dynamics/mapped_grid.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+MappedGrid<T>::MappedGrid()
+    : mapping_{nullptr}, mapping_size_{0}, data_{nullptr}, rows_{0}, cols_{0} {}
+
+template<typename T>
+MappedGrid<T>::MappedGrid(MappedGrid&& other) noexcept
+    : mapping_{std::exchange(other.mapping_, nullptr)}, mapping_size_{std::exchange(other.mapping_size_, 0)},
+      data_{std::exchange(other.data_, nullptr)}, rows_{std::exchange(other.rows_, 0)},
+      cols_{std::exchange(other.cols_, 0)} {}
+
+template<typename T>
+MappedGrid<T>::MappedGrid(const std::string& filename)
+    : mapping_{nullptr}, mapping_size_{0}, data_{nullptr}, rows_{0}, cols_{0} {
+  struct stat file_stat{};
+
+  if (stat(filename.c_str(), &file_stat) != 0) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  auto dim = static_cast<size_t>(std::sqrt(static_cast<double>(file_stat.st_size / sizeof(T))));
+  if (dim * dim * sizeof(T) != static_cast<size_t>(file_stat.st_size)) {
+    throw std::runtime_error("File does not contain a square grid: " + filename);
+  }
+  rows_ = dim;
+  cols_ = dim;
+  Map(filename, 0);
+}
+
+template<typename T>
+MappedGrid<T>::MappedGrid(const std::string& filename, size_t rows, size_t cols, size_t offset)
+    : mapping_{nullptr}, mapping_size_{0}, data_{nullptr}, rows_{rows}, cols_{cols} {
+  Map(filename, offset);
+}
+
+template<typename T>
+MappedGrid<T>::~MappedGrid() {
+  Unmap();
+}
+
+template<typename T>
+MappedGrid<T>& MappedGrid<T>::operator=(MappedGrid&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapping_size_ = std::exchange(other.mapping_size_, 0);
+    data_ = std::exchange(other.data_, nullptr);
+    rows_ = std::exchange(other.rows_, 0);
+    cols_ = std::exchange(other.cols_, 0);
+  }
+  return *this;
+}
+
+template<typename T>
+const T* MappedGrid<T>::data() const {
+  return data_;
+}
+
+template<typename T>
+const T* MappedGrid<T>::data(size_t i, size_t j) const {
+  return data_ + i * cols_ + j;
+}
+
+template<typename T>
+size_t MappedGrid<T>::rows() const {
+  return rows_;
+}
+
+template<typename T>
+size_t MappedGrid<T>::cols() const {
+  return cols_;
+}
+
+template<typename T>
+const T& MappedGrid<T>::operator()(size_t i, size_t j) const {
+  return data_[i * cols_ + j];
+}
+
+template<typename T>
+Grid<T> MappedGrid<T>::Region(size_t row, size_t col, size_t rows, size_t cols) const {
+  if (row + rows > rows_ || col + cols > cols_) {
+    throw std::out_of_range("Region exceeds the mapped grid");
+  }
+
+  Grid<T> region{rows, cols};
+
+  for (size_t i = 0; i < rows; ++i) {
+    std::copy(data(row + i, col), data(row + i, col) + cols, region.data(i, 0));
+  }
+
+  return region;
+}
+
+template<typename T>
+Grid<T> MappedGrid<T>::ToGrid() const {
+  return Region(0, 0, rows_, cols_);
+}
+
+template<typename T>
+MappedGrid<T> MappedGrid<T>::Level(const std::string& filename, size_t level) {
+  std::vector<PyramidLevel> levels = ReadPyramidLevels(filename, sizeof(T));
+
+  if (level >= levels.size()) {
+    throw std::out_of_range("Pyramid level " + std::to_string(level) + " does not exist in " + filename);
+  }
+
+  return MappedGrid{filename, levels[level].rows, levels[level].cols, levels[level].offset};
+}
+
+template<typename T>
+size_t MappedGrid<T>::Levels(const std::string& filename) {
+  return ReadPyramidLevels(filename, sizeof(T)).size();
+}
+
+template<typename T>
+void MappedGrid<T>::Map(const std::string& filename, size_t offset) {
+  auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t page_offset = offset % page_size;
+  size_t bytes = rows_ * cols_ * sizeof(T);
+  struct stat file_stat{};
+  int fd;
+
+  if (bytes == 0) {
+    return;
+  }
+
+  fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+  if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < offset + bytes) {
+    close(fd);
+    throw std::runtime_error("File is too small for the requested grid: " + filename);
+  }
+
+  mapping_size_ = page_offset + bytes;
+  mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(offset - page_offset));
+  close(fd);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    throw std::runtime_error("Failed to map file: " + filename);
+  }
+  data_ = reinterpret_cast<const T*>(static_cast<const char*>(mapping_) + page_offset);
+}
+
+template<typename T>
+void MappedGrid<T>::Unmap() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    data_ = nullptr;
+  }
+}
+
+} // namespace fluid_dynamics
@@ -0,0 +1,60 @@
+// File: inc/poisson2d/fluid_dynamics/mpi_ensemble.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_MPI_ENSEMBLE_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_MPI_ENSEMBLE_H_
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <mpi.h>
+#include "grid.h"
+#include "mpi_util.h"
+
+namespace fluid_dynamics {
+
+// Splits a communicator into groups of group_size ranks, each with its own MpiGrid2D, and hands
+// out independent cases to the groups through a shared counter on rank 0 of the parent. Results
+// are streamed into one file holding a fixed-size record per case.
+class MpiEnsemble {
+ public:
+  MpiEnsemble(MPI_Comm comm, int group_size);
+  MpiEnsemble(const MpiEnsemble&) = delete;
+  MpiEnsemble(MpiEnsemble&&) noexcept = delete;
+  ~MpiEnsemble();
+
+  MpiEnsemble& operator=(const MpiEnsemble&) = delete;
+  MpiEnsemble& operator=(MpiEnsemble&&) noexcept = delete;
+
+  [[nodiscard]] MPI_Comm comm() const;
+  [[nodiscard]] int rank() const;
+  [[nodiscard]] int group() const;
+  [[nodiscard]] int groups() const;
+  [[nodiscard]] size_t cases_run() const;
+  [[nodiscard]] MpiGrid2D& grid();
+
+  void Run(size_t cases, const std::function<void(size_t)>& task);
+
+  void OpenOutput(const std::string& filename, size_t record_bytes);
+  void CloseOutput();
+  template<typename T> void WriteRecord(Grid<T>& grid, size_t record);
+
+ private:
+  MPI_Comm comm_;
+  int rank_;
+  int group_;
+  int groups_;
+  MPI_Comm group_comm_;
+  MpiGrid2D grid_;
+  MPI_Win counter_win_;
+  long long* counter_;
+  MPI_File output_;
+  size_t record_bytes_;
+  size_t cases_run_;
+
+  static MPI_Comm SplitComm(MPI_Comm comm, int group_size);
+}; // class MpiEnsemble
+
+} // namespace fluid_dynamics
+
+#include "mpi_ensemble.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_MPI_ENSEMBLE_H_
@@ -0,0 +1,152 @@
+// File: inc/poisson2d/fluid_dynamics/mpi_ensemble.tpp
+
+namespace fluid_dynamics {
+
+MpiEnsemble::MpiEnsemble(MPI_Comm comm, int group_size)
+    : comm_{comm}, rank_{0}, group_{0}, groups_{0},
+      group_comm_{SplitComm(comm, group_size)}, grid_{group_comm_},
+      counter_win_{MPI_WIN_NULL}, counter_{nullptr}, output_{MPI_FILE_NULL},
+      record_bytes_{0}, cases_run_{0} {
+  int size;
+
+  MPI_Comm_rank(comm_, &rank_);
+  MPI_Comm_size(comm_, &size);
+  group_ = rank_ / group_size;
+  groups_ = (size + group_size - 1) / group_size;
+  MPI_Win_allocate(rank_ == 0 ? static_cast<MPI_Aint>(sizeof(long long)) : 0, sizeof(long long),
+                   MPI_INFO_NULL, comm_, &counter_, &counter_win_);
+}
+
+MpiEnsemble::~MpiEnsemble() {
+  int finalized;
+
+  MPI_Finalized(&finalized);
+  if (!finalized) {
+    CloseOutput();
+    if (counter_win_ != MPI_WIN_NULL) {
+      MPI_Win_free(&counter_win_);
+    }
+    if (group_comm_ != MPI_COMM_NULL) {
+      MPI_Comm_free(&group_comm_);
+    }
+  }
+}
+
+MPI_Comm MpiEnsemble::comm() const {
+  return comm_;
+}
+
+int MpiEnsemble::rank() const {
+  return rank_;
+}
+
+int MpiEnsemble::group() const {
+  return group_;
+}
+
+int MpiEnsemble::groups() const {
+  return groups_;
+}
+
+size_t MpiEnsemble::cases_run() const {
+  return cases_run_;
+}
+
+MpiGrid2D& MpiEnsemble::grid() {
+  return grid_;
+}
+
+// The leader of each group fetches the next case from the counter as soon as its group is done
+// with the previous one, so groups stay busy even if the cases take very different times.
+void MpiEnsemble::Run(size_t cases, const std::function<void(size_t)>& task) {
+  const long long increment = 1;
+  long long next = 0;
+
+  if (rank_ == 0) {
+    MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, counter_win_);
+    *counter_ = 0;
+    MPI_Win_unlock(0, counter_win_);
+  }
+  cases_run_ = 0;
+  MPI_Barrier(comm_);
+  MPI_Win_lock_all(0, counter_win_);
+
+  while (true) {
+    if (grid_.rank() == 0) {
+      MPI_Fetch_and_op(&increment, &next, MPI_LONG_LONG, 0, 0, MPI_SUM, counter_win_);
+      MPI_Win_flush(0, counter_win_);
+    }
+    MPI_Bcast(&next, 1, MPI_LONG_LONG, 0, grid_.comm());
+    if (next >= static_cast<long long>(cases)) {
+      break;
+    }
+    task(static_cast<size_t>(next));
+    ++cases_run_;
+  }
+
+  MPI_Win_unlock_all(counter_win_);
+  MPI_Barrier(comm_);
+}
+
+// The file is created and truncated once over the whole communicator, then every group opens it on
+// its own communicator, so records are written collectively within a group while the other groups
+// work on other cases.
+void MpiEnsemble::OpenOutput(const std::string& filename, size_t record_bytes) {
+  int mode = MPI_MODE_CREATE | MPI_MODE_WRONLY;
+  MPI_File file;
+
+  CloseOutput();
+  if (MPI_File_open(comm_, filename.c_str(), mode, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+  MPI_File_set_size(file, 0);
+  MPI_File_close(&file);
+  if (MPI_File_open(grid_.comm(), filename.c_str(), MPI_MODE_WRONLY, MPI_INFO_NULL, &output_) != MPI_SUCCESS) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+  record_bytes_ = record_bytes;
+}
+
+void MpiEnsemble::CloseOutput() {
+  if (output_ != MPI_FILE_NULL) {
+    MPI_File_close(&output_);
+  }
+}
+
+// Collective over the group. The blocks land at their place in the global grid of the record
+// through a subarray view, so a record has the layout of WriteGridBinary.
+template<typename T>
+void MpiEnsemble::WriteRecord(Grid<T>& grid, size_t record) {
+  auto record_offset = static_cast<MPI_Offset>(record) * static_cast<MPI_Offset>(record_bytes_);
+  MPI_Datatype file_type;
+  MPI_Datatype block;
+  int sizes[2] = {MpiCount(grid_.rows() * grid.rows()), MpiCount(grid_.cols() * grid.cols())};
+  int subsizes[2] = {MpiCount(grid.rows()), MpiCount(grid.cols())};
+  int starts[2] = {grid_.row() * subsizes[0], grid_.col() * subsizes[1]};
+
+  if (output_ == MPI_FILE_NULL) {
+    throw std::runtime_error("Ensemble output is not open");
+  }
+  block = ContiguousType(grid.rows() * grid.cols(), MpiType<T>());
+  MPI_Type_create_subarray(2, sizes, subsizes, starts, MPI_ORDER_C, MpiType<T>(), &file_type);
+  MPI_Type_commit(&file_type);
+  MPI_File_set_view(output_, record_offset, MpiType<T>(), file_type, "native", MPI_INFO_NULL);
+  MPI_File_write_all(output_, grid.data(), 1, block, MPI_STATUS_IGNORE);
+  MPI_Type_free(&file_type);
+  MPI_Type_free(&block);
+}
+
+MPI_Comm MpiEnsemble::SplitComm(MPI_Comm comm, int group_size) {
+  MPI_Comm group_comm;
+  int rank;
+
+  if (group_size < 1) {
+    throw std::invalid_argument("Ensemble groups need at least one rank");
+  }
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_split(comm, rank / group_size, rank, &group_comm);
+
+  return group_comm;
+}
+
+} // namespace fluid_dynamics
@@ -0,0 +1,76 @@
+// File: inc/poisson2d/fluid_dynamics/mpi_grid3d.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_MPI_GRID3D_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_MPI_GRID3D_H_
+
+#include <array>
+#include <iostream>
+#include <string>
+#include <mpi.h>
+#include "grid3d.h"
+#include "mpi_util.h"
+
+namespace fluid_dynamics {
+
+// Slabs split the first dimension only, pencils the first two and blocks all three. Fewer split
+// dimensions mean fewer neighbours but larger faces per rank.
+enum class Decomposition {
+  kSlab,
+  kPencil,
+  kBlock
+}; // enum class Decomposition
+
+class MpiGrid3D {
+ public:
+  MpiGrid3D();
+  explicit MpiGrid3D(Decomposition decomposition);
+  MpiGrid3D(MPI_Comm comm, Decomposition decomposition);
+  MpiGrid3D(int argc, char** argv, Decomposition decomposition);
+  MpiGrid3D(int argc, char** argv, MPI_Comm comm, Decomposition decomposition);
+  MpiGrid3D(const MpiGrid3D&) = delete;
+  MpiGrid3D(MpiGrid3D&&) noexcept = delete;
+  ~MpiGrid3D();
+
+  MpiGrid3D& operator=(const MpiGrid3D&) = delete;
+  MpiGrid3D& operator=(MpiGrid3D&&) noexcept = delete;
+
+  [[nodiscard]] MPI_Comm comm() const;
+  [[nodiscard]] int size() const;
+  [[nodiscard]] int rank() const;
+  [[nodiscard]] Decomposition decomposition() const;
+  [[nodiscard]] const int* dims() const;
+  [[nodiscard]] const int* coords() const;
+  [[nodiscard]] int neighbor(size_t dim, int side) const;
+  [[nodiscard]] MPI_Datatype face_type(size_t dim) const;
+
+  void CreateFaceTypes(size_t nx, size_t ny, size_t nz, size_t halo, MPI_Datatype type);
+  void FreeTypes();
+
+  [[nodiscard]] size_t GlobalIndex(size_t dim, size_t i, size_t local) const;
+  [[nodiscard]] size_t LocalSize(size_t dim, size_t global) const;
+  [[nodiscard]] size_t HaloCells(size_t nx, size_t ny, size_t nz) const;
+
+ private:
+  MPI_Comm comm_;
+  int initialized_;
+  int finalized_;
+  int size_;
+  int rank_;
+  Decomposition decomposition_;
+  int neighbors_[6];
+  int dims_[3];
+  int periods_[3];
+  int coords_[3];
+  MPI_Datatype face_types_[3];
+
+  void Init(int* argc, char*** argv, MPI_Comm comm);
+}; // class MpiGrid3D
+
+template<typename T> void WriteGridBinary(Grid3D<T>& grid, const std::string& filename, MpiGrid3D& mpi_grid);
+template<typename T> void WriteGridBinary(Grid3D<std::array<T, 3>>& grid, const std::string& filename,
+                                          MpiGrid3D& mpi_grid);
+
+} // namespace fluid_dynamics
+
+#include "mpi_grid3d.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_MPI_GRID3D_H_
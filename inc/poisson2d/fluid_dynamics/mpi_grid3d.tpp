@@ -0,0 +1,190 @@
+// File: inc/poisson2d/fluid_dynamics/mpi_grid3d.tpp
+
+namespace fluid_dynamics {
+
+MpiGrid3D::MpiGrid3D() : MpiGrid3D(MPI_COMM_WORLD, Decomposition::kBlock) {}
+
+MpiGrid3D::MpiGrid3D(Decomposition decomposition) : MpiGrid3D(MPI_COMM_WORLD, decomposition) {}
+
+MpiGrid3D::MpiGrid3D(MPI_Comm comm, Decomposition decomposition)
+    : comm_{comm}, initialized_{-1}, finalized_{-1}, size_{0}, rank_{0}, decomposition_{decomposition},
+      neighbors_{0, 0, 0, 0, 0, 0}, dims_{0, 0, 0}, periods_{0, 0, 0}, coords_{0, 0, 0},
+      face_types_{MPI_DATATYPE_NULL, MPI_DATATYPE_NULL, MPI_DATATYPE_NULL} {
+  Init(nullptr, nullptr, comm);
+}
+
+MpiGrid3D::MpiGrid3D(int argc, char** argv, Decomposition decomposition)
+    : MpiGrid3D(argc, argv, MPI_COMM_WORLD, decomposition) {}
+
+MpiGrid3D::MpiGrid3D(int argc, char** argv, MPI_Comm comm, Decomposition decomposition)
+    : comm_{comm}, initialized_{-1}, finalized_{-1}, size_{0}, rank_{0}, decomposition_{decomposition},
+      neighbors_{0, 0, 0, 0, 0, 0}, dims_{0, 0, 0}, periods_{0, 0, 0}, coords_{0, 0, 0},
+      face_types_{MPI_DATATYPE_NULL, MPI_DATATYPE_NULL, MPI_DATATYPE_NULL} {
+  Init(&argc, &argv, comm);
+}
+
+MpiGrid3D::~MpiGrid3D() {
+  MPI_Finalized(&finalized_);
+  if (!finalized_) {
+    FreeTypes();
+    if (comm_ != MPI_COMM_NULL) {
+      MPI_Comm_free(&comm_);
+    }
+    if (!initialized_) {
+      MPI_Finalize();
+    }
+  }
+}
+
+MPI_Comm MpiGrid3D::comm() const {
+  return comm_;
+}
+
+int MpiGrid3D::size() const {
+  return size_;
+}
+
+int MpiGrid3D::rank() const {
+  return rank_;
+}
+
+Decomposition MpiGrid3D::decomposition() const {
+  return decomposition_;
+}
+
+const int* MpiGrid3D::dims() const {
+  return dims_;
+}
+
+const int* MpiGrid3D::coords() const {
+  return coords_;
+}
+
+// Side 0 is the lower neighbour along the dimension, side 1 the upper one.
+int MpiGrid3D::neighbor(size_t dim, int side) const {
+  return neighbors_[2 * dim + side];
+}
+
+MPI_Datatype MpiGrid3D::face_type(size_t dim) const {
+  return face_types_[dim];
+}
+
+// Faces are subarrays of the padded block. The y face spans the x halo and the z face spans both,
+// so exchanging x, y and z in that order also fills the edges and corners of the halo.
+void MpiGrid3D::CreateFaceTypes(size_t nx, size_t ny, size_t nz, size_t halo, MPI_Datatype type) {
+  int sizes[3] = {static_cast<int>(nx + 2 * halo), static_cast<int>(ny + 2 * halo), static_cast<int>(nz + 2 * halo)};
+  int faces[3][3] = {{static_cast<int>(halo), static_cast<int>(ny), static_cast<int>(nz)},
+                     {sizes[0], static_cast<int>(halo), static_cast<int>(nz)},
+                     {sizes[0], sizes[1], static_cast<int>(halo)}};
+  int starts[3] = {0, 0, 0};
+
+  FreeTypes();
+  for (size_t d = 0; d < 3; ++d) {
+    MPI_Type_create_subarray(3, sizes, faces[d], starts, MPI_ORDER_C, type, &face_types_[d]);
+    MPI_Type_commit(&face_types_[d]);
+  }
+}
+
+void MpiGrid3D::FreeTypes() {
+  for (MPI_Datatype& face_type : face_types_) {
+    if (face_type != MPI_DATATYPE_NULL) {
+      MPI_Type_free(&face_type);
+      face_type = MPI_DATATYPE_NULL;
+    }
+  }
+}
+
+size_t MpiGrid3D::GlobalIndex(size_t dim, size_t i, size_t local) const {
+  return coords_[dim] * local + i;
+}
+
+size_t MpiGrid3D::LocalSize(size_t dim, size_t global) const {
+  if (global % dims_[dim] == 0) {
+    return global / dims_[dim];
+  }
+  if (rank() == 0) {
+    std::cout << "L must be divisible by the number of processes along dimension " << dim << ". ";
+    std::cout << "L = " << global << " can't be distributed among " << size() << " Processes in ";
+    std::cout << dims_[0] << "x" << dims_[1] << "x" << dims_[2] << " Grid." << std::endl;
+    MPI_Abort(comm(), 1);
+  }
+  return 0;
+}
+
+// Cells this rank sends per halo exchange of a one cell halo.
+size_t MpiGrid3D::HaloCells(size_t nx, size_t ny, size_t nz) const {
+  size_t faces[3] = {ny * nz, nx * nz, nx * ny};
+  size_t cells = 0;
+
+  for (size_t d = 0; d < 3; ++d) {
+    for (int side = 0; side < 2; ++side) {
+      if (neighbor(d, side) != MPI_PROC_NULL) {
+        cells += faces[d];
+      }
+    }
+  }
+
+  return cells;
+}
+
+// Dimensions left at one are never split, MPI_Dims_create only distributes the zero entries.
+void MpiGrid3D::Init(int* argc, char*** argv, MPI_Comm comm) {
+  initialized_ = InitializeMpi(argc, argv);
+  MPI_Finalized(&finalized_);
+  MPI_Comm_size(comm, &size_);
+  if (decomposition_ == Decomposition::kSlab) {
+    dims_[1] = 1;
+    dims_[2] = 1;
+  } else if (decomposition_ == Decomposition::kPencil) {
+    dims_[2] = 1;
+  }
+  MPI_Dims_create(size_, 3, dims_);
+  MPI_Cart_create(comm, 3, dims_, periods_, 1, &comm_);
+  MPI_Comm_rank(comm_, &rank_);
+  MPI_Cart_coords(comm_, rank_, 3, coords_);
+  for (int d = 0; d < 3; ++d) {
+    MPI_Cart_shift(comm_, d, 1, &neighbors_[2 * d], &neighbors_[2 * d + 1]);
+  }
+}
+
+// Every rank writes its block through a subarray view of the global file in one collective call.
+template<typename T>
+void WriteGridBinary(Grid3D<T>& grid, const std::string& filename, MpiGrid3D& mpi_grid) {
+  MPI_File file;
+  MPI_Datatype file_type;
+  MPI_Datatype block = ContiguousType(grid.size(), MpiType<T>());
+  int sizes[3] = {MpiCount(mpi_grid.dims()[0] * grid.nx()), MpiCount(mpi_grid.dims()[1] * grid.ny()),
+                  MpiCount(mpi_grid.dims()[2] * grid.nz())};
+  int subsizes[3] = {MpiCount(grid.nx()), MpiCount(grid.ny()), MpiCount(grid.nz())};
+  int starts[3] = {mpi_grid.coords()[0] * subsizes[0], mpi_grid.coords()[1] * subsizes[1],
+                   mpi_grid.coords()[2] * subsizes[2]};
+  int mode = MPI_MODE_CREATE | MPI_MODE_WRONLY;
+
+  MPI_Type_create_subarray(3, sizes, subsizes, starts, MPI_ORDER_C, MpiType<T>(), &file_type);
+  MPI_Type_commit(&file_type);
+  MPI_File_open(mpi_grid.comm(), filename.c_str(), mode, MPI_INFO_NULL, &file);
+  MPI_File_set_size(file, static_cast<MPI_Offset>(sizes[0]) * sizes[1] * sizes[2] * sizeof(T));
+  MPI_File_set_view(file, 0, MpiType<T>(), file_type, "native", MPI_INFO_NULL);
+  MPI_File_write_all(file, grid.data(), 1, block, MPI_STATUS_IGNORE);
+  MPI_File_close(&file);
+  MPI_Type_free(&file_type);
+  MPI_Type_free(&block);
+}
+
+template<typename T>
+void WriteGridBinary(Grid3D<std::array<T, 3>>& grid, const std::string& filename, MpiGrid3D& mpi_grid) {
+  Grid3D<T> unpacked_grid{grid.nx(), grid.ny(), 3 * grid.nz()};
+
+  #pragma omp parallel for default(none) collapse(2) shared(grid, unpacked_grid)
+  for (size_t i = 0; i < grid.nx(); ++i) {
+    for (size_t j = 0; j < grid.ny(); ++j) {
+      for (size_t k = 0; k < grid.nz(); ++k) {
+        std::copy_n(grid(i, j, k).data(), 3, unpacked_grid.data(i, j, 3 * k));
+      }
+    }
+  }
+
+  WriteGridBinary(unpacked_grid, filename, mpi_grid);
+}
+
+} // namespace fluid_dynamics
@@ -2,20 +2,40 @@
 #ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_MPI_UTIL_H_
 #define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_MPI_UTIL_H_
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
+#include <limits>
+#include <stdexcept>
+#include <string>
 #include <utility>
 #include <type_traits>
+#include <vector>
 #include <mpi.h>
+#include "ghosted_grid.h"
 #include "grid.h"
+#include "profiler.h"
 
 namespace fluid_dynamics {
 
+// Bytes one halo exchange sends to ranks on the same node and to ranks on other nodes.
+struct HaloTraffic {
+  unsigned long long intra_node_bytes;
+  unsigned long long inter_node_bytes;
+};
+
+// Ranks are placed node by node. When every node holds the same number of ranks and the process
+// grid can be tiled into equal node blocks, each node gets the block with the smallest halo surface
+// and its ranks are numbered row major inside it. Otherwise the communicator order is kept.
 class MpiGrid2D {
  public:
   MpiGrid2D();
   explicit MpiGrid2D(MPI_Comm comm);
   MpiGrid2D(int argc, char** argv);
   MpiGrid2D(int argc, char** argv, MPI_Comm comm);
+  MpiGrid2D(MPI_Comm comm, bool periodic);
+  MpiGrid2D(int argc, char** argv, MPI_Comm comm, bool periodic);
+  MpiGrid2D(MPI_Comm comm, int rows, int cols, bool periodic = false);
   MpiGrid2D(const MpiGrid2D&) = delete;
   MpiGrid2D(MpiGrid2D&&) noexcept = delete;
   ~MpiGrid2D();
@@ -38,7 +58,12 @@ class MpiGrid2D {
   [[nodiscard]] int cols() const;
   [[nodiscard]] const int* dims() const;
   [[nodiscard]] const int* periods() const;
+  [[nodiscard]] bool periodic() const;
   [[nodiscard]] const int* coords() const;
+  [[nodiscard]] int node() const;
+  [[nodiscard]] int node(int rank) const;
+  [[nodiscard]] int nodes() const;
+  [[nodiscard]] const int* node_block() const;
   [[nodiscard]] MPI_Datatype row_type() const;
   [[nodiscard]] MPI_Datatype col_type() const;
 
@@ -48,6 +73,8 @@ class MpiGrid2D {
   void CreateRowType(size_t cols, MPI_Datatype type);
   void CreateColType(size_t rows, size_t cols_offset, MPI_Datatype type);
   void CreateTypes(size_t rows, size_t cols, size_t cols_offset, MPI_Datatype type);
+  void CreateHaloTypes(size_t rows, size_t cols, size_t halo, MPI_Datatype type);
+  template<typename T> void CreateHaloTypes(const GhostedGrid<T>& grid, MPI_Datatype type);
 
   void FreeRowType();
   void FreeColType();
@@ -59,6 +86,15 @@ class MpiGrid2D {
   [[nodiscard]] size_t LocalRows(size_t global_rows) const;
   [[nodiscard]] size_t LocalCols(size_t global_cols) const;
 
+  [[nodiscard]] HaloTraffic HaloBytes(size_t rows, size_t cols, size_t halo, size_t element_size) const;
+
+  static bool NodeBlock(const int* dims, int ranks_per_node, int* block);
+
+  // Largest element count passed to MPI in one piece, larger buffers are described by derived
+  // types built from chunks of this size. Lowering it exercises the large-count paths on small grids.
+  [[nodiscard]] static size_t count_limit();
+  static void count_limit(size_t count_limit);
+
  private:
   MPI_Comm comm_;
   int initialized_;
@@ -71,12 +107,29 @@ class MpiGrid2D {
   int coords_[2];
   MPI_Datatype row_type_;
   MPI_Datatype col_type_;
+  int nodes_;
+  int node_block_[2];
+  std::vector<int> rank_nodes_;
+  inline static size_t count_limit_ = std::numeric_limits<int>::max();
+
+  void CreateCartesian(MPI_Comm comm);
+  MPI_Comm PlaceByNode(MPI_Comm comm);
 }; // class MpiGrid2D
 
+MPI_Offset RowOffset(const MpiGrid2D& mpi_grid, size_t rows, size_t cols, size_t i, size_t element_size);
 template<typename T> void WriteGridBinary(Grid<T>& grid, const std::string& filename, MpiGrid2D& mpi_grid);
 template<typename T> void WriteGridBinary(Grid<std::pair<T, T>>& grid, const std::string& filename, MpiGrid2D& mpi_grid);
 
+void ReduceProfile(Profiler& profiler, MpiGrid2D& mpi_grid);
+HaloTraffic ReduceHaloTraffic(const HaloTraffic& traffic, MpiGrid2D& mpi_grid);
+
+int InitializeMpi(int* argc, char*** argv);
 template<typename T> static inline MPI_Datatype MpiType();
+int MpiCount(size_t count);
+MPI_Datatype ContiguousType(size_t count, MPI_Datatype type);
+
+template<typename T> inline void CompensatedAdd(T value, T compensation, T& sum, T& total_compensation);
+template<typename T> void CompensatedSumOp(void* in, void* inout, int* len, MPI_Datatype* type);
 
 } // namespace fluid_dynamics
 
@@ -6,82 +6,92 @@ MpiGrid2D::MpiGrid2D()
     : comm_{MPI_COMM_WORLD}, initialized_{-1}, finalized_{-1}, rank_{0}, size_{0},
       neighbors_{0, 0, 0, 0}, dims_{0, 0},
       periods_{0, 0}, coords_{0, 0},
-      row_type_{MPI_DATATYPE_NULL}, col_type_{MPI_DATATYPE_NULL} {
-  MPI_Initialized(&initialized_);
-  if (!initialized_) {
-    MPI_Init(nullptr, nullptr);
-  }
+      row_type_{MPI_DATATYPE_NULL}, col_type_{MPI_DATATYPE_NULL}, nodes_{1}, node_block_{0, 0} {
+  initialized_ = InitializeMpi(nullptr, nullptr);
   MPI_Finalized(&finalized_);
-  MPI_Comm_size(comm_, &size_);
-  MPI_Comm_rank(comm_, &rank_);
-  MPI_Dims_create(size_, 2, dims_);
-  MPI_Cart_create(MPI_COMM_WORLD, 2, dims_, periods_, 1, &comm_);
-  MPI_Cart_coords(comm_, rank_, 2, coords_);
-  MPI_Cart_shift(comm_, 0, 1, &neighbors_[0], &neighbors_[1]);
-  MPI_Cart_shift(comm_, 1, 1, &neighbors_[2], &neighbors_[3]);
+  CreateCartesian(comm_);
 }
 
 MpiGrid2D::MpiGrid2D(MPI_Comm comm)
     : comm_{comm}, initialized_{-1}, finalized_{-1}, rank_{0}, size_{0},
       neighbors_{0, 0, 0, 0}, dims_{0, 0},
       periods_{0, 0}, coords_{0, 0},
-      row_type_{MPI_DATATYPE_NULL}, col_type_{MPI_DATATYPE_NULL} {
-  MPI_Initialized(&initialized_);
-  if (!initialized_) {
-    MPI_Init(nullptr, nullptr);
-  }
+      row_type_{MPI_DATATYPE_NULL}, col_type_{MPI_DATATYPE_NULL}, nodes_{1}, node_block_{0, 0} {
+  initialized_ = InitializeMpi(nullptr, nullptr);
   MPI_Finalized(&finalized_);
-  MPI_Comm_size(comm_, &size_);
-  MPI_Comm_rank(comm_, &rank_);
-  MPI_Dims_create(size_, 2, dims_);
-  MPI_Cart_create(MPI_COMM_WORLD, 2, dims_, periods_, 1, &comm_);
-  MPI_Cart_coords(comm_, rank_, 2, coords_);
-  MPI_Cart_shift(comm_, 0, 1, &neighbors_[0], &neighbors_[1]);
-  MPI_Cart_shift(comm_, 1, 1, &neighbors_[2], &neighbors_[3]);
+  CreateCartesian(comm_);
 }
 
 MpiGrid2D::MpiGrid2D(int argc, char** argv)
     : comm_{MPI_COMM_WORLD}, initialized_{-1}, finalized_{-1}, rank_{0}, size_{0},
       neighbors_{0, 0, 0, 0}, dims_{0, 0},
       periods_{0, 0}, coords_{0, 0},
-      row_type_{MPI_DATATYPE_NULL}, col_type_{MPI_DATATYPE_NULL} {
-  MPI_Initialized(&initialized_);
-  if (!initialized_) {
-    MPI_Init(&argc, &argv);
-  }
+      row_type_{MPI_DATATYPE_NULL}, col_type_{MPI_DATATYPE_NULL}, nodes_{1}, node_block_{0, 0} {
+  initialized_ = InitializeMpi(&argc, &argv);
   MPI_Finalized(&finalized_);
-  MPI_Comm_size(comm_, &size_);
-  MPI_Comm_rank(comm_, &rank_);
-  MPI_Dims_create(size_, 2, dims_);
-  MPI_Cart_create(MPI_COMM_WORLD, 2, dims_, periods_, 1, &comm_);
-  MPI_Cart_coords(comm_, rank_, 2, coords_);
-  MPI_Cart_shift(comm_, 0, 1, &neighbors_[0], &neighbors_[1]);
-  MPI_Cart_shift(comm_, 1, 1, &neighbors_[2], &neighbors_[3]);
+  CreateCartesian(comm_);
 }
 
 MpiGrid2D::MpiGrid2D(int argc, char** argv, MPI_Comm comm)
     : comm_{comm}, initialized_{-1}, finalized_{-1}, rank_{0}, size_{0},
       neighbors_{0, 0, 0, 0}, dims_{0, 0},
       periods_{0, 0}, coords_{0, 0},
-      row_type_{MPI_DATATYPE_NULL}, col_type_{MPI_DATATYPE_NULL} {
-  MPI_Initialized(&initialized_);
-  if (!initialized_) {
-    MPI_Init(&argc, &argv);
-  }
+      row_type_{MPI_DATATYPE_NULL}, col_type_{MPI_DATATYPE_NULL}, nodes_{1}, node_block_{0, 0} {
+  initialized_ = InitializeMpi(&argc, &argv);
   MPI_Finalized(&finalized_);
-  MPI_Comm_size(comm_, &size_);
-  MPI_Comm_rank(comm_, &rank_);
-  MPI_Dims_create(size_, 2, dims_);
-  MPI_Cart_create(MPI_COMM_WORLD, 2, dims_, periods_, 1, &comm_);
-  MPI_Cart_coords(comm_, rank_, 2, coords_);
-  MPI_Cart_shift(comm_, 0, 1, &neighbors_[0], &neighbors_[1]);
-  MPI_Cart_shift(comm_, 1, 1, &neighbors_[2], &neighbors_[3]);
+  CreateCartesian(comm_);
+}
+
+// MPI is only finalized by the grid that initialized it, grids on sub-communicators just release
+// their Cartesian communicator.
+// Periodic grids wrap around in both directions, so the halo exchange also fills the ghost cells
+// on the domain edges.
+MpiGrid2D::MpiGrid2D(MPI_Comm comm, bool periodic)
+    : comm_{comm}, initialized_{-1}, finalized_{-1}, rank_{0}, size_{0},
+      neighbors_{0, 0, 0, 0}, dims_{0, 0},
+      periods_{periodic, periodic}, coords_{0, 0},
+      row_type_{MPI_DATATYPE_NULL}, col_type_{MPI_DATATYPE_NULL}, nodes_{1}, node_block_{0, 0} {
+  initialized_ = InitializeMpi(nullptr, nullptr);
+  MPI_Finalized(&finalized_);
+  CreateCartesian(comm_);
+}
+
+MpiGrid2D::MpiGrid2D(int argc, char** argv, MPI_Comm comm, bool periodic)
+    : comm_{comm}, initialized_{-1}, finalized_{-1}, rank_{0}, size_{0},
+      neighbors_{0, 0, 0, 0}, dims_{0, 0},
+      periods_{periodic, periodic}, coords_{0, 0},
+      row_type_{MPI_DATATYPE_NULL}, col_type_{MPI_DATATYPE_NULL}, nodes_{1}, node_block_{0, 0} {
+  initialized_ = InitializeMpi(&argc, &argv);
+  MPI_Finalized(&finalized_);
+  CreateCartesian(comm_);
+}
+
+// Fixes the process grid to rows x cols, a zero leaves that dimension to MPI_Dims_create.
+MpiGrid2D::MpiGrid2D(MPI_Comm comm, int rows, int cols, bool periodic)
+    : comm_{comm}, initialized_{-1}, finalized_{-1}, rank_{0}, size_{0},
+      neighbors_{0, 0, 0, 0}, dims_{cols, rows},
+      periods_{periodic, periodic}, coords_{0, 0},
+      row_type_{MPI_DATATYPE_NULL}, col_type_{MPI_DATATYPE_NULL}, nodes_{1}, node_block_{0, 0} {
+  initialized_ = InitializeMpi(nullptr, nullptr);
+  MPI_Finalized(&finalized_);
+  int size;
+  MPI_Comm_size(comm, &size);
+  if (rows < 0 || cols < 0 || (rows > 0 && size % rows != 0) || (cols > 0 && size % cols != 0)
+      || (rows > 0 && cols > 0 && rows * cols != size)) {
+    throw std::invalid_argument("Process grid dimensions do not match the communicator size");
+  }
+  CreateCartesian(comm_);
 }
 
 MpiGrid2D::~MpiGrid2D() {
   MPI_Finalized(&finalized_);
   if (!finalized_) {
-    MPI_Finalize();
+    if (comm_ != MPI_COMM_NULL) {
+      MPI_Comm_free(&comm_);
+    }
+    if (!initialized_) {
+      MPI_Finalize();
+    }
   }
 }
 
@@ -145,10 +155,30 @@ const int* MpiGrid2D::periods() const {
   return periods_;
 }
 
+bool MpiGrid2D::periodic() const {
+  return periods_[0] && periods_[1];
+}
+
 const int* MpiGrid2D::coords() const {
   return coords_;
 }
 
+int MpiGrid2D::node() const {
+  return rank_nodes_[rank_];
+}
+
+int MpiGrid2D::node(int rank) const {
+  return rank_nodes_[rank];
+}
+
+int MpiGrid2D::nodes() const {
+  return nodes_;
+}
+
+const int* MpiGrid2D::node_block() const {
+  return node_block_;
+}
+
 MPI_Datatype MpiGrid2D::row_type() const {
   return row_type_;
 }
@@ -166,13 +196,15 @@ void MpiGrid2D::col_type(MPI_Datatype col_type) {
 }
 
 void MpiGrid2D::CreateRowType(size_t cols, MPI_Datatype type) {
-  MPI_Type_contiguous(static_cast<int>(cols), type, &row_type_);
-  MPI_Type_commit(&row_type_);
+  row_type_ = ContiguousType(cols, type);
 }
 
+// Strides are given in bytes, so they may exceed the int range.
 void MpiGrid2D::CreateColType(size_t rows, size_t cols_offset, MPI_Datatype type) {
-  MPI_Type_vector(static_cast<int>(rows), 1, static_cast<int>(cols_offset),
-                  type, &col_type_);
+  MPI_Aint lower_bound, extent;
+
+  MPI_Type_get_extent(type, &lower_bound, &extent);
+  MPI_Type_create_hvector(MpiCount(rows), 1, static_cast<MPI_Aint>(cols_offset) * extent, type, &col_type_);
   MPI_Type_commit(&col_type_);
 }
 
@@ -181,6 +213,26 @@ void MpiGrid2D::CreateTypes(size_t rows, size_t cols, size_t cols_offset, MPI_Da
   CreateColType(rows, cols_offset, type);
 }
 
+// Row halos are halo rows of the interior width, column halos span the full padded height so
+// that exchanging rows first and columns second also fills the corners of the halo.
+void MpiGrid2D::CreateHaloTypes(size_t rows, size_t cols, size_t halo, MPI_Datatype type) {
+  MPI_Aint lower_bound, extent;
+  MPI_Datatype row = ContiguousType(cols, type);
+  auto stride = static_cast<MPI_Aint>(cols + 2 * halo);
+
+  MPI_Type_get_extent(type, &lower_bound, &extent);
+  MPI_Type_create_hvector(MpiCount(halo), 1, stride * extent, row, &row_type_);
+  MPI_Type_commit(&row_type_);
+  MPI_Type_free(&row);
+  MPI_Type_create_hvector(MpiCount(rows + 2 * halo), MpiCount(halo), stride * extent, type, &col_type_);
+  MPI_Type_commit(&col_type_);
+}
+
+template<typename T>
+void MpiGrid2D::CreateHaloTypes(const GhostedGrid<T>& grid, MPI_Datatype type) {
+  CreateHaloTypes(grid.rows(), grid.cols(), grid.ghost(), type);
+}
+
 void MpiGrid2D::FreeRowType() {
   if (row_type_ != MPI_DATATYPE_NULL) {
     MPI_Type_free(&row_type_);
@@ -200,6 +252,17 @@ void MpiGrid2D::FreeTypes() {
   FreeColType();
 }
 
+size_t MpiGrid2D::count_limit() {
+  return count_limit_;
+}
+
+void MpiGrid2D::count_limit(size_t count_limit) {
+  if (count_limit == 0 || count_limit > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    throw std::invalid_argument("The count limit has to be in [1, INT_MAX]");
+  }
+  count_limit_ = count_limit;
+}
+
 size_t MpiGrid2D::GlobalRow(size_t i, size_t data_rows) const {
   return row() * data_rows + i;
 }
@@ -236,12 +299,131 @@ size_t MpiGrid2D::LocalCols(size_t global_cols) const {
   return 0;
 }
 
+// Counts what this rank sends per exchange with the halo types of CreateHaloTypes, a periodic
+// neighbour that is the rank itself counts as intra-node.
+HaloTraffic MpiGrid2D::HaloBytes(size_t rows, size_t cols, size_t halo, size_t element_size) const {
+  HaloTraffic traffic{0, 0};
+  const int neighbors[4] = {left(), right(), top(), bot()};
+  const unsigned long long bytes[4] = {halo * (rows + 2 * halo) * element_size, halo * (rows + 2 * halo) * element_size,
+                                       halo * cols * element_size, halo * cols * element_size};
+
+  for (int n = 0; n < 4; ++n) {
+    if (neighbors[n] == MPI_PROC_NULL) {
+      continue;
+    }
+    if (node(neighbors[n]) == node()) {
+      traffic.intra_node_bytes += bytes[n];
+    } else {
+      traffic.inter_node_bytes += bytes[n];
+    }
+  }
+
+  return traffic;
+}
+
+// Picks the node block, in processes along each dimension, with the fewest halo cells crossing its
+// edge for square subdomains of a square domain. Returns false if no block tiles the process grid.
+bool MpiGrid2D::NodeBlock(const int* dims, int ranks_per_node, int* block) {
+  bool found = false;
+  long best = 0;
+
+  for (int b0 = 1; b0 <= dims[0]; ++b0) {
+    if (dims[0] % b0 != 0 || ranks_per_node % b0 != 0) {
+      continue;
+    }
+    int b1 = ranks_per_node / b0;
+    if (dims[1] % b1 != 0) {
+      continue;
+    }
+    long surface = static_cast<long>(b0) * dims[1] + static_cast<long>(b1) * dims[0];
+    if (!found || surface < best) {
+      best = surface;
+      block[0] = b0;
+      block[1] = b1;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+// The Cartesian topology is created on the given communicator, ranks and coordinates refer to it.
+void MpiGrid2D::CreateCartesian(MPI_Comm comm) {
+  MPI_Comm_size(comm, &size_);
+  MPI_Dims_create(size_, 2, dims_);
+  MPI_Comm placed = PlaceByNode(comm);
+  MPI_Cart_create(placed, 2, dims_, periods_, 0, &comm_);
+  MPI_Comm_free(&placed);
+  MPI_Comm_rank(comm_, &rank_);
+  MPI_Cart_coords(comm_, rank_, 2, coords_);
+  MPI_Cart_shift(comm_, 0, 1, &neighbors_[0], &neighbors_[1]);
+  MPI_Cart_shift(comm_, 1, 1, &neighbors_[2], &neighbors_[3]);
+
+  int node = rank_nodes_[0];
+  rank_nodes_.assign(size_, 0);
+  MPI_Allgather(&node, 1, MPI_INT, rank_nodes_.data(), 1, MPI_INT, comm_);
+}
+
+// Nodes are numbered by their lowest rank in comm. Returns comm split in the order of the Cartesian
+// ranks the placement assigns, and leaves the node of this rank in rank_nodes_[0].
+MPI_Comm MpiGrid2D::PlaceByNode(MPI_Comm comm) {
+  MPI_Comm shared;
+  int comm_rank, local_rank, local_size, leader;
+
+  MPI_Comm_rank(comm, &comm_rank);
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, comm_rank, MPI_INFO_NULL, &shared);
+  MPI_Comm_rank(shared, &local_rank);
+  MPI_Comm_size(shared, &local_size);
+  leader = comm_rank;
+  MPI_Bcast(&leader, 1, MPI_INT, 0, shared);
+  MPI_Comm_free(&shared);
+
+  std::vector<int> leaders(size_);
+  std::vector<int> local_sizes(size_);
+  MPI_Allgather(&leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, comm);
+  MPI_Allgather(&local_size, 1, MPI_INT, local_sizes.data(), 1, MPI_INT, comm);
+  std::vector<int> node_leaders{leaders};
+  std::sort(node_leaders.begin(), node_leaders.end());
+  node_leaders.erase(std::unique(node_leaders.begin(), node_leaders.end()), node_leaders.end());
+  nodes_ = static_cast<int>(node_leaders.size());
+  int node = static_cast<int>(std::lower_bound(node_leaders.begin(), node_leaders.end(), leader) - node_leaders.begin());
+  rank_nodes_.assign(1, node);
+
+  bool uniform = std::all_of(local_sizes.begin(), local_sizes.end(),
+                             [&](int n) { return n == local_sizes[0]; });
+  int key = comm_rank;
+  if (uniform && NodeBlock(dims_, local_size, node_block_)) {
+    int blocks_per_row = dims_[1] / node_block_[1];
+    int coord0 = (node / blocks_per_row) * node_block_[0] + local_rank / node_block_[1];
+    int coord1 = (node % blocks_per_row) * node_block_[1] + local_rank % node_block_[1];
+    key = coord0 * dims_[1] + coord1;
+  } else {
+    node_block_[0] = 0;
+    node_block_[1] = 0;
+  }
+
+  MPI_Comm placed;
+  MPI_Comm_split(comm, 0, key, &placed);
+  return placed;
+}
+
+// Byte offset of row i of the rows x cols block of this rank in the file of the global grid. The
+// arithmetic is done in MPI_Offset, the file of a 50k x 50k grid of pairs is 40 GB.
+MPI_Offset RowOffset(const MpiGrid2D& mpi_grid, size_t rows, size_t cols, size_t i, size_t element_size) {
+  auto global_row = static_cast<MPI_Offset>(mpi_grid.row()) * static_cast<MPI_Offset>(rows)
+                    + static_cast<MPI_Offset>(i);
+  auto global_cols = static_cast<MPI_Offset>(mpi_grid.cols()) * static_cast<MPI_Offset>(cols);
+  auto col = static_cast<MPI_Offset>(mpi_grid.col()) * static_cast<MPI_Offset>(cols);
+
+  return (global_row * global_cols + col) * static_cast<MPI_Offset>(element_size);
+}
+
 template<typename T>
 void WriteGridBinary(Grid<T>& grid, const std::string& filename, MpiGrid2D& mpi_grid) {
   MPI_File file;
-  MPI_Offset file_size = mpi_grid.rows() * grid.rows() * mpi_grid.cols() * grid.cols() * sizeof(T);
-  MPI_Offset row_size = grid.cols() * sizeof(T);
-  MPI_Offset row_offset;
+  MPI_Offset file_size = static_cast<MPI_Offset>(mpi_grid.rows()) * static_cast<MPI_Offset>(grid.rows())
+                         * static_cast<MPI_Offset>(mpi_grid.cols()) * static_cast<MPI_Offset>(grid.cols())
+                         * static_cast<MPI_Offset>(sizeof(T));
   int mode = MPI_MODE_CREATE | MPI_MODE_WRONLY;
 
   mpi_grid.CreateRowType(grid.cols(), MpiType<T>());
@@ -249,8 +431,7 @@ void WriteGridBinary(Grid<T>& grid, const std::string& filename, MpiGrid2D& mpi_
   MPI_File_set_size(file, file_size);
 
   for (size_t i = 0; i < grid.rows(); ++i) {
-    row_offset = (i + mpi_grid.row() * grid.rows()) * mpi_grid.cols() + mpi_grid.col();
-    MPI_File_write_at(file, row_offset * row_size, grid.data(i, 0), 1,
+    MPI_File_write_at(file, RowOffset(mpi_grid, grid.rows(), grid.cols(), i, sizeof(T)), grid.data(i, 0), 1,
                       mpi_grid.row_type(), MPI_STATUS_IGNORE);
   }
 
@@ -260,7 +441,7 @@ void WriteGridBinary(Grid<T>& grid, const std::string& filename, MpiGrid2D& mpi_
 
 template<typename T>
 void WriteGridBinary(Grid<std::pair<T, T>>& grid, const std::string& filename, MpiGrid2D& mpi_grid) {
-  Grid<T> unpaired_grid{grid.rows(), 2 * grid.cols()};
+  Grid<T> unpaired_grid{grid.rows(), 2 * grid.cols(), grid.resource()};
 
   #pragma omp parallel for default(none) collapse(2) shared(grid, unpaired_grid)
   for (size_t i = 0; i < grid.rows(); ++i) {
@@ -273,6 +454,29 @@ void WriteGridBinary(Grid<std::pair<T, T>>& grid, const std::string& filename, M
   WriteGridBinary(unpaired_grid, filename, mpi_grid);
 }
 
+void ReduceProfile(Profiler& profiler, MpiGrid2D& mpi_grid) {
+  std::array<double, kNumPhases> totals = profiler.totals();
+  std::array<double, kNumPhases> min{}, max{}, sum{};
+  std::array<PhaseStats, kNumPhases> stats{};
+
+  MPI_Allreduce(totals.data(), min.data(), kNumPhases, MPI_DOUBLE, MPI_MIN, mpi_grid.comm());
+  MPI_Allreduce(totals.data(), max.data(), kNumPhases, MPI_DOUBLE, MPI_MAX, mpi_grid.comm());
+  MPI_Allreduce(totals.data(), sum.data(), kNumPhases, MPI_DOUBLE, MPI_SUM, mpi_grid.comm());
+
+  for (size_t p = 0; p < kNumPhases; ++p) {
+    stats[p] = {min[p], max[p], sum[p] / mpi_grid.size()};
+  }
+  profiler.rank_stats(stats, mpi_grid.size());
+}
+
+HaloTraffic ReduceHaloTraffic(const HaloTraffic& traffic, MpiGrid2D& mpi_grid) {
+  unsigned long long local[2] = {traffic.intra_node_bytes, traffic.inter_node_bytes};
+  unsigned long long global[2];
+
+  MPI_Allreduce(local, global, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM, mpi_grid.comm());
+  return {global[0], global[1]};
+}
+
 template<typename T>
 static inline MPI_Datatype MpiType() {
   if (std::is_same<T, signed short>::value) {
@@ -326,4 +530,95 @@ static inline MPI_Datatype MpiType() {
   }
 }
 
+// Initializes MPI unless the caller already has and returns whether it was initialized before.
+// Only the master thread makes MPI calls, so anything below MPI_THREAD_FUNNELED is rejected.
+int InitializeMpi(int* argc, char*** argv) {
+  int initialized;
+  int provided;
+
+  MPI_Initialized(&initialized);
+  if (initialized) {
+    MPI_Query_thread(&provided);
+  } else {
+    MPI_Init_thread(argc, argv, MPI_THREAD_FUNNELED, &provided);
+  }
+  if (provided < MPI_THREAD_FUNNELED) {
+    if (!initialized) {
+      MPI_Finalize();
+    }
+    throw std::runtime_error("MPI provides thread level " + std::to_string(provided)
+                             + ", at least MPI_THREAD_FUNNELED is required");
+  }
+
+  return initialized;
+}
+
+// Narrows an element count for an MPI call that cannot take a derived type instead.
+int MpiCount(size_t count) {
+  if (count > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    throw std::overflow_error("Count " + std::to_string(count) + " exceeds the range of MPI counts");
+  }
+  return static_cast<int>(count);
+}
+
+// Committed type of count consecutive elements of type, to be sent with a count of one. Counts
+// beyond MpiGrid2D::count_limit() become a vector of full chunks followed by the remainder.
+MPI_Datatype ContiguousType(size_t count, MPI_Datatype type) {
+  size_t limit = MpiGrid2D::count_limit();
+  MPI_Datatype result;
+
+  if (count <= limit) {
+    MPI_Type_contiguous(static_cast<int>(count), type, &result);
+  } else {
+    MPI_Aint lower_bound, extent;
+    MPI_Datatype chunk, chunks;
+
+    MPI_Type_get_extent(type, &lower_bound, &extent);
+    MPI_Type_contiguous(static_cast<int>(limit), type, &chunk);
+    MPI_Type_contiguous(MpiCount(count / limit), chunk, &chunks);
+    MPI_Type_free(&chunk);
+    if (count % limit == 0) {
+      result = chunks;
+    } else {
+      MPI_Datatype remainder;
+      MPI_Type_contiguous(static_cast<int>(count % limit), type, &remainder);
+      int lengths[2] = {1, 1};
+      MPI_Aint displacements[2] = {0, static_cast<MPI_Aint>(count / limit * limit) * extent};
+      MPI_Datatype types[2] = {chunks, remainder};
+      MPI_Type_create_struct(2, lengths, displacements, types, &result);
+      MPI_Type_free(&chunks);
+      MPI_Type_free(&remainder);
+    }
+  }
+  MPI_Type_commit(&result);
+
+  return result;
+}
+
+// Neumaier's variant of Kahan summation, the rounding error of every addition is collected in
+// total_compensation and sum + total_compensation is the compensated result.
+template<typename T>
+inline void CompensatedAdd(T value, T compensation, T& sum, T& total_compensation) {
+  T total = sum + value;
+
+  if (std::abs(sum) >= std::abs(value)) {
+    total_compensation += (sum - total) + value;
+  } else {
+    total_compensation += (value - total) + sum;
+  }
+  total_compensation += compensation;
+  sum = total;
+}
+
+// Reduction over pairs of (sum, compensation) of T, for MPI_Op_create.
+template<typename T>
+void CompensatedSumOp(void* in, void* inout, int* len, [[maybe_unused]] MPI_Datatype* type) {
+  const T* values = static_cast<const T*>(in);
+  T* sums = static_cast<T*>(inout);
+
+  for (int n = 0; n < *len; ++n) {
+    CompensatedAdd(values[2 * n], values[2 * n + 1], sums[2 * n], sums[2 * n + 1]);
+  }
+}
+
 } // namespace fluid_dynamics
@@ -0,0 +1,63 @@
+// File: inc/poisson2d/fluid_dynamics/perf_counters.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_PERF_COUNTERS_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_PERF_COUNTERS_H_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace fluid_dynamics {
+
+struct CounterValues {
+  uint64_t cycles;
+  uint64_t instructions;
+  uint64_t llc_misses;
+
+  CounterValues& operator+=(const CounterValues& other);
+  CounterValues operator-(const CounterValues& other) const;
+}; // struct CounterValues
+
+// Hardware counters of the calling thread and of all threads it spawns afterwards, so the
+// counters have to be opened before the first OpenMP parallel region. Counters that cannot be
+// opened, e.g. in containers with perf_event_paranoid > 2, read as 0 and available() is false.
+class PerfCounters {
+ public:
+  PerfCounters();
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters(PerfCounters&&) noexcept = delete;
+  ~PerfCounters();
+
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  PerfCounters& operator=(PerfCounters&&) noexcept = delete;
+
+  [[nodiscard]] bool available() const;
+  [[nodiscard]] bool llc_available() const;
+
+  [[nodiscard]] CounterValues Read() const;
+
+  static constexpr uint64_t kCacheLineSize = 64;
+
+ private:
+  std::array<int, 3> fds_;
+
+  static int Open(uint32_t type, uint64_t config);
+  [[nodiscard]] uint64_t ReadCounter(int fd) const;
+}; // class PerfCounters
+
+// STREAM triad a = b + s * c over arrays of the given size, returns the best bandwidth in bytes/s.
+double MeasureStreamBandwidth(size_t bytes_per_array = size_t{1} << 26, int repetitions = 5);
+
+} // namespace fluid_dynamics
+
+#include "perf_counters.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_PERF_COUNTERS_H_
@@ -0,0 +1,98 @@
+// File: inc/poisson2d/fluid_dynamics/perf_counters.tpp
+namespace fluid_dynamics {
+
+inline CounterValues& CounterValues::operator+=(const CounterValues& other) {
+  cycles += other.cycles;
+  instructions += other.instructions;
+  llc_misses += other.llc_misses;
+  return *this;
+}
+
+inline CounterValues CounterValues::operator-(const CounterValues& other) const {
+  return {cycles - other.cycles, instructions - other.instructions, llc_misses - other.llc_misses};
+}
+
+inline PerfCounters::PerfCounters() : fds_{-1, -1, -1} {
+#ifdef __linux__
+  fds_[0] = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  fds_[1] = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  fds_[2] = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+}
+
+inline PerfCounters::~PerfCounters() {
+#ifdef __linux__
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+inline bool PerfCounters::available() const {
+  return fds_[0] >= 0 && fds_[1] >= 0;
+}
+
+inline bool PerfCounters::llc_available() const {
+  return fds_[2] >= 0;
+}
+
+inline CounterValues PerfCounters::Read() const {
+  return {ReadCounter(fds_[0]), ReadCounter(fds_[1]), ReadCounter(fds_[2])};
+}
+
+inline int PerfCounters::Open(uint32_t type, uint64_t config) {
+#ifdef __linux__
+  perf_event_attr attr{};
+
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+  return -1;
+#endif
+}
+
+inline uint64_t PerfCounters::ReadCounter(int fd) const {
+  uint64_t value = 0;
+
+#ifdef __linux__
+  if (fd >= 0 && read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+    value = 0;
+  }
+#endif
+
+  return value;
+}
+
+inline double MeasureStreamBandwidth(size_t bytes_per_array, int repetitions) {
+  size_t n = bytes_per_array / sizeof(double);
+  std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+  double scalar = 3.0;
+  double best = 0.0;
+
+  for (int r = 0; r < repetitions; ++r) {
+    auto start = std::chrono::steady_clock::now();
+#ifdef _OPENMP
+    #pragma omp parallel for default(none) shared(a, b, c, scalar, n) schedule(static)
+#endif
+    for (size_t i = 0; i < n; ++i) {
+      a[i] = b[i] + scalar * c[i];
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (elapsed.count() > 0.0) {
+      best = std::max(best, 3.0 * static_cast<double>(n * sizeof(double)) / elapsed.count());
+    }
+  }
+
+  return best;
+}
+
+} // namespace fluid_dynamics
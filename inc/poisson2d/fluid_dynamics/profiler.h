@@ -0,0 +1,141 @@
+// File: inc/poisson2d/fluid_dynamics/profiler.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_PROFILER_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_PROFILER_H_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "perf_counters.h"
+
+// Instrumentation is compiled in only when FDSIM_PROFILING is defined, otherwise the macros
+// expand to nothing and the solvers carry an empty Profiler.
+#ifdef FDSIM_PROFILING
+#define FDSIM_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FDSIM_PROFILE_CONCAT(a, b) FDSIM_PROFILE_CONCAT_IMPL(a, b)
+#define FDSIM_PROFILE_SCOPE(profiler, phase) \
+  ::fluid_dynamics::ScopedTimer FDSIM_PROFILE_CONCAT(fdsim_scoped_timer_, __LINE__){(profiler), (phase)}
+#define FDSIM_PROFILE_ITERATION(profiler, norm) (profiler).EndIteration(static_cast<double>(norm))
+#define FDSIM_PROFILE_WORKLOAD(profiler, phase, bytes, flops) \
+  (profiler).workload((phase), static_cast<double>(bytes), static_cast<double>(flops))
+#else
+#define FDSIM_PROFILE_SCOPE(profiler, phase) static_cast<void>(0)
+#define FDSIM_PROFILE_ITERATION(profiler, norm) static_cast<void>(0)
+#define FDSIM_PROFILE_WORKLOAD(profiler, phase, bytes, flops) static_cast<void>(0)
+#endif
+
+namespace fluid_dynamics {
+
+enum class Phase : size_t {
+  kHaloExchange,
+  kStencil,
+  kNorm,
+  kAllreduce,
+  kIo
+}; // enum class Phase
+
+inline constexpr size_t kNumPhases = 5;
+
+struct IterationProfile {
+  double norm;
+  std::array<double, kNumPhases> times;
+  std::array<CounterValues, kNumPhases> counters;
+}; // struct IterationProfile
+
+// Modelled memory traffic and floating point operations of one execution of a phase.
+struct PhaseWorkload {
+  double bytes;
+  double flops;
+}; // struct PhaseWorkload
+
+struct PhaseStats {
+  double min;
+  double max;
+  double mean;
+}; // struct PhaseStats
+
+class Profiler {
+ public:
+  Profiler();
+  Profiler(const Profiler&) = default;
+  Profiler(Profiler&&) noexcept = default;
+  ~Profiler() = default;
+
+  Profiler& operator=(const Profiler&) = default;
+  Profiler& operator=(Profiler&&) noexcept = default;
+
+  [[nodiscard]] const std::vector<IterationProfile>& iterations() const;
+  [[nodiscard]] std::array<double, kNumPhases> totals() const;
+  [[nodiscard]] int ranks() const;
+  [[nodiscard]] const std::array<PhaseStats, kNumPhases>& rank_stats() const;
+  [[nodiscard]] bool counters_available() const;
+  [[nodiscard]] double stream_bandwidth() const;
+
+  void rank_stats(const std::array<PhaseStats, kNumPhases>& stats, int ranks);
+  void workload(Phase phase, double bytes, double flops);
+  void stream_bandwidth(double bytes_per_second);
+
+  void EnableCounters();
+  [[nodiscard]] CounterValues ReadCounters() const;
+
+  void Add(Phase phase, double seconds, const CounterValues& counters = {});
+  void EndIteration(double norm);
+  void Reset();
+
+  void WriteJson(std::ostream& out) const;
+  void WriteCsv(std::ostream& out) const;
+  void WriteReport(const std::string& filename) const;
+  void WriteSummary(std::ostream& out) const;
+
+  static const char* PhaseName(Phase phase);
+
+ private:
+  struct alignas(64) ThreadTimes {
+    std::array<double, kNumPhases> times;
+    std::array<CounterValues, kNumPhases> counters;
+  }; // struct ThreadTimes
+
+  std::vector<ThreadTimes> pending_;
+  std::vector<IterationProfile> iterations_;
+  std::array<double, kNumPhases> totals_;
+  std::array<CounterValues, kNumPhases> counter_totals_;
+  std::array<PhaseStats, kNumPhases> rank_stats_;
+  int ranks_;
+  std::array<PhaseWorkload, kNumPhases> workload_;
+  std::shared_ptr<PerfCounters> counters_;
+  double stream_bandwidth_;
+
+  [[nodiscard]] IterationProfile Pending() const;
+  void ClearPending();
+}; // class Profiler
+
+class ScopedTimer {
+ public:
+  ScopedTimer(Profiler& profiler, Phase phase);
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer(ScopedTimer&&) noexcept = delete;
+  ~ScopedTimer();
+
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(ScopedTimer&&) noexcept = delete;
+
+ private:
+  Profiler& profiler_;
+  Phase phase_;
+  CounterValues counters_;
+  std::chrono::steady_clock::time_point start_;
+}; // class ScopedTimer
+
+} // namespace fluid_dynamics
+
+#include "profiler.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_PROFILER_H_
@@ -0,0 +1,294 @@
+// File: inc/poisson2d/fluid_dynamics/profiler.tpp
+namespace fluid_dynamics {
+
+inline Profiler::Profiler()
+    : pending_{}, iterations_{}, totals_{}, counter_totals_{}, rank_stats_{}, ranks_{0}, workload_{},
+      counters_{nullptr}, stream_bandwidth_{0.0} {
+#ifdef _OPENMP
+  pending_.resize(static_cast<size_t>(omp_get_max_threads()));
+#else
+  pending_.resize(1);
+#endif
+}
+
+inline const std::vector<IterationProfile>& Profiler::iterations() const {
+  return iterations_;
+}
+
+inline std::array<double, kNumPhases> Profiler::totals() const {
+  std::array<double, kNumPhases> totals = Pending().times;
+
+  for (size_t p = 0; p < kNumPhases; ++p) {
+    totals[p] += totals_[p];
+  }
+
+  return totals;
+}
+
+inline int Profiler::ranks() const {
+  return ranks_;
+}
+
+inline const std::array<PhaseStats, kNumPhases>& Profiler::rank_stats() const {
+  return rank_stats_;
+}
+
+inline bool Profiler::counters_available() const {
+  return counters_ != nullptr && counters_->available();
+}
+
+inline double Profiler::stream_bandwidth() const {
+  return stream_bandwidth_;
+}
+
+inline void Profiler::rank_stats(const std::array<PhaseStats, kNumPhases>& stats, int ranks) {
+  rank_stats_ = stats;
+  ranks_ = ranks;
+}
+
+inline void Profiler::workload(Phase phase, double bytes, double flops) {
+  workload_[static_cast<size_t>(phase)] = {bytes, flops};
+}
+
+inline void Profiler::stream_bandwidth(double bytes_per_second) {
+  stream_bandwidth_ = bytes_per_second;
+}
+
+inline void Profiler::EnableCounters() {
+  if (counters_ == nullptr) {
+    counters_ = std::make_shared<PerfCounters>();
+  }
+}
+
+inline CounterValues Profiler::ReadCounters() const {
+  return counters_ != nullptr ? counters_->Read() : CounterValues{};
+}
+
+inline void Profiler::Add(Phase phase, double seconds, const CounterValues& counters) {
+  size_t thread = 0;
+
+#ifdef _OPENMP
+  thread = static_cast<size_t>(omp_get_thread_num());
+#endif
+  if (thread < pending_.size()) {
+    pending_[thread].times[static_cast<size_t>(phase)] += seconds;
+    pending_[thread].counters[static_cast<size_t>(phase)] += counters;
+  }
+}
+
+// Called outside of parallel regions. Threads work on a phase concurrently, so the slowest
+// thread determines the time of the iteration.
+inline void Profiler::EndIteration(double norm) {
+  IterationProfile iteration = Pending();
+
+  iteration.norm = norm;
+  ClearPending();
+  for (size_t p = 0; p < kNumPhases; ++p) {
+    totals_[p] += iteration.times[p];
+    counter_totals_[p] += iteration.counters[p];
+  }
+  iterations_.push_back(iteration);
+}
+
+inline void Profiler::Reset() {
+  ClearPending();
+  iterations_.clear();
+  totals_.fill(0.0);
+  counter_totals_.fill({});
+  rank_stats_ = {};
+  ranks_ = 0;
+}
+
+inline void Profiler::WriteJson(std::ostream& out) const {
+  std::array<double, kNumPhases> totals = this->totals();
+  auto num_iterations = static_cast<double>(iterations_.size());
+
+  out << "{\n  \"iterations\": " << iterations_.size() << ",\n  \"totals\": {";
+  for (size_t p = 0; p < kNumPhases; ++p) {
+    out << (p == 0 ? "" : ", ") << "\"" << PhaseName(static_cast<Phase>(p)) << "\": " << totals[p];
+  }
+  out << "},\n";
+
+  out << "  \"stream_gb_s\": " << stream_bandwidth_ * 1e-9 << ",\n  \"counters_available\": "
+      << (counters_available() ? "true" : "false") << ",\n  \"roofline\": {";
+  for (size_t p = 0, first = 1; p < kNumPhases; ++p) {
+    if (workload_[p].bytes <= 0.0 || totals[p] <= 0.0) {
+      continue;
+    }
+    out << (first ? "\n" : ",\n") << "    \"" << PhaseName(static_cast<Phase>(p)) << "\": {"
+        << "\"gb_s\": " << workload_[p].bytes * num_iterations / totals[p] * 1e-9
+        << ", \"gflop_s\": " << workload_[p].flops * num_iterations / totals[p] * 1e-9;
+    if (counters_available()) {
+      const CounterValues& counters = counter_totals_[p];
+      out << ", \"ipc\": " << (counters.cycles > 0 ? static_cast<double>(counters.instructions) / counters.cycles : 0.0)
+          << ", \"llc_misses\": " << counters.llc_misses
+          << ", \"dram_gb_s\": " << static_cast<double>(counters.llc_misses * PerfCounters::kCacheLineSize) / totals[p] * 1e-9;
+    }
+    out << "}";
+    first = 0;
+  }
+  out << "\n  },\n";
+
+  if (ranks_ > 0) {
+    out << "  \"ranks\": " << ranks_ << ",\n  \"rank_stats\": {";
+    for (size_t p = 0; p < kNumPhases; ++p) {
+      const PhaseStats& stats = rank_stats_[p];
+      out << (p == 0 ? "\n" : ",\n") << "    \"" << PhaseName(static_cast<Phase>(p)) << "\": {"
+          << "\"min\": " << stats.min << ", \"max\": " << stats.max << ", \"mean\": " << stats.mean
+          << ", \"imbalance\": " << (stats.mean > 0.0 ? stats.max / stats.mean : 1.0) << "}";
+    }
+    out << "\n  },\n";
+  }
+
+  out << "  \"history\": [";
+  for (size_t i = 0; i < iterations_.size(); ++i) {
+    const IterationProfile& iteration = iterations_[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"iteration\": " << i << ", \"residual\": " << iteration.norm;
+    for (size_t p = 0; p < kNumPhases; ++p) {
+      out << ", \"" << PhaseName(static_cast<Phase>(p)) << "\": " << iteration.times[p];
+    }
+    for (size_t p = 0; p < kNumPhases; ++p) {
+      if (workload_[p].bytes > 0.0 && iteration.times[p] > 0.0) {
+        out << ", \"" << PhaseName(static_cast<Phase>(p)) << "_gb_s\": " << workload_[p].bytes / iteration.times[p] * 1e-9
+            << ", \"" << PhaseName(static_cast<Phase>(p)) << "_gflop_s\": " << workload_[p].flops / iteration.times[p] * 1e-9;
+      }
+    }
+    if (counters_available()) {
+      for (size_t p = 0; p < kNumPhases; ++p) {
+        out << ", \"" << PhaseName(static_cast<Phase>(p)) << "_cycles\": " << iteration.counters[p].cycles
+            << ", \"" << PhaseName(static_cast<Phase>(p)) << "_instructions\": " << iteration.counters[p].instructions
+            << ", \"" << PhaseName(static_cast<Phase>(p)) << "_llc_misses\": " << iteration.counters[p].llc_misses;
+      }
+    }
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+inline void Profiler::WriteCsv(std::ostream& out) const {
+  out << "iteration,residual";
+  for (size_t p = 0; p < kNumPhases; ++p) {
+    out << "," << PhaseName(static_cast<Phase>(p));
+  }
+  for (size_t p = 0; p < kNumPhases; ++p) {
+    out << "," << PhaseName(static_cast<Phase>(p)) << "_gb_s," << PhaseName(static_cast<Phase>(p)) << "_gflop_s";
+  }
+  if (counters_available()) {
+    for (size_t p = 0; p < kNumPhases; ++p) {
+      out << "," << PhaseName(static_cast<Phase>(p)) << "_cycles," << PhaseName(static_cast<Phase>(p)) << "_instructions,"
+          << PhaseName(static_cast<Phase>(p)) << "_llc_misses";
+    }
+  }
+  out << "\n";
+
+  for (size_t i = 0; i < iterations_.size(); ++i) {
+    const IterationProfile& iteration = iterations_[i];
+    out << i << "," << iteration.norm;
+    for (size_t p = 0; p < kNumPhases; ++p) {
+      out << "," << iteration.times[p];
+    }
+    for (size_t p = 0; p < kNumPhases; ++p) {
+      double time = iteration.times[p];
+      out << "," << (time > 0.0 ? workload_[p].bytes / time * 1e-9 : 0.0)
+          << "," << (time > 0.0 ? workload_[p].flops / time * 1e-9 : 0.0);
+    }
+    if (counters_available()) {
+      for (size_t p = 0; p < kNumPhases; ++p) {
+        out << "," << iteration.counters[p].cycles << "," << iteration.counters[p].instructions
+            << "," << iteration.counters[p].llc_misses;
+      }
+    }
+    out << "\n";
+  }
+}
+
+inline void Profiler::WriteReport(const std::string& filename) const {
+  std::ofstream file(filename);
+
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  if (filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".csv") == 0) {
+    WriteCsv(file);
+  } else {
+    WriteJson(file);
+  }
+  file.close();
+}
+
+inline void Profiler::WriteSummary(std::ostream& out) const {
+  std::array<double, kNumPhases> totals = this->totals();
+  auto num_iterations = static_cast<double>(iterations_.size());
+
+  if (stream_bandwidth_ > 0.0) {
+    out << "STREAM triad bandwidth: " << stream_bandwidth_ * 1e-9 << " GB/s" << std::endl;
+  }
+  for (size_t p = 0; p < kNumPhases; ++p) {
+    if (workload_[p].bytes <= 0.0 || totals[p] <= 0.0) {
+      continue;
+    }
+    double bandwidth = workload_[p].bytes * num_iterations / totals[p];
+    out << PhaseName(static_cast<Phase>(p)) << ": " << bandwidth * 1e-9 << " GB/s, "
+        << workload_[p].flops * num_iterations / totals[p] * 1e-9 << " GFLOP/s";
+    if (stream_bandwidth_ > 0.0) {
+      out << " (" << 100.0 * bandwidth / stream_bandwidth_ << "% of STREAM)";
+    }
+    if (counters_available()) {
+      const CounterValues& counters = counter_totals_[p];
+      out << ", IPC " << (counters.cycles > 0 ? static_cast<double>(counters.instructions) / counters.cycles : 0.0);
+    } else {
+      out << ", hardware counters unavailable";
+    }
+    out << std::endl;
+  }
+}
+
+inline const char* Profiler::PhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::kHaloExchange:
+      return "halo_exchange";
+    case Phase::kStencil:
+      return "stencil";
+    case Phase::kNorm:
+      return "norm";
+    case Phase::kAllreduce:
+      return "allreduce";
+    case Phase::kIo:
+      return "io";
+  }
+  return "unknown";
+}
+
+inline IterationProfile Profiler::Pending() const {
+  IterationProfile pending{};
+
+  for (const ThreadTimes& thread : pending_) {
+    for (size_t p = 0; p < kNumPhases; ++p) {
+      pending.times[p] = std::max(pending.times[p], thread.times[p]);
+      pending.counters[p].cycles = std::max(pending.counters[p].cycles, thread.counters[p].cycles);
+      pending.counters[p].instructions = std::max(pending.counters[p].instructions, thread.counters[p].instructions);
+      pending.counters[p].llc_misses = std::max(pending.counters[p].llc_misses, thread.counters[p].llc_misses);
+    }
+  }
+
+  return pending;
+}
+
+inline void Profiler::ClearPending() {
+  for (ThreadTimes& thread : pending_) {
+    thread.times.fill(0.0);
+    thread.counters.fill({});
+  }
+}
+
+inline ScopedTimer::ScopedTimer(Profiler& profiler, Phase phase)
+    : profiler_{profiler}, phase_{phase}, counters_{profiler.ReadCounters()},
+      start_{std::chrono::steady_clock::now()} {}
+
+inline ScopedTimer::~ScopedTimer() {
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+  profiler_.Add(phase_, elapsed.count(), profiler_.ReadCounters() - counters_);
+}
+
+} // namespace fluid_dynamics
@@ -0,0 +1,25 @@
+// File: inc/poisson2d/fluid_dynamics/resident_memory.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_RESIDENT_MEMORY_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_RESIDENT_MEMORY_H_
+
+#include <cstddef>
+#ifdef __linux__
+#include <fstream>
+#include <string>
+#endif
+
+namespace fluid_dynamics {
+
+// Peak resident set size of the process in bytes, VmHWM of /proc/self/status. Reads as 0 where it
+// is not available.
+size_t PeakResidentMemory();
+
+// Lowers the peak resident set size to the current one, so the next PeakResidentMemory covers only
+// what runs in between. Has no effect on kernels without /proc/self/clear_refs.
+void ResetPeakResidentMemory();
+
+} // namespace fluid_dynamics
+
+#include "resident_memory.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_RESIDENT_MEMORY_H_
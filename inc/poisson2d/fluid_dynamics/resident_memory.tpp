@@ -0,0 +1,32 @@
+// File: inc/poisson2d/fluid_dynamics/resident_memory.tpp
+namespace fluid_dynamics {
+
+inline size_t PeakResidentMemory() {
+  size_t kilobytes = 0;
+
+#ifdef __linux__
+  std::ifstream status{"/proc/self/status"};
+  std::string line;
+
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      kilobytes = std::stoul(line.substr(6));
+      break;
+    }
+  }
+#endif
+
+  return kilobytes * 1024;
+}
+
+inline void ResetPeakResidentMemory() {
+#ifdef __linux__
+  std::ofstream clear_refs{"/proc/self/clear_refs"};
+
+  if (clear_refs) {
+    clear_refs << "5";
+  }
+#endif
+}
+
+} // namespace fluid_dynamics
@@ -0,0 +1,53 @@
+// File: inc/poisson2d/fluid_dynamics/row_window.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_ROW_WINDOW_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_ROW_WINDOW_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace fluid_dynamics {
+
+// The old values of the rows a stencil of the given radius reads while a grid is relaxed in place
+// row by row. Rows are pushed before they are overwritten and stored contiguously with the width of
+// the grid, so a stencil centred on a row of the window reads the same values it would read from a
+// copy of the whole grid. Once full, the window keeps its last 2 * radius rows and slides forward.
+template<typename T>
+class RowWindow {
+ public:
+  RowWindow();
+  RowWindow(const RowWindow&) = default;
+  RowWindow(RowWindow&&) noexcept = default;
+  RowWindow(size_t radius, size_t cols, size_t depth = kDefaultDepth);
+  ~RowWindow() = default;
+
+  RowWindow& operator=(const RowWindow&) = default;
+  RowWindow& operator=(RowWindow&&) noexcept = default;
+
+  [[nodiscard]] size_t radius() const;
+  [[nodiscard]] size_t cols() const;
+  [[nodiscard]] size_t capacity() const;
+  [[nodiscard]] size_t first() const;
+  [[nodiscard]] size_t end() const;
+  [[nodiscard]] size_t bytes() const;
+  [[nodiscard]] const T* row(size_t i) const;
+
+  void Reset(size_t first);
+  void Push(const T* row);
+
+ private:
+  static constexpr size_t kDefaultDepth = 16;
+
+  size_t radius_;
+  size_t cols_;
+  size_t capacity_;
+  size_t first_;
+  size_t count_;
+  std::vector<T> rows_;
+}; // class RowWindow
+
+} // namespace fluid_dynamics
+
+#include "row_window.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_ROW_WINDOW_H_
@@ -0,0 +1,70 @@
+// File: inc/poisson2d/fluid_dynamics/row_window.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+RowWindow<T>::RowWindow() : radius_{0}, cols_{0}, capacity_{0}, first_{0}, count_{0} {}
+
+// Holds depth rows beyond the 2 * radius + 1 a stencil needs, so the rows kept on a slide are
+// copied once every depth rows.
+template<typename T>
+RowWindow<T>::RowWindow(size_t radius, size_t cols, size_t depth)
+    : radius_{radius}, cols_{cols}, capacity_{2 * radius + 1 + depth}, first_{0}, count_{0},
+      rows_(capacity_ * cols) {}
+
+template<typename T>
+size_t RowWindow<T>::radius() const {
+  return radius_;
+}
+
+template<typename T>
+size_t RowWindow<T>::cols() const {
+  return cols_;
+}
+
+template<typename T>
+size_t RowWindow<T>::capacity() const {
+  return capacity_;
+}
+
+template<typename T>
+size_t RowWindow<T>::first() const {
+  return first_;
+}
+
+// One past the last row pushed.
+template<typename T>
+size_t RowWindow<T>::end() const {
+  return first_ + count_;
+}
+
+template<typename T>
+size_t RowWindow<T>::bytes() const {
+  return rows_.size() * sizeof(T);
+}
+
+// Row i of the grid, which has to be one of the last 2 * radius + 1 rows pushed.
+template<typename T>
+const T* RowWindow<T>::row(size_t i) const {
+  return rows_.data() + (i - first_) * cols_;
+}
+
+// Empties the window, the next row pushed is row first of the grid.
+template<typename T>
+void RowWindow<T>::Reset(size_t first) {
+  first_ = first;
+  count_ = 0;
+}
+
+template<typename T>
+void RowWindow<T>::Push(const T* row) {
+  if (count_ == capacity_) {
+    size_t keep = std::min(2 * radius_, count_);
+    std::copy_n(rows_.data() + (count_ - keep) * cols_, keep * cols_, rows_.data());
+    first_ += count_ - keep;
+    count_ = keep;
+  }
+  std::copy_n(row, cols_, rows_.data() + count_ * cols_);
+  ++count_;
+}
+
+} // namespace fluid_dynamics
@@ -0,0 +1,82 @@
+// File: inc/poisson2d/fluid_dynamics/solution_cache.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLUTION_CACHE_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLUTION_CACHE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+#include "grid.h"
+#include "bound.h"
+
+namespace fluid_dynamics {
+
+// The geometry fingerprint hashes which boundary covers every cell, the boundary values are kept
+// to measure how close two problems with the same geometry are.
+template<typename T>
+struct SolutionKey {
+  size_t rows;
+  size_t cols;
+  uint64_t geometry;
+  std::vector<T> values;
+}; // struct SolutionKey
+
+template<typename T>
+struct CachedSolution {
+  Grid<T> solution;
+  size_t iterations;
+  bool prolongated;
+}; // struct CachedSolution
+
+// Keeps the most recently used solutions. Lookup returns the solution of the same geometry with the
+// closest boundary values, or otherwise prolongates the finest coarser solution in the cache.
+// The iterations of an entry are those of a cold start, estimated for prolongated guesses.
+template<typename T>
+class SolutionCache {
+ public:
+  SolutionCache();
+  SolutionCache(const SolutionCache&) = default;
+  SolutionCache(SolutionCache&&) noexcept = default;
+  explicit SolutionCache(size_t capacity);
+  ~SolutionCache() = default;
+
+  SolutionCache& operator=(const SolutionCache&) = default;
+  SolutionCache& operator=(SolutionCache&&) noexcept = default;
+
+  [[nodiscard]] size_t capacity() const;
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] size_t hits() const;
+  [[nodiscard]] size_t misses() const;
+
+  std::optional<CachedSolution<T>> Lookup(const SolutionKey<T>& key);
+  void Insert(SolutionKey<T> key, const Grid<T>& solution, size_t iterations);
+  void Clear();
+
+  static SolutionKey<T> Key(size_t rows, size_t cols, const Bound<T>& bound);
+  static Grid<T> Prolongate(const Grid<T>& coarse, size_t rows, size_t cols);
+
+ private:
+  struct Entry {
+    SolutionKey<T> key;
+    Grid<T> solution;
+    size_t iterations;
+    size_t last_used;
+  }; // struct Entry
+
+  size_t capacity_;
+  size_t clock_;
+  size_t hits_;
+  size_t misses_;
+  std::vector<Entry> entries_;
+
+  static constexpr size_t kDefaultCapacity = 16;
+
+  static T Distance(const std::vector<T>& a, const std::vector<T>& b);
+}; // class SolutionCache
+
+} // namespace fluid_dynamics
+
+#include "solution_cache.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLUTION_CACHE_H_
@@ -0,0 +1,171 @@
+// File: inc/poisson2d/fluid_dynamics/solution_cache.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+SolutionCache<T>::SolutionCache()
+    : capacity_{kDefaultCapacity}, clock_{0}, hits_{0}, misses_{0} {}
+
+template<typename T>
+SolutionCache<T>::SolutionCache(size_t capacity)
+    : capacity_{capacity}, clock_{0}, hits_{0}, misses_{0} {}
+
+template<typename T>
+size_t SolutionCache<T>::capacity() const {
+  return capacity_;
+}
+
+template<typename T>
+size_t SolutionCache<T>::size() const {
+  return entries_.size();
+}
+
+template<typename T>
+size_t SolutionCache<T>::hits() const {
+  return hits_;
+}
+
+template<typename T>
+size_t SolutionCache<T>::misses() const {
+  return misses_;
+}
+
+template<typename T>
+std::optional<CachedSolution<T>> SolutionCache<T>::Lookup(const SolutionKey<T>& key) {
+  Entry* nearest = nullptr;
+  Entry* coarse = nullptr;
+  T nearest_distance = std::numeric_limits<T>::max();
+
+  for (Entry& entry : entries_) {
+    if (entry.key.rows == key.rows && entry.key.cols == key.cols) {
+      if (entry.key.geometry == key.geometry) {
+        T distance = Distance(entry.key.values, key.values);
+        if (distance < nearest_distance) {
+          nearest_distance = distance;
+          nearest = &entry;
+        }
+      }
+    } else if (entry.key.rows <= key.rows && entry.key.cols <= key.cols) {
+      if (coarse == nullptr || entry.key.rows * entry.key.cols > coarse->key.rows * coarse->key.cols
+          || (entry.key.rows * entry.key.cols == coarse->key.rows * coarse->key.cols
+              && entry.last_used > coarse->last_used)) {
+        coarse = &entry;
+      }
+    }
+  }
+
+  if (nearest != nullptr) {
+    ++hits_;
+    nearest->last_used = ++clock_;
+    return CachedSolution<T>{nearest->solution, nearest->iterations, false};
+  }
+  if (coarse != nullptr) {
+    ++hits_;
+    coarse->last_used = ++clock_;
+    double ratio = static_cast<double>(key.rows * key.cols)
+        / static_cast<double>(coarse->key.rows * coarse->key.cols);
+    return CachedSolution<T>{Prolongate(coarse->solution, key.rows, key.cols),
+                             static_cast<size_t>(static_cast<double>(coarse->iterations) * ratio), true};
+  }
+  ++misses_;
+  return std::nullopt;
+}
+
+// A problem that is already cached is replaced, otherwise the least recently used entry makes room.
+template<typename T>
+void SolutionCache<T>::Insert(SolutionKey<T> key, const Grid<T>& solution, size_t iterations) {
+  if (capacity_ == 0) {
+    return;
+  }
+
+  for (Entry& entry : entries_) {
+    if (entry.key.rows == key.rows && entry.key.cols == key.cols && entry.key.geometry == key.geometry
+        && entry.key.values == key.values) {
+      entry.solution = solution;
+      entry.iterations = iterations;
+      entry.last_used = ++clock_;
+      return;
+    }
+  }
+
+  if (entries_.size() == capacity_) {
+    auto oldest = std::min_element(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) {
+      return a.last_used < b.last_used;
+    });
+    entries_.erase(oldest);
+  }
+  entries_.push_back({std::move(key), solution, iterations, ++clock_});
+}
+
+template<typename T>
+void SolutionCache<T>::Clear() {
+  entries_.clear();
+  hits_ = 0;
+  misses_ = 0;
+}
+
+template<typename T>
+SolutionKey<T> SolutionCache<T>::Key(size_t rows, size_t cols, const Bound<T>& bound) {
+  SolutionKey<T> key{rows, cols, 0xCBF29CE484222325ULL, {}};
+  auto mix = [&key](uint64_t value) {
+    key.geometry = (key.geometry ^ value) * 0x100000001B3ULL;
+  };
+
+  mix(rows);
+  mix(cols);
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      uint64_t covered = 0;
+      for (size_t k = 0; k < bound.size(); ++k) {
+        if (bound.boundaries()[k].condition(i, j)) {
+          covered = k + 1;
+          key.values.push_back(bound.boundaries()[k].value(i, j));
+          break;
+        }
+      }
+      mix(covered);
+    }
+  }
+
+  return key;
+}
+
+// Bilinear interpolation, the corners of the coarse grid map onto the corners of the fine grid.
+template<typename T>
+Grid<T> SolutionCache<T>::Prolongate(const Grid<T>& coarse, size_t rows, size_t cols) {
+  Grid<T> fine{rows, cols};
+  double row_scale = rows > 1 ? static_cast<double>(coarse.rows() - 1) / static_cast<double>(rows - 1) : 0.0;
+  double col_scale = cols > 1 ? static_cast<double>(coarse.cols() - 1) / static_cast<double>(cols - 1) : 0.0;
+
+  for (size_t i = 0; i < rows; ++i) {
+    double x = static_cast<double>(i) * row_scale;
+    auto i0 = std::min(static_cast<size_t>(x), coarse.rows() - 1);
+    size_t i1 = std::min(i0 + 1, coarse.rows() - 1);
+    auto di = static_cast<T>(x - static_cast<double>(i0));
+    for (size_t j = 0; j < cols; ++j) {
+      double y = static_cast<double>(j) * col_scale;
+      auto j0 = std::min(static_cast<size_t>(y), coarse.cols() - 1);
+      size_t j1 = std::min(j0 + 1, coarse.cols() - 1);
+      auto dj = static_cast<T>(y - static_cast<double>(j0));
+      fine(i, j) = (1 - di) * ((1 - dj) * coarse(i0, j0) + dj * coarse(i0, j1))
+          + di * ((1 - dj) * coarse(i1, j0) + dj * coarse(i1, j1));
+    }
+  }
+
+  return fine;
+}
+
+template<typename T>
+T SolutionCache<T>::Distance(const std::vector<T>& a, const std::vector<T>& b) {
+  T distance = 0;
+
+  if (a.size() != b.size()) {
+    return std::numeric_limits<T>::max();
+  }
+  for (size_t k = 0; k < a.size(); ++k) {
+    distance += (a[k] - b[k]) * (a[k] - b[k]);
+  }
+
+  return distance;
+}
+
+} // namespace fluid_dynamics
@@ -2,18 +2,29 @@
 #ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_H_
 #define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_H_
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <cmath>
 #include <vector>
 #include <functional>
+#include <memory>
+#include <stdexcept>
 #include "grid.h"
+#include "grid_pool.h"
 #include "bound.h"
+#include "bound_mask.h"
+#include "active_set.h"
+#include "profiler.h"
+#include "resident_memory.h"
+#include "row_window.h"
+#include "solution_cache.h"
+#include "stencil.h"
 
 namespace fluid_dynamics {
 
-template<typename T>
+template<typename T, typename Stencil = FivePoint>
 class Solver {
  public:
   Solver();
@@ -29,6 +40,16 @@ class Solver {
 
   [[nodiscard]] T epsilon() const;
   [[nodiscard]] size_t max_iter() const;
+  [[nodiscard]] const Profiler& profiler() const;
+  [[nodiscard]] Profiler& profiler();
+  [[nodiscard]] size_t iterations() const;
+  [[nodiscard]] size_t iterations_saved() const;
+  [[nodiscard]] const std::shared_ptr<SolutionCache<T>>& cache() const;
+  [[nodiscard]] const std::shared_ptr<GridPool>& pool() const;
+  [[nodiscard]] const ActiveSet<T>& active_set() const;
+  [[nodiscard]] bool low_memory() const;
+  [[nodiscard]] bool report_peak_memory() const;
+  [[nodiscard]] size_t peak_memory() const;
   T norm(const Grid<T>& prev, const Grid<T>& curr, bool exclude_boundaries = false);
   T source(size_t i, size_t j);
 
@@ -36,27 +57,67 @@ class Solver {
   void max_iter(size_t max_iter);
   void norm(std::function<T(const Grid<T>&, const Grid<T>&, bool)> norm);
   void source(std::function<T(size_t, size_t)> source);
+  void source(const Grid<T>& source);
+  void source(Grid<T>&& source);
+  void source_rows(std::function<void(size_t, size_t, size_t, T*)> source_rows);
+  void cache(std::shared_ptr<SolutionCache<T>> cache);
+  void pool(std::shared_ptr<GridPool> pool);
+  void active_set(size_t tile_size, T threshold = 0);
+  void low_memory(bool low_memory);
+  void report_peak_memory(bool report_peak_memory);
 
   Grid<T> Solve(size_t rows, size_t cols, const Bound<T>& bound, bool verbose = false);
+  Grid<T> Solve(size_t rows, size_t cols, const Bound<T>& bound, const Grid<T>& initial, bool verbose = false);
   Grid<std::pair<T, T>> Gradient(const Grid<T>& field);
   virtual Grid<std::pair<T, T>> Velocity(const Grid<std::pair<T, T>>& grad);
 
  protected:
   void Progress(size_t iter, size_t max_iter);
+  void iterations(size_t iterations);
+  void peak_memory(size_t peak_memory);
+  [[nodiscard]] bool custom_norm() const;
+  [[nodiscard]] std::pmr::memory_resource* resource() const;
+
+  static T DefaultNorm(const Grid<T>& prev, const Grid<T>& curr, bool exclude_boundaries = false);
+
+  Grid<T> MaterializeSource(size_t origin_row, size_t origin_col, size_t rows, size_t cols) const;
+  Grid<T> Update(const Grid<T>& prev, const Bound<T>& bound, const Grid<T>& source);
+  Grid<T> UpdatePeriodic(const Grid<T>& prev, const Bound<T>& bound, const Grid<T>& source);
+  void UpdateTiles(const Grid<T>& prev, Grid<T>& next, const Bound<T>& bound, const Grid<T>& source,
+                   ActiveSet<T>& active, bool periodic);
+  Grid<T> Iterate(const Grid<T>& initial, const Grid<T>& source, const Bound<T>& bound, bool verbose);
+  ActiveSet<T>* StartActiveSet(size_t rows, size_t cols, bool periodic, size_t parts = 1);
+  size_t IterateInPlace(Grid<T>& solution, Grid<T>& scratch, const Grid<T>& source, T scale,
+                        const BoundMask<T>& mask);
+
+  static void FillPeriodicHalo(Grid<T>& grid);
+  static void CopyTiles(const Grid<T>& from, Grid<T>& to, const ActiveSet<T>& active, size_t offset);
+  static T Sweep(const Grid<T>& prev, Grid<T>& next, const Grid<T>& source, T scale, const BoundMask<T>& mask);
+  static T SweepInPlace(Grid<T>& grid, const Bound<T>& bound, const Grid<T>& source, RowWindow<T>& window);
 
  private:
   T epsilon_;
   size_t max_iter_;
   std::function<T(const Grid<T>&, const Grid<T>&, bool)> norm_;
   std::function<T(size_t, size_t)> source_;
+  std::function<void(size_t, size_t, size_t, T*)> source_rows_;
+  Grid<T> source_grid_;
+  std::shared_ptr<SolutionCache<T>> cache_;
+  size_t iterations_;
+  size_t iterations_saved_;
+  size_t active_tile_size_;
+  T active_threshold_;
+  ActiveSet<T> active_set_;
+  bool low_memory_;
+  bool report_peak_memory_;
+  size_t peak_memory_;
+  std::shared_ptr<GridPool> pool_;
+  Profiler profiler_;
 
   static constexpr T kDefaultEpsilon = static_cast<T>(1e-4);
   static constexpr size_t kDefaultMaxIter = 1000;
 
-  static T DefaultNorm(const Grid<T>& prev, const Grid<T>& curr, bool exclude_boundaries = false);
   static T DefaultSource(size_t, size_t);
-
-  Grid<T> Update(const Grid<T>& prev, const Bound<T>& bound);
 }; // class Solver
 
 } // namespace fluid_dynamics
@@ -1,88 +1,291 @@
 // File: inc/poisson2d/fluid_dynamics/solver.tpp
 namespace fluid_dynamics {
 
-template<typename T>
-Solver<T>::Solver()
-    : epsilon_{kDefaultEpsilon}, max_iter_{kDefaultMaxIter}, norm_{DefaultNorm}, source_{DefaultSource} {}
+template<typename T, typename Stencil>
+Solver<T, Stencil>::Solver()
+    : epsilon_{kDefaultEpsilon}, max_iter_{kDefaultMaxIter}, norm_{DefaultNorm}, source_{DefaultSource},
+      iterations_{0}, iterations_saved_{0}, active_tile_size_{0}, active_threshold_{0},
+      low_memory_{false}, report_peak_memory_{false}, peak_memory_{0}, pool_{std::make_shared<GridPool>()} {}
+
+template<typename T, typename Stencil>
+Solver<T, Stencil>::Solver(T epsilon)
+    : epsilon_{epsilon * epsilon}, max_iter_{kDefaultMaxIter}, norm_{DefaultNorm}, source_{DefaultSource},
+      iterations_{0}, iterations_saved_{0}, active_tile_size_{0}, active_threshold_{0},
+      low_memory_{false}, report_peak_memory_{false}, peak_memory_{0}, pool_{std::make_shared<GridPool>()} {}
+
+template<typename T, typename Stencil>
+Solver<T, Stencil>::Solver(size_t max_iter)
+    : epsilon_{kDefaultEpsilon}, max_iter_{max_iter}, norm_{DefaultNorm}, source_{DefaultSource},
+      iterations_{0}, iterations_saved_{0}, active_tile_size_{0}, active_threshold_{0},
+      low_memory_{false}, report_peak_memory_{false}, peak_memory_{0}, pool_{std::make_shared<GridPool>()} {}
+
+template<typename T, typename Stencil>
+Solver<T, Stencil>::Solver(T epsilon, size_t max_iter)
+    : epsilon_{epsilon * epsilon}, max_iter_{max_iter}, norm_{DefaultNorm}, source_{DefaultSource},
+      iterations_{0}, iterations_saved_{0}, active_tile_size_{0}, active_threshold_{0},
+      low_memory_{false}, report_peak_memory_{false}, peak_memory_{0}, pool_{std::make_shared<GridPool>()} {}
+
+template<typename T, typename Stencil>
+T Solver<T, Stencil>::epsilon() const {
+  return epsilon_;
+}
 
-template<typename T>
-Solver<T>::Solver(T epsilon)
-    : epsilon_{epsilon * epsilon}, max_iter_{kDefaultMaxIter}, norm_{DefaultNorm}, source_{DefaultSource} {}
+template<typename T, typename Stencil>
+size_t Solver<T, Stencil>::max_iter() const {
+  return max_iter_;
+}
 
-template<typename T>
-Solver<T>::Solver(size_t max_iter)
-    : epsilon_{kDefaultEpsilon}, max_iter_{max_iter}, norm_{DefaultNorm}, source_{DefaultSource} {}
+template<typename T, typename Stencil>
+const Profiler& Solver<T, Stencil>::profiler() const {
+  return profiler_;
+}
 
-template<typename T>
-Solver<T>::Solver(T epsilon, size_t max_iter)
-    : epsilon_{epsilon * epsilon}, max_iter_{max_iter}, norm_{DefaultNorm}, source_{DefaultSource} {}
+template<typename T, typename Stencil>
+Profiler& Solver<T, Stencil>::profiler() {
+  return profiler_;
+}
 
-template<typename T>
-T Solver<T>::epsilon() const {
-  return epsilon_;
+template<typename T, typename Stencil>
+size_t Solver<T, Stencil>::iterations() const {
+  return iterations_;
 }
 
-template<typename T>
-size_t Solver<T>::max_iter() const {
-  return max_iter_;
+template<typename T, typename Stencil>
+size_t Solver<T, Stencil>::iterations_saved() const {
+  return iterations_saved_;
+}
+
+template<typename T, typename Stencil>
+const std::shared_ptr<SolutionCache<T>>& Solver<T, Stencil>::cache() const {
+  return cache_;
+}
+
+// Grids of a solve, its temporaries and the gradient and velocity come from this pool, which copies
+// of the solver share.
+template<typename T, typename Stencil>
+const std::shared_ptr<GridPool>& Solver<T, Stencil>::pool() const {
+  return pool_;
+}
+
+template<typename T, typename Stencil>
+const ActiveSet<T>& Solver<T, Stencil>::active_set() const {
+  return active_set_;
 }
 
-template<typename T>
-T Solver<T>::norm(const Grid<T>& prev, const Grid<T>& curr, bool exclude_boundaries) {
+template<typename T, typename Stencil>
+bool Solver<T, Stencil>::low_memory() const {
+  return low_memory_;
+}
+
+template<typename T, typename Stencil>
+bool Solver<T, Stencil>::report_peak_memory() const {
+  return report_peak_memory_;
+}
+
+// Peak resident memory of the last solve in bytes, per rank for the MPI solvers. 0 unless
+// report_peak_memory is set or where the platform does not report it.
+template<typename T, typename Stencil>
+size_t Solver<T, Stencil>::peak_memory() const {
+  return peak_memory_;
+}
+
+template<typename T, typename Stencil>
+T Solver<T, Stencil>::norm(const Grid<T>& prev, const Grid<T>& curr, bool exclude_boundaries) {
   return norm_(prev, curr, exclude_boundaries);
 }
 
-template<typename T>
-T Solver<T>::source(size_t i, size_t j) {
+template<typename T, typename Stencil>
+T Solver<T, Stencil>::source(size_t i, size_t j) {
+  T value;
+
+  if (source_grid_.rows() > 0) {
+    return source_grid_(i, j);
+  } else if (source_rows_) {
+    source_rows_(i, j, j + 1, &value);
+    return value;
+  }
   return source_(i, j);
 }
 
-template<typename T>
-void Solver<T>::epsilon(T epsilon) {
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::epsilon(T epsilon) {
   epsilon_ = epsilon;
 }
 
-template<typename T>
-void Solver<T>::max_iter(size_t max_iter) {
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::max_iter(size_t max_iter) {
   max_iter_ = max_iter;
 }
 
-template<typename T>
-void Solver<T>::norm(std::function<T(const Grid<T>&, const Grid<T>&, bool)> norm) {
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::norm(std::function<T(const Grid<T>&, const Grid<T>&, bool)> norm) {
   norm_ = norm;
 }
 
-template<typename T>
-void Solver<T>::source(std::function<T(size_t, size_t)> source) {
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::source(std::function<T(size_t, size_t)> source) {
   source_ = source;
+  source_rows_ = nullptr;
+  source_grid_ = Grid<T>{};
 }
 
-template<typename T>
-Grid<T> Solver<T>::Solve(size_t rows, size_t cols, const Bound<T>& bound, bool verbose) {
-  Grid<T> prev{rows, cols};
-  Grid<T> curr{rows, cols};
-  T norm;
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::source(const Grid<T>& source) {
+  source_grid_ = source;
+  source_rows_ = nullptr;
+}
+
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::source(Grid<T>&& source) {
+  source_grid_ = std::move(source);
+  source_rows_ = nullptr;
+}
+
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::source_rows(std::function<void(size_t, size_t, size_t, T*)> source_rows) {
+  source_rows_ = source_rows;
+  source_grid_ = Grid<T>{};
+}
+
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::cache(std::shared_ptr<SolutionCache<T>> cache) {
+  cache_ = std::move(cache);
+}
+
+// Shares a pool between solvers, nullptr allocates from the default memory resource.
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::pool(std::shared_ptr<GridPool> pool) {
+  pool_ = std::move(pool);
+}
+
+// A tile size of zero turns the active set off. Without a threshold, a tile freezes once its squared
+// change is below epsilon divided by the number of tiles.
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::active_set(size_t tile_size, T threshold) {
+  active_tile_size_ = tile_size;
+  active_threshold_ = threshold;
+}
+
+// Relaxes a single grid in place and keeps only the old values of the rows the stencil still reads,
+// see RowWindow, instead of a second grid. The result is the same as with two grids. Solves with
+// an active set, periodic bounds or a custom norm need both sweeps and keep two grids.
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::low_memory(bool low_memory) {
+  low_memory_ = low_memory;
+}
+
+// Measuring the peak resets the peak resident set size of the whole process before every solve, so
+// it is off by default. The MPI solvers reduce the peak over all ranks, the flag has to be the same
+// on every rank.
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::report_peak_memory(bool report_peak_memory) {
+  report_peak_memory_ = report_peak_memory;
+}
+
+// Without a cache the iteration starts from the source. With a cache it starts from the closest
+// cached solution, and the iterations saved are measured against the cold start of that entry.
+template<typename T, typename Stencil>
+Grid<T> Solver<T, Stencil>::Solve(size_t rows, size_t cols, const Bound<T>& bound, bool verbose) {
+  Grid<T> source = MaterializeSource(0, 0, rows, cols);
+
+  iterations_saved_ = 0;
+  if (!cache_) {
+    return Iterate(source, source, bound, verbose);
+  }
+
+  SolutionKey<T> key = SolutionCache<T>::Key(rows, cols, bound);
+  std::optional<CachedSolution<T>> cached = cache_->Lookup(key);
+  Grid<T> solution = Iterate(cached ? cached->solution : source, source, bound, verbose);
+  size_t baseline = cached ? cached->iterations : iterations_;
+
+  iterations_saved_ = baseline > iterations_ ? baseline - iterations_ : 0;
+  cache_->Insert(std::move(key), solution, baseline);
+  if (verbose && cached) {
+    std::cout << "Iterations saved by the warm start: " << iterations_saved_ << std::endl;
+  }
+
+  return solution;
+}
+
+template<typename T, typename Stencil>
+Grid<T> Solver<T, Stencil>::Solve(size_t rows, size_t cols, const Bound<T>& bound, const Grid<T>& initial,
+                                  bool verbose) {
+  if (initial.rows() != rows || initial.cols() != cols) {
+    throw std::invalid_argument("Initial guess does not match the dimensions of the solve");
+  }
+
+  iterations_saved_ = 0;
+  return Iterate(initial, MaterializeSource(0, 0, rows, cols), bound, verbose);
+}
+
+template<typename T, typename Stencil>
+Grid<T> Solver<T, Stencil>::Iterate(const Grid<T>& initial, const Grid<T>& source, const Bound<T>& bound,
+                                    bool verbose) {
+  size_t rows = initial.rows();
+  size_t cols = initial.cols();
+  bool periodic = bound.type() == BoundaryType::kPeriodic;
+  Grid<T> prev{initial, resource()};
+  T norm = 0;
   size_t iter;
   bool converged = false;
   int progress_intervals = static_cast<int>(max_iter_ * 0.05);
   int progress_steps = 0;
 
-  for (size_t i = 0; i < prev.rows(); ++i) {
-    for (size_t j = 0; j < prev.cols(); ++j) {
-      prev(i, j) = source_(i, j);
-    }
+  if (report_peak_memory_) {
+    ResetPeakResidentMemory();
+  }
+  if (periodic) {
+    prev.Resize(rows + 2, cols + 2, {1, 1});
+  }
+  ActiveSet<T>* active = StartActiveSet(rows, cols, periodic);
+  bool in_place = low_memory_ && !periodic && !active && !custom_norm();
+  Grid<T> curr{in_place ? 0 : prev.rows(), in_place ? 0 : prev.cols(), resource()};
+  RowWindow<T> window = in_place ? RowWindow<T>{Stencil::kRadius, cols} : RowWindow<T>{};
+
+  if (active) {
+    curr = prev;
   }
 
+  profiler_.Reset();
+  FDSIM_PROFILE_WORKLOAD(profiler_, Phase::kStencil, 2 * rows * cols * sizeof(T), Stencil::kFlops * rows * cols);
+  FDSIM_PROFILE_WORKLOAD(profiler_, Phase::kNorm, 2 * rows * cols * sizeof(T), 3 * rows * cols);
   auto start = std::chrono::high_resolution_clock::now();
 
   for (iter = 0; iter < max_iter_; ++iter) {
-    curr = Update(prev, bound);
-    norm = norm_(prev, curr, false);
-    if (norm < epsilon_) {
+    {
+      FDSIM_PROFILE_SCOPE(profiler_, Phase::kStencil);
+      if (periodic) {
+        FillPeriodicHalo(prev);
+      }
+      if (in_place) {
+        norm = SweepInPlace(prev, bound, source, window);
+      } else if (active) {
+        UpdateTiles(prev, curr, bound, source, *active, periodic);
+      } else if (periodic) {
+        curr = UpdatePeriodic(prev, bound, source);
+      } else {
+        curr = Update(prev, bound, source);
+      }
+    }
+    if (!in_place) {
+      FDSIM_PROFILE_SCOPE(profiler_, Phase::kNorm);
+      norm = active ? active->norm() : norm_(prev, curr, false);
+    }
+    FDSIM_PROFILE_ITERATION(profiler_, norm);
+    // With frozen tiles the norm only covers part of the grid, so convergence is confirmed by a full sweep.
+    if (norm < epsilon_ && (!active || active->frozen_count() == 0)) {
       converged = true;
       break;
     }
-    prev = curr;
+    if (active) {
+      CopyTiles(curr, prev, *active, periodic ? 1 : 0);
+      active->Advance();
+      if (norm < epsilon_) {
+        active->ActivateAll();
+      }
+    } else if (!in_place) {
+      prev = curr;
+    }
 
     if (verbose && iter == progress_steps * progress_intervals) {
       Progress(iter, max_iter_);
@@ -92,38 +295,58 @@ Grid<T> Solver<T>::Solve(size_t rows, size_t cols, const Bound<T>& bound, bool v
 
   auto end = std::chrono::high_resolution_clock::now();
   std::chrono::duration<long double> time_taken = end - start;
+  iterations_ = converged ? iter + 1 : max_iter_;
+  peak_memory_ = report_peak_memory_ ? PeakResidentMemory() : 0;
+  if (in_place) {
+    curr = std::move(prev);
+  }
+  if (periodic) {
+    curr.Resize(rows, cols, {-1, -1});
+  }
 
   if (verbose) {
     Progress(max_iter_, max_iter_);
     if (converged) {
-      std::cout << "Number of iterations to converge: " << iter << std::endl;
+      std::cout << "Number of iterations to converge: " << iterations_ << std::endl;
     } else {
       std::cout << "Reached maximum number of iterations: " << max_iter_ << std::endl;
       std::cout << "Norm: " << norm << std::endl;
     }
+    if (active) {
+      std::cout << "Cell updates skipped: " << active->skipped() << " of "
+                << active->skipped() + active->updates() << std::endl;
+    }
+    if (peak_memory_ > 0) {
+      std::cout << "Peak resident memory: " << peak_memory_ / (1024 * 1024) << " MiB" << std::endl;
+    }
     std::cout << std::setprecision(6) << "Time Taken: " << time_taken.count() << "s" << std::endl;
   }
 
   return curr;
 }
 
-template<typename T>
-Grid<std::pair<T, T>> Solver<T>::Gradient(const Grid<T>& field) {
-  Grid<std::pair<T, T>> grad{field.rows(), field.cols()};
+template<typename T, typename Stencil>
+Grid<std::pair<T, T>> Solver<T, Stencil>::Gradient(const Grid<T>& field) {
+  Grid<std::pair<T, T>> grad{field.rows(), field.cols(), resource()};
+  auto stride = static_cast<std::ptrdiff_t>(field.cols());
+  size_t radius = Stencil::kRadius;
 
   for (size_t i = 1; i < field.rows() - 1; ++i) {
     for (size_t j = 1; j < field.cols() - 1; ++j) {
-      grad(i, j).first = (field(i, j + 1) - field(i, j - 1)) / 2;
-      grad(i, j).second = (field(i + 1, j) - field(i - 1, j)) / 2;
+      if (i < radius || i >= field.rows() - radius || j < radius || j >= field.cols() - radius) {
+        grad(i, j) = GradientAt<FivePoint>(&field(i, j), stride);
+      } else {
+        grad(i, j) = GradientAt<Stencil>(&field(i, j), stride);
+      }
     }
   }
 
   return grad;
 }
 
-template<typename T>
-Grid<std::pair<T, T>> Solver<T>::Velocity(const Grid<std::pair<T, T>>& grad) {
-  Grid<std::pair<T, T>> velocity{grad.rows(), grad.cols()};
+template<typename T, typename Stencil>
+Grid<std::pair<T, T>> Solver<T, Stencil>::Velocity(const Grid<std::pair<T, T>>& grad) {
+  Grid<std::pair<T, T>> velocity{grad.rows(), grad.cols(), resource()};
 
   for (size_t i = 0; i < grad.rows(); ++i) {
     for (size_t j = 0; j < grad.cols(); ++j) {
@@ -139,8 +362,8 @@ Grid<std::pair<T, T>> Solver<T>::Velocity(const Grid<std::pair<T, T>>& grad) {
   return velocity;
 }
 
-template<typename T>
-void Solver<T>::Progress(size_t iter, size_t max_iter) {
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::Progress(size_t iter, size_t max_iter) {
   double progress = static_cast<double>(iter) / static_cast<double>(max_iter);
   int total_width = 50;
   int curr_width = static_cast<int>(total_width * progress);
@@ -159,8 +382,31 @@ void Solver<T>::Progress(size_t iter, size_t max_iter) {
   std::cout << std::endl;
 }
 
-template<typename T>
-T Solver<T>::DefaultNorm(const Grid<T>& prev, const Grid<T>& curr, bool exclude_boundaries) {
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::iterations(size_t iterations) {
+  iterations_ = iterations;
+}
+
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::peak_memory(size_t peak_memory) {
+  peak_memory_ = peak_memory;
+}
+
+template<typename T, typename Stencil>
+std::pmr::memory_resource* Solver<T, Stencil>::resource() const {
+  return pool_ ? pool_.get() : std::pmr::get_default_resource();
+}
+
+// Solvers that reduce the norm inside their sweep only do so while no other norm is set.
+template<typename T, typename Stencil>
+bool Solver<T, Stencil>::custom_norm() const {
+  using NormFunction = T (*)(const Grid<T>&, const Grid<T>&, bool);
+  const NormFunction* target = norm_.template target<NormFunction>();
+  return target == nullptr || *target != &Solver<T, Stencil>::DefaultNorm;
+}
+
+template<typename T, typename Stencil>
+T Solver<T, Stencil>::DefaultNorm(const Grid<T>& prev, const Grid<T>& curr, bool exclude_boundaries) {
   T norm = 0;
   size_t start_row = exclude_boundaries ? 1 : 0;
   size_t start_col = exclude_boundaries ? 1 : 0;
@@ -176,19 +422,59 @@ T Solver<T>::DefaultNorm(const Grid<T>& prev, const Grid<T>& curr, bool exclude_
   return norm;
 }
 
-template<typename T>
-T Solver<T>::DefaultSource(size_t, size_t) {
+template<typename T, typename Stencil>
+T Solver<T, Stencil>::DefaultSource(size_t, size_t) {
   return 0;
 }
 
-template<typename T>
-Grid<T> Solver<T>::Update(const Grid<T>& prev, const Bound<T>& bound) {
-  Grid<T> next{prev.rows(), prev.cols()};
+// A precomputed source grid is either the block itself or the global field the block is cut from,
+// callbacks are evaluated once per solve. The block is given in global coordinates so SolverMpi
+// ranks only evaluate their own part.
+template<typename T, typename Stencil>
+Grid<T> Solver<T, Stencil>::MaterializeSource(size_t origin_row, size_t origin_col, size_t rows, size_t cols) const {
+  Grid<T> source{rows, cols, resource()};
+
+  if (source_grid_.rows() > 0) {
+    if (source_grid_.rows() == rows && source_grid_.cols() == cols) {
+      return {source_grid_, resource()};
+    }
+    if (source_grid_.rows() < origin_row + rows || source_grid_.cols() < origin_col + cols) {
+      throw std::invalid_argument("Source grid does not cover the dimensions of the solve");
+    }
+    for (size_t i = 0; i < rows; ++i) {
+      std::copy_n(&source_grid_(origin_row + i, origin_col), cols, source.data(i, 0));
+    }
+  } else if (source_rows_) {
+#ifdef _OPENMP
+    #pragma omp parallel for default(none) shared(source, origin_row, origin_col, rows, cols)
+#endif
+    for (size_t i = 0; i < rows; ++i) {
+      source_rows_(origin_row + i, origin_col, origin_col + cols, source.data(i, 0));
+    }
+  } else {
+#ifdef _OPENMP
+    #pragma omp parallel for default(none) collapse(2) shared(source, origin_row, origin_col, rows, cols)
+#endif
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < cols; ++j) {
+        source(i, j) = source_(origin_row + i, origin_col + j);
+      }
+    }
+  }
+
+  return source;
+}
+
+template<typename T, typename Stencil>
+Grid<T> Solver<T, Stencil>::Update(const Grid<T>& prev, const Bound<T>& bound, const Grid<T>& source) {
+  Grid<T> next{prev.rows(), prev.cols(), resource()};
+  auto stride = static_cast<std::ptrdiff_t>(prev.cols());
+  size_t radius = Stencil::kRadius;
   bool is_boundary = false;
 
   for (size_t i = 0; i < prev.rows(); ++i) {
     for (size_t j = 0; j < prev.cols(); ++j) {
-      for (Boundary<T> boundary : bound.boundaries()) {
+      for (const Boundary<T>& boundary : bound.boundaries()) {
         if (boundary.condition(i, j)) {
           next(i, j) = boundary.value(i, j);
           is_boundary = true;
@@ -196,7 +482,14 @@ Grid<T> Solver<T>::Update(const Grid<T>& prev, const Bound<T>& bound) {
         }
       }
       if (!is_boundary) {
-        next(i, j) = 0.25 * (prev(i - 1, j) + prev(i + 1, j) + prev(i, j - 1) + prev(i, j + 1) + source_(i, j));
+        if (i == 0 || j == 0 || i == prev.rows() - 1 || j == prev.cols() - 1) {
+          next(i, j) = prev(i, j);
+        } else if (Stencil::kRadius > 1 && (i < radius || i >= prev.rows() - radius
+                                            || j < radius || j >= prev.cols() - radius)) {
+          next(i, j) = Relax<FivePoint>(&prev(i, j), stride, source(i, j));
+        } else {
+          next(i, j) = Relax<Stencil>(&prev(i, j), stride, source(i, j));
+        }
       }
       is_boundary = false;
     }
@@ -205,4 +498,239 @@ Grid<T> Solver<T>::Update(const Grid<T>& prev, const Bound<T>& bound) {
   return next;
 }
 
+// Relaxes the active tiles only, cells of frozen tiles keep the value they have in both grids. The
+// cells are treated as in Update, or as in UpdatePeriodic when the grids carry the periodic halo.
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::UpdateTiles(const Grid<T>& prev, Grid<T>& next, const Bound<T>& bound,
+                                     const Grid<T>& source, ActiveSet<T>& active, bool periodic) {
+  const std::vector<size_t>& tiles = active.active();
+  auto stride = static_cast<std::ptrdiff_t>(prev.cols());
+  size_t offset = periodic ? 1 : 0;
+  size_t rows = active.rows();
+  size_t cols = active.cols();
+  size_t radius = Stencil::kRadius;
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) schedule(dynamic) \
+          shared(prev, next, bound, source, active, tiles, stride, offset, rows, cols, radius, periodic)
+#endif
+  for (size_t k = 0; k < tiles.size(); ++k) {
+    size_t t = tiles[k];
+    T change = 0;
+    for (size_t i = active.RowBegin(t); i < active.RowEnd(t); ++i) {
+      for (size_t j = active.ColBegin(t); j < active.ColEnd(t); ++j) {
+        const T* center = &prev(i + offset, j + offset);
+        T& out = next(i + offset, j + offset);
+        bool is_boundary = false;
+        for (const Boundary<T>& boundary : bound.boundaries()) {
+          if (boundary.condition(i, j)) {
+            out = boundary.value(i, j);
+            is_boundary = true;
+            break;
+          }
+        }
+        if (!is_boundary) {
+          if (!periodic && (i == 0 || j == 0 || i == rows - 1 || j == cols - 1)) {
+            out = *center;
+          } else if (Stencil::kRadius > 1 && (i < radius || i >= rows - radius || j < radius || j >= cols - radius)) {
+            out = Relax<FivePoint>(center, stride, source(i, j));
+          } else {
+            out = Relax<Stencil>(center, stride, source(i, j));
+          }
+        }
+        change += (*center - out) * (*center - out);
+      }
+    }
+    active.Record(t, change);
+  }
+}
+
+// prev carries a one cell halo filled by FillPeriodicHalo, which is copied into next so it does not
+// contribute to the norm. As in Update, cells within the stencil radius of the domain edge use the
+// 5-point stencil, so wider stencils never reach across a wall next to the periodic seam.
+template<typename T, typename Stencil>
+Grid<T> Solver<T, Stencil>::UpdatePeriodic(const Grid<T>& prev, const Bound<T>& bound, const Grid<T>& source) {
+  Grid<T> next{prev, resource()};
+  auto stride = static_cast<std::ptrdiff_t>(prev.cols());
+  size_t rows = prev.rows() - 2;
+  size_t cols = prev.cols() - 2;
+  size_t radius = Stencil::kRadius;
+  bool is_boundary = false;
+
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      for (const Boundary<T>& boundary : bound.boundaries()) {
+        if (boundary.condition(i, j)) {
+          next(i + 1, j + 1) = boundary.value(i, j);
+          is_boundary = true;
+          break;
+        }
+      }
+      if (!is_boundary) {
+        if (Stencil::kRadius > 1 && (i < radius || i >= rows - radius || j < radius || j >= cols - radius)) {
+          next(i + 1, j + 1) = Relax<FivePoint>(&prev(i + 1, j + 1), stride, source(i, j));
+        } else {
+          next(i + 1, j + 1) = Relax<Stencil>(&prev(i + 1, j + 1), stride, source(i, j));
+        }
+      }
+      is_boundary = false;
+    }
+  }
+
+  return next;
+}
+
+template<typename T, typename Stencil>
+ActiveSet<T>* Solver<T, Stencil>::StartActiveSet(size_t rows, size_t cols, bool periodic, size_t parts) {
+  if (active_tile_size_ == 0) {
+    return nullptr;
+  }
+
+  size_t tiles = ((rows + active_tile_size_ - 1) / active_tile_size_) * ((cols + active_tile_size_ - 1) / active_tile_size_);
+  T threshold = active_threshold_ > 0 ? active_threshold_ : epsilon_ / static_cast<T>(tiles * parts);
+
+  active_set_ = ActiveSet<T>{rows, cols, active_tile_size_, threshold, periodic};
+  return &active_set_;
+}
+
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::CopyTiles(const Grid<T>& from, Grid<T>& to, const ActiveSet<T>& active, size_t offset) {
+  const std::vector<size_t>& tiles = active.active();
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(from, to, active, tiles, offset)
+#endif
+  for (size_t k = 0; k < tiles.size(); ++k) {
+    size_t t = tiles[k];
+    size_t width = active.ColEnd(t) - active.ColBegin(t);
+    for (size_t i = active.RowBegin(t); i < active.RowEnd(t); ++i) {
+      std::copy_n(&from(i + offset, active.ColBegin(t) + offset), width, to.data(i + offset, active.ColBegin(t) + offset));
+    }
+  }
+}
+
+// Jacobi iteration on padded grids that starts from the current solution and leaves the result in
+// it. Both grids are reused, so repeated solves of the same geometry allocate nothing. Returns the
+// number of sweeps.
+template<typename T, typename Stencil>
+size_t Solver<T, Stencil>::IterateInPlace(Grid<T>& solution, Grid<T>& scratch, const Grid<T>& source, T scale,
+                                          const BoundMask<T>& mask) {
+  size_t iter;
+  T norm;
+
+  for (iter = 0; iter < max_iter_; ++iter) {
+    {
+      FDSIM_PROFILE_SCOPE(profiler_, Phase::kStencil);
+      norm = Sweep(solution, scratch, source, scale, mask);
+    }
+    std::swap(solution, scratch);
+    FDSIM_PROFILE_ITERATION(profiler_, norm);
+    if (norm < epsilon_) {
+      return iter + 1;
+    }
+  }
+
+  return max_iter_;
+}
+
+// One sweep over the block of a compiled mask, the source is scaled on the fly. Returns the squared
+// norm of the change of the block.
+template<typename T, typename Stencil>
+T Solver<T, Stencil>::Sweep(const Grid<T>& prev, Grid<T>& next, const Grid<T>& source, T scale,
+                            const BoundMask<T>& mask) {
+  auto stride = static_cast<std::ptrdiff_t>(prev.cols());
+  size_t halo = mask.halo();
+  size_t end_row = halo + mask.rows();
+  size_t end_col = halo + mask.cols();
+  T norm = 0;
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(prev, next, source, scale, mask, stride, halo, end_row, end_col) \
+          reduction(+:norm)
+#endif
+  for (size_t i = halo; i < end_row; ++i) {
+    for (size_t j = halo; j < end_col; ++j) {
+      T value;
+      switch (mask.kind(i, j)) {
+        case CellKind::kInterior:
+          value = Relax<Stencil>(&prev(i, j), stride, scale * source(i, j));
+          break;
+        case CellKind::kFallback:
+          value = Relax<FivePoint>(&prev(i, j), stride, scale * source(i, j));
+          break;
+        case CellKind::kBoundary:
+          value = mask.value(i, j);
+          break;
+        default:
+          value = prev(i, j);
+          break;
+      }
+      norm += (value - prev(i, j)) * (value - prev(i, j));
+      next(i, j) = value;
+    }
+  }
+
+  return norm;
+}
+
+// Update of a grid in place, the old values are read from the window, which is refilled on the way
+// down. Returns the squared norm of the change, summed in the order of the default norm.
+template<typename T, typename Stencil>
+T Solver<T, Stencil>::SweepInPlace(Grid<T>& grid, const Bound<T>& bound, const Grid<T>& source,
+                                   RowWindow<T>& window) {
+  auto stride = static_cast<std::ptrdiff_t>(grid.cols());
+  size_t rows = grid.rows();
+  size_t cols = grid.cols();
+  size_t radius = Stencil::kRadius;
+  bool is_boundary = false;
+  T norm = 0;
+
+  window.Reset(0);
+  for (size_t i = 0; i < rows; ++i) {
+    while (window.end() < std::min(i + radius + 1, rows)) {
+      window.Push(grid.data(window.end(), 0));
+    }
+    const T* old = window.row(i);
+    for (size_t j = 0; j < cols; ++j) {
+      T value;
+      for (const Boundary<T>& boundary : bound.boundaries()) {
+        if (boundary.condition(i, j)) {
+          value = boundary.value(i, j);
+          is_boundary = true;
+          break;
+        }
+      }
+      if (!is_boundary) {
+        if (i == 0 || j == 0 || i == rows - 1 || j == cols - 1) {
+          value = old[j];
+        } else if (Stencil::kRadius > 1 && (i < radius || i >= rows - radius || j < radius || j >= cols - radius)) {
+          value = Relax<FivePoint>(old + j, stride, source(i, j));
+        } else {
+          value = Relax<Stencil>(old + j, stride, source(i, j));
+        }
+      }
+      is_boundary = false;
+      norm += (old[j] - value) * (old[j] - value);
+      grid(i, j) = value;
+    }
+  }
+
+  return norm;
+}
+
+// Wraps the outermost rows and columns of the interior into the opposite halo, the corners are
+// filled by copying the padded rows after the columns.
+template<typename T, typename Stencil>
+void Solver<T, Stencil>::FillPeriodicHalo(Grid<T>& grid) {
+  size_t rows = grid.rows() - 2;
+  size_t cols = grid.cols() - 2;
+
+  for (size_t i = 1; i <= rows; ++i) {
+    grid(i, 0) = grid(i, cols);
+    grid(i, cols + 1) = grid(i, 1);
+  }
+  std::copy_n(grid.data(rows, 0), grid.cols(), grid.data(0, 0));
+  std::copy_n(grid.data(1, 0), grid.cols(), grid.data(rows + 1, 0));
+}
+
 } // namespace fluid_dynamics
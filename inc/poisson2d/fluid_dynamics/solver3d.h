@@ -0,0 +1,88 @@
+// File: inc/poisson2d/fluid_dynamics/solver3d.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER3D_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER3D_H_
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <functional>
+#include <stdexcept>
+#include "grid3d.h"
+#include "bound3d.h"
+#include "profiler.h"
+
+namespace fluid_dynamics {
+
+// Jacobi iteration of the 7-point Laplacian. Cells are classified once per solve, edge cells that
+// no boundary covers keep their initial value. The grids of the sweep carry a one cell halo so the
+// same kernel serves the serial and the distributed solver.
+template<typename T>
+class Solver3D {
+ public:
+  Solver3D();
+  Solver3D(const Solver3D&) = default;
+  Solver3D(Solver3D&&) noexcept = default;
+  explicit Solver3D(T epsilon);
+  explicit Solver3D(size_t max_iter);
+  Solver3D(T epsilon, size_t max_iter);
+  virtual ~Solver3D() = default;
+
+  Solver3D& operator=(const Solver3D&) = default;
+  Solver3D& operator=(Solver3D&&) noexcept = default;
+
+  [[nodiscard]] T epsilon() const;
+  [[nodiscard]] size_t max_iter() const;
+  [[nodiscard]] size_t iterations() const;
+  [[nodiscard]] const Profiler& profiler() const;
+  [[nodiscard]] Profiler& profiler();
+
+  void epsilon(T epsilon);
+  void max_iter(size_t max_iter);
+  void source(std::function<T(size_t, size_t, size_t)> source);
+  void source(const Grid3D<T>& source);
+
+  Grid3D<T> Solve(size_t nx, size_t ny, size_t nz, const Bound3D<T>& bound, bool verbose = false);
+  Grid3D<std::array<T, 3>> Gradient(const Grid3D<T>& field);
+  virtual Grid3D<std::array<T, 3>> Velocity(const Grid3D<std::array<T, 3>>& grad);
+
+ protected:
+  enum CellKind : unsigned char {
+    kInterior,
+    kBoundary,
+    kFixed
+  }; // enum CellKind
+
+  static constexpr size_t kFlops = 8;
+
+  void Progress(size_t iter, size_t max_iter);
+  void Report(bool converged, size_t iter, T norm, long double seconds);
+
+  Grid3D<T> MaterializeSource(std::array<size_t, 3> origin, size_t nx, size_t ny, size_t nz) const;
+  void Classify(const Bound3D<T>& bound, std::array<size_t, 3> origin, std::array<size_t, 3> global,
+                Grid3D<unsigned char>& kind, Grid3D<T>& fixed) const;
+  static T Sweep(const Grid3D<T>& prev, Grid3D<T>& next, const Grid3D<unsigned char>& kind,
+                 const Grid3D<T>& fixed, const Grid3D<T>& source);
+
+  size_t iterations_;
+
+ private:
+  T epsilon_;
+  size_t max_iter_;
+  std::function<T(size_t, size_t, size_t)> source_;
+  Grid3D<T> source_grid_;
+  Profiler profiler_;
+
+  static constexpr T kDefaultEpsilon = static_cast<T>(1e-4);
+  static constexpr size_t kDefaultMaxIter = 1000;
+
+  static T DefaultSource(size_t, size_t, size_t);
+}; // class Solver3D
+
+} // namespace fluid_dynamics
+
+#include "solver3d.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER3D_H_
@@ -0,0 +1,292 @@
+// File: inc/poisson2d/fluid_dynamics/solver3d.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+Solver3D<T>::Solver3D()
+    : iterations_{0}, epsilon_{kDefaultEpsilon}, max_iter_{kDefaultMaxIter}, source_{DefaultSource} {}
+
+template<typename T>
+Solver3D<T>::Solver3D(T epsilon)
+    : iterations_{0}, epsilon_{epsilon * epsilon}, max_iter_{kDefaultMaxIter}, source_{DefaultSource} {}
+
+template<typename T>
+Solver3D<T>::Solver3D(size_t max_iter)
+    : iterations_{0}, epsilon_{kDefaultEpsilon}, max_iter_{max_iter}, source_{DefaultSource} {}
+
+template<typename T>
+Solver3D<T>::Solver3D(T epsilon, size_t max_iter)
+    : iterations_{0}, epsilon_{epsilon * epsilon}, max_iter_{max_iter}, source_{DefaultSource} {}
+
+template<typename T>
+T Solver3D<T>::epsilon() const {
+  return epsilon_;
+}
+
+template<typename T>
+size_t Solver3D<T>::max_iter() const {
+  return max_iter_;
+}
+
+template<typename T>
+size_t Solver3D<T>::iterations() const {
+  return iterations_;
+}
+
+template<typename T>
+const Profiler& Solver3D<T>::profiler() const {
+  return profiler_;
+}
+
+template<typename T>
+Profiler& Solver3D<T>::profiler() {
+  return profiler_;
+}
+
+template<typename T>
+void Solver3D<T>::epsilon(T epsilon) {
+  epsilon_ = epsilon;
+}
+
+template<typename T>
+void Solver3D<T>::max_iter(size_t max_iter) {
+  max_iter_ = max_iter;
+}
+
+template<typename T>
+void Solver3D<T>::source(std::function<T(size_t, size_t, size_t)> source) {
+  source_ = source;
+  source_grid_ = Grid3D<T>{};
+}
+
+template<typename T>
+void Solver3D<T>::source(const Grid3D<T>& source) {
+  source_grid_ = source;
+}
+
+// Only Dirichlet problems are supported, the iteration starts from the source as in Solver.
+template<typename T>
+Grid3D<T> Solver3D<T>::Solve(size_t nx, size_t ny, size_t nz, const Bound3D<T>& bound, bool verbose) {
+  if (bound.type() == BoundaryType::kPeriodic) {
+    throw std::invalid_argument("Periodic boundaries are not supported in 3D");
+  }
+
+  Grid3D<T> source = MaterializeSource({0, 0, 0}, nx, ny, nz);
+  Grid3D<unsigned char> kind{nx, ny, nz};
+  Grid3D<T> fixed{nx, ny, nz};
+  Classify(bound, {0, 0, 0}, {nx, ny, nz}, kind, fixed);
+
+  Grid3D<T> prev{source};
+  prev.Resize(nx + 2, ny + 2, nz + 2, {1, 1, 1});
+  Grid3D<T> curr{prev};
+  T norm = 0;
+  size_t iter;
+  bool converged = false;
+  size_t progress_intervals = static_cast<size_t>(max_iter_ * 0.05);
+  size_t progress_steps = 0;
+
+  profiler_.Reset();
+  FDSIM_PROFILE_WORKLOAD(profiler_, Phase::kStencil, 2 * nx * ny * nz * sizeof(T), kFlops * nx * ny * nz);
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (iter = 0; iter < max_iter_; ++iter) {
+    {
+      FDSIM_PROFILE_SCOPE(profiler_, Phase::kStencil);
+      norm = Sweep(prev, curr, kind, fixed, source);
+    }
+    FDSIM_PROFILE_ITERATION(profiler_, norm);
+    if (norm < epsilon_) {
+      converged = true;
+      break;
+    }
+    std::swap(prev, curr);
+
+    if (verbose && iter == progress_steps * progress_intervals) {
+      Progress(iter, max_iter_);
+      ++progress_steps;
+    }
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<long double> time_taken = end - start;
+  iterations_ = converged ? iter + 1 : max_iter_;
+  if (!converged) {
+    std::swap(prev, curr);
+  }
+  curr.Resize(nx, ny, nz, {-1, -1, -1});
+
+  if (verbose) {
+    Report(converged, iter, norm, time_taken.count());
+  }
+
+  return curr;
+}
+
+// Central differences on the interior, the outermost layer is left at zero as in Solver.
+template<typename T>
+Grid3D<std::array<T, 3>> Solver3D<T>::Gradient(const Grid3D<T>& field) {
+  Grid3D<std::array<T, 3>> grad{field.nx(), field.ny(), field.nz()};
+  const T half = static_cast<T>(0.5);
+
+  if (field.nx() < 3 || field.ny() < 3 || field.nz() < 3) {
+    return grad;
+  }
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(field, grad, half)
+#endif
+  for (size_t i = 1; i < field.nx() - 1; ++i) {
+    for (size_t j = 1; j < field.ny() - 1; ++j) {
+      for (size_t k = 1; k < field.nz() - 1; ++k) {
+        grad(i, j, k) = {half * (field(i + 1, j, k) - field(i - 1, j, k)),
+                         half * (field(i, j + 1, k) - field(i, j - 1, k)),
+                         half * (field(i, j, k + 1) - field(i, j, k - 1))};
+      }
+    }
+  }
+
+  return grad;
+}
+
+// In 3D the solution is read as a velocity potential, so the velocity is the gradient itself.
+template<typename T>
+Grid3D<std::array<T, 3>> Solver3D<T>::Velocity(const Grid3D<std::array<T, 3>>& grad) {
+  return grad;
+}
+
+template<typename T>
+void Solver3D<T>::Progress(size_t iter, size_t max_iter) {
+  double progress = static_cast<double>(iter) / static_cast<double>(max_iter);
+  int total_width = 50;
+  int curr_width = static_cast<int>(total_width * progress);
+
+  std::cout << "[";
+  for (int i = 0; i < total_width; ++i) {
+    if (i < curr_width) {
+      std::cout << "=";
+    } else if (i == curr_width) {
+      std::cout << ">";
+    } else {
+      std::cout << " ";
+    }
+  }
+  std::cout << "] " << static_cast<int>(progress * 100.0) << "%\r";
+  std::cout << std::endl;
+}
+
+template<typename T>
+void Solver3D<T>::Report(bool converged, size_t iter, T norm, long double seconds) {
+  Progress(max_iter_, max_iter_);
+  if (converged) {
+    std::cout << "Number of iterations to converge: " << iter << std::endl;
+  } else {
+    std::cout << "Reached maximum number of iterations: " << max_iter_ << std::endl;
+    std::cout << "Norm: " << norm << std::endl;
+  }
+  std::cout << std::setprecision(6) << "Time Taken: " << seconds << "s" << std::endl;
+}
+
+// The block is given in global coordinates so SolverMpi3D ranks only evaluate their own part.
+template<typename T>
+Grid3D<T> Solver3D<T>::MaterializeSource(std::array<size_t, 3> origin, size_t nx, size_t ny, size_t nz) const {
+  Grid3D<T> source{nx, ny, nz};
+
+  if (source_grid_.size() > 0) {
+    if (source_grid_.nx() == nx && source_grid_.ny() == ny && source_grid_.nz() == nz) {
+      return source_grid_;
+    }
+    if (source_grid_.nx() < origin[0] + nx || source_grid_.ny() < origin[1] + ny
+        || source_grid_.nz() < origin[2] + nz) {
+      throw std::invalid_argument("Source grid does not cover the dimensions of the solve");
+    }
+    for (size_t i = 0; i < nx; ++i) {
+      for (size_t j = 0; j < ny; ++j) {
+        std::copy_n(&source_grid_(origin[0] + i, origin[1] + j, origin[2]), nz, source.data(i, j, 0));
+      }
+    }
+  } else {
+#ifdef _OPENMP
+    #pragma omp parallel for default(none) collapse(2) shared(source, origin, nx, ny, nz)
+#endif
+    for (size_t i = 0; i < nx; ++i) {
+      for (size_t j = 0; j < ny; ++j) {
+        for (size_t k = 0; k < nz; ++k) {
+          source(i, j, k) = source_(origin[0] + i, origin[1] + j, origin[2] + k);
+        }
+      }
+    }
+  }
+
+  return source;
+}
+
+// Boundary conditions are evaluated once per solve instead of once per sweep. Cells on the faces of
+// the global domain that no boundary covers keep their initial value.
+template<typename T>
+void Solver3D<T>::Classify(const Bound3D<T>& bound, std::array<size_t, 3> origin, std::array<size_t, 3> global,
+                           Grid3D<unsigned char>& kind, Grid3D<T>& fixed) const {
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) collapse(2) shared(bound, origin, global, kind, fixed)
+#endif
+  for (size_t i = 0; i < kind.nx(); ++i) {
+    for (size_t j = 0; j < kind.ny(); ++j) {
+      for (size_t k = 0; k < kind.nz(); ++k) {
+        size_t gi = origin[0] + i;
+        size_t gj = origin[1] + j;
+        size_t gk = origin[2] + k;
+        kind(i, j, k) = kInterior;
+        for (const Boundary3D<T>& boundary : bound.boundaries()) {
+          if (boundary.condition(gi, gj, gk)) {
+            kind(i, j, k) = kBoundary;
+            fixed(i, j, k) = boundary.value(gi, gj, gk);
+            break;
+          }
+        }
+        if (kind(i, j, k) == kInterior && (gi == 0 || gj == 0 || gk == 0 || gi == global[0] - 1
+                                           || gj == global[1] - 1 || gk == global[2] - 1)) {
+          kind(i, j, k) = kFixed;
+        }
+      }
+    }
+  }
+}
+
+// One Jacobi sweep over grids padded by one cell, returns the squared norm of the change.
+template<typename T>
+T Solver3D<T>::Sweep(const Grid3D<T>& prev, Grid3D<T>& next, const Grid3D<unsigned char>& kind,
+                     const Grid3D<T>& fixed, const Grid3D<T>& source) {
+  auto sy = static_cast<std::ptrdiff_t>(prev.nz());
+  auto sx = static_cast<std::ptrdiff_t>(prev.ny() * prev.nz());
+  const T sixth = static_cast<T>(1.0 / 6.0);
+  T norm = 0;
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(prev, next, kind, fixed, source, sx, sy, sixth) reduction(+:norm)
+#endif
+  for (size_t i = 0; i < kind.nx(); ++i) {
+    for (size_t j = 0; j < kind.ny(); ++j) {
+      const unsigned char* c = &kind(i, j, 0);
+      for (size_t k = 0; k < kind.nz(); ++k) {
+        const T* p = &prev(i + 1, j + 1, k + 1);
+        T value;
+        if (c[k] == kInterior) {
+          value = sixth * (p[-sx] + p[sx] + p[-sy] + p[sy] + p[-1] + p[1] + source(i, j, k));
+        } else if (c[k] == kBoundary) {
+          value = fixed(i, j, k);
+        } else {
+          value = *p;
+        }
+        norm += (value - *p) * (value - *p);
+        next(i + 1, j + 1, k + 1) = value;
+      }
+    }
+  }
+
+  return norm;
+}
+
+template<typename T>
+T Solver3D<T>::DefaultSource(size_t, size_t, size_t) {
+  return 0;
+}
+
+} // namespace fluid_dynamics
@@ -0,0 +1,108 @@
+// File: inc/poisson2d/fluid_dynamics/solver_amr.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_AMR_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_AMR_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "grid.h"
+#include "bound.h"
+#include "solver.h"
+
+namespace fluid_dynamics {
+
+// levels: refinement levels above the base level, every level halves the node spacing.
+// block_size: owned nodes per patch side.
+// boundary_distance: refine patches within this many nodes of an internal boundary, 0 disables.
+// gradient_threshold: refine patches where phi changes by more than this between neighbouring
+// nodes of the level, 0 disables.
+struct AmrOptions {
+  size_t levels = 2;
+  size_t block_size = 16;
+  size_t boundary_distance = 2;
+  double gradient_threshold = 0.0;
+}; // struct AmrOptions
+
+// A patch owns rows x cols nodes of its level starting at (row, col) and stores them with a one
+// node ghost ring, filled from neighbouring patches of the same level or interpolated from parent.
+template<typename T>
+struct AmrPatch {
+  size_t row;
+  size_t col;
+  size_t rows;
+  size_t cols;
+  size_t parent;
+  Grid<T> value;
+  Grid<T> next;
+  Grid<T> source;
+  Grid<T> fixed;
+  std::vector<unsigned char> kind;
+}; // struct AmrPatch
+
+// Level nodes sit on every stride-th node of the finest grid. The tile index maps the block grid
+// of the level to the patches that exist on it, or -1.
+template<typename T>
+struct AmrLevel {
+  size_t stride;
+  size_t rows;
+  size_t cols;
+  size_t tile_rows;
+  size_t tile_cols;
+  std::vector<long> tiles;
+  std::vector<AmrPatch<T>> patches;
+}; // struct AmrLevel
+
+// Vertex-centred block-structured AMR with the 5-point stencil. Patches are refined 2x2 into
+// children where the refinement criteria flag them, and all levels are swept together as one
+// composite problem. Parent nodes covered by a child take the child value, so the fine solution
+// around internal boundaries feeds back into the coarse levels.
+template<typename T>
+class SolverAmr : public Solver<T> {
+ public:
+  using Solver<T>::Solver;
+
+  [[nodiscard]] const AmrOptions& options() const;
+  [[nodiscard]] const std::vector<AmrLevel<T>>& levels() const;
+  [[nodiscard]] size_t patches(size_t level) const;
+  [[nodiscard]] size_t cells() const;
+  [[nodiscard]] size_t sweeps() const;
+
+  void options(const AmrOptions& options);
+
+  Grid<T> Solve(size_t rows, size_t cols, const Bound<T>& bound, bool verbose = false);
+  Grid<T> Composite();
+
+ private:
+  enum NodeKind : unsigned char {
+    kInterior,
+    kBoundary,
+    kKept,
+    kCovered
+  }; // enum NodeKind
+
+  AmrOptions options_;
+  std::vector<AmrLevel<T>> levels_;
+  size_t rows_ = 0;
+  size_t cols_ = 0;
+  size_t sweeps_ = 0;
+
+  void AddLevel(size_t stride, const std::vector<std::pair<size_t, size_t>>& tiles,
+                const std::vector<size_t>& parents, const Bound<T>& bound, const Grid<T>& source);
+  std::vector<size_t> Flag(const std::vector<unsigned char>& internal) const;
+  size_t Iterate(bool verbose);
+  void FillGhosts(size_t level);
+  T Sweep(size_t level);
+
+  [[nodiscard]] T ValueAt(size_t level, size_t i, size_t j, size_t hint) const;
+  [[nodiscard]] T Interpolate(size_t level, size_t i, size_t j, size_t parent) const;
+}; // class SolverAmr
+
+} // namespace fluid_dynamics
+
+#include "solver_amr.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_AMR_H_
@@ -0,0 +1,519 @@
+// File: inc/poisson2d/fluid_dynamics/solver_amr.tpp
+namespace fluid_dynamics {
+
+template<typename T>
+const AmrOptions& SolverAmr<T>::options() const {
+  return options_;
+}
+
+template<typename T>
+const std::vector<AmrLevel<T>>& SolverAmr<T>::levels() const {
+  return levels_;
+}
+
+template<typename T>
+size_t SolverAmr<T>::patches(size_t level) const {
+  return level < levels_.size() ? levels_[level].patches.size() : 0;
+}
+
+// Nodes that carry the composite solution, nodes covered by a finer level are not counted.
+template<typename T>
+size_t SolverAmr<T>::cells() const {
+  size_t count = 0;
+
+  for (const AmrLevel<T>& level : levels_) {
+    for (const AmrPatch<T>& patch : level.patches) {
+      count += static_cast<size_t>(std::count_if(patch.kind.begin(), patch.kind.end(), [](unsigned char kind) {
+        return kind != kCovered;
+      }));
+    }
+  }
+
+  return count;
+}
+
+template<typename T>
+size_t SolverAmr<T>::sweeps() const {
+  return sweeps_;
+}
+
+template<typename T>
+void SolverAmr<T>::options(const AmrOptions& options) {
+  if (options.block_size < 2) {
+    throw std::invalid_argument("Block size must be at least 2");
+  }
+  options_ = options;
+}
+
+// Solves on the base level, then adds one level at a time where the criteria flag patches of the
+// finest level and solves the composite problem again from the interpolated state.
+template<typename T>
+Grid<T> SolverAmr<T>::Solve(size_t rows, size_t cols, const Bound<T>& bound, bool verbose) {
+  size_t ratio = size_t{1} << options_.levels;
+
+  if (bound.type() == BoundaryType::kPeriodic) {
+    throw std::invalid_argument("SolverAmr does not support periodic bounds");
+  }
+  if (rows < 2 || cols < 2 || (rows - 1) % ratio != 0 || (cols - 1) % ratio != 0) {
+    throw std::invalid_argument("Grid dimensions minus one must be divisible by 2^levels");
+  }
+
+  Grid<T> source = Solver<T>::MaterializeSource(0, 0, rows, cols);
+  std::vector<unsigned char> internal(rows * cols, 0);
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(internal, bound, rows, cols)
+#endif
+  for (size_t i = 1; i < rows - 1; ++i) {
+    for (size_t j = 1; j < cols - 1; ++j) {
+      for (const Boundary<T>& boundary : bound.boundaries()) {
+        if (boundary.condition(i, j)) {
+          internal[i * cols + j] = 1;
+          break;
+        }
+      }
+    }
+  }
+
+  rows_ = rows;
+  cols_ = cols;
+  sweeps_ = 0;
+  levels_.clear();
+  AddLevel(ratio, {}, {}, bound, source);
+  sweeps_ += Iterate(verbose);
+
+  for (size_t level = 1; level <= options_.levels; ++level) {
+    std::vector<size_t> flagged = Flag(internal);
+    if (flagged.empty()) {
+      break;
+    }
+
+    const AmrLevel<T>& coarse = levels_.back();
+    std::vector<std::pair<size_t, size_t>> tiles;
+    std::vector<size_t> parents;
+    size_t tile_rows = (2 * coarse.rows - 1 + options_.block_size - 1) / options_.block_size;
+    size_t tile_cols = (2 * coarse.cols - 1 + options_.block_size - 1) / options_.block_size;
+    for (size_t p : flagged) {
+      size_t ti = coarse.patches[p].row / options_.block_size;
+      size_t tj = coarse.patches[p].col / options_.block_size;
+      for (size_t a = 2 * ti; a < std::min(2 * ti + 2, tile_rows); ++a) {
+        for (size_t b = 2 * tj; b < std::min(2 * tj + 2, tile_cols); ++b) {
+          tiles.emplace_back(a, b);
+          parents.push_back(p);
+        }
+      }
+    }
+    AddLevel(coarse.stride / 2, tiles, parents, bound, source);
+    sweeps_ += Iterate(verbose);
+  }
+
+  if (verbose) {
+    std::cout << "Composite cells: " << cells() << " of " << rows * cols << " on " << levels_.size()
+              << " levels" << std::endl;
+  }
+
+  // Boundary nodes between the nodes of the level sampled there are set exactly.
+  Grid<T> result = Composite();
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(result, bound, rows, cols)
+#endif
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      for (const Boundary<T>& boundary : bound.boundaries()) {
+        if (boundary.condition(i, j)) {
+          result(i, j) = boundary.value(i, j);
+          break;
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+// Samples the composite solution on the finest grid, every node reads the finest level owning it.
+template<typename T>
+Grid<T> SolverAmr<T>::Composite() {
+  Grid<T> result{rows_, cols_};
+
+  for (size_t l = 0; l < levels_.size(); ++l) {
+    FillGhosts(l);
+  }
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(result)
+#endif
+  for (size_t i = 0; i < rows_; ++i) {
+    for (size_t j = 0; j < cols_; ++j) {
+      for (size_t l = levels_.size(); l-- > 0;) {
+        const AmrLevel<T>& level = levels_[l];
+        size_t s = level.stride;
+        size_t ci = i / s;
+        size_t cj = j / s;
+        long t = level.tiles[(ci / options_.block_size) * level.tile_cols + cj / options_.block_size];
+        if (t < 0) {
+          continue;
+        }
+        const AmrPatch<T>& patch = level.patches[static_cast<size_t>(t)];
+        T di = static_cast<T>(i % s) / static_cast<T>(s);
+        T dj = static_cast<T>(j % s) / static_cast<T>(s);
+        size_t a = ci - patch.row + 1;
+        size_t b = cj - patch.col + 1;
+        T v00 = patch.value(a, b);
+        T v01 = dj > 0 ? patch.value(a, b + 1) : v00;
+        T v10 = di > 0 ? patch.value(a + 1, b) : v00;
+        T v11 = di > 0 && dj > 0 ? patch.value(a + 1, b + 1) : v00;
+        result(i, j) = (1 - di) * ((1 - dj) * v00 + dj * v01) + di * ((1 - dj) * v10 + dj * v11);
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
+// The base level is tiled completely when no tiles are given. New patches start from the parent
+// solution and mark the parent nodes they cover.
+template<typename T>
+void SolverAmr<T>::AddLevel(size_t stride, const std::vector<std::pair<size_t, size_t>>& tiles,
+                            const std::vector<size_t>& parents, const Bound<T>& bound, const Grid<T>& source) {
+  size_t block = options_.block_size;
+  size_t index = levels_.size();
+  AmrLevel<T> level;
+
+  level.stride = stride;
+  level.rows = (rows_ - 1) / stride + 1;
+  level.cols = (cols_ - 1) / stride + 1;
+  level.tile_rows = (level.rows + block - 1) / block;
+  level.tile_cols = (level.cols + block - 1) / block;
+  level.tiles.assign(level.tile_rows * level.tile_cols, -1);
+
+  std::vector<std::pair<size_t, size_t>> all;
+  const std::vector<std::pair<size_t, size_t>>* chosen = &tiles;
+  if (index == 0) {
+    for (size_t a = 0; a < level.tile_rows; ++a) {
+      for (size_t b = 0; b < level.tile_cols; ++b) {
+        all.emplace_back(a, b);
+      }
+    }
+    chosen = &all;
+  }
+
+  for (size_t k = 0; k < chosen->size(); ++k) {
+    auto [ti, tj] = (*chosen)[k];
+    AmrPatch<T> patch;
+    patch.row = ti * block;
+    patch.col = tj * block;
+    patch.rows = std::min(block, level.rows - patch.row);
+    patch.cols = std::min(block, level.cols - patch.col);
+    patch.parent = index == 0 ? 0 : parents[k];
+    patch.value = Grid<T>{patch.rows + 2, patch.cols + 2};
+    patch.source = Grid<T>{patch.rows, patch.cols};
+    patch.fixed = Grid<T>{patch.rows, patch.cols};
+    patch.kind.assign(patch.rows * patch.cols, kInterior);
+    level.tiles[ti * level.tile_cols + tj] = static_cast<long>(level.patches.size());
+    level.patches.push_back(std::move(patch));
+  }
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(level, bound, source, stride)
+#endif
+  for (size_t p = 0; p < level.patches.size(); ++p) {
+    AmrPatch<T>& patch = level.patches[p];
+    for (size_t a = 0; a < patch.rows; ++a) {
+      for (size_t b = 0; b < patch.cols; ++b) {
+        size_t i = (patch.row + a) * stride;
+        size_t j = (patch.col + b) * stride;
+        unsigned char& kind = patch.kind[a * patch.cols + b];
+        patch.source(a, b) = static_cast<T>(stride * stride) * source(i, j);
+        for (const Boundary<T>& boundary : bound.boundaries()) {
+          if (boundary.condition(i, j)) {
+            kind = kBoundary;
+            patch.fixed(a, b) = boundary.value(i, j);
+            break;
+          }
+        }
+        if (kind == kInterior && (i == 0 || j == 0 || i == rows_ - 1 || j == cols_ - 1)) {
+          kind = kKept;
+        }
+      }
+    }
+  }
+
+  levels_.push_back(std::move(level));
+  AmrLevel<T>& added = levels_.back();
+
+  // The base level starts from the source like the uniform solver. Interpolating a refined patch
+  // including its ghost ring needs the parent ghosts to be current.
+  if (index > 0) {
+    FillGhosts(index - 1);
+  }
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(added, index)
+#endif
+  for (size_t p = 0; p < added.patches.size(); ++p) {
+    AmrPatch<T>& patch = added.patches[p];
+    for (size_t a = 0; a < patch.rows; ++a) {
+      for (size_t b = 0; b < patch.cols; ++b) {
+        if (index == 0) {
+          patch.value(a + 1, b + 1) = patch.source(a, b) / static_cast<T>(added.stride * added.stride);
+        } else if (patch.kind[a * patch.cols + b] == kBoundary) {
+          patch.value(a + 1, b + 1) = patch.fixed(a, b);
+        } else {
+          patch.value(a + 1, b + 1) = Interpolate(index, patch.row + a, patch.col + b, patch.parent);
+        }
+      }
+    }
+    patch.next = patch.value;
+  }
+
+  if (index > 0) {
+    AmrLevel<T>& coarse = levels_[index - 1];
+    for (const AmrPatch<T>& patch : added.patches) {
+      AmrPatch<T>& parent = coarse.patches[patch.parent];
+      for (size_t a = 0; a < parent.rows; ++a) {
+        for (size_t b = 0; b < parent.cols; ++b) {
+          size_t i = 2 * (parent.row + a);
+          size_t j = 2 * (parent.col + b);
+          if (i >= patch.row && i < patch.row + patch.rows && j >= patch.col && j < patch.col + patch.cols) {
+            parent.kind[a * parent.cols + b] = kCovered;
+          }
+        }
+      }
+    }
+  }
+}
+
+// Flags patches of the finest level close to an internal boundary or with a steep solution.
+template<typename T>
+std::vector<size_t> SolverAmr<T>::Flag(const std::vector<unsigned char>& internal) const {
+  const AmrLevel<T>& level = levels_.back();
+  size_t s = level.stride;
+  size_t reach = options_.boundary_distance * s;
+  std::vector<unsigned char> flags(level.patches.size(), 0);
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(level, internal, flags, s, reach)
+#endif
+  for (size_t p = 0; p < level.patches.size(); ++p) {
+    const AmrPatch<T>& patch = level.patches[p];
+
+    if (options_.boundary_distance > 0) {
+      size_t i_begin = patch.row * s > reach ? patch.row * s - reach : 0;
+      size_t j_begin = patch.col * s > reach ? patch.col * s - reach : 0;
+      size_t i_end = std::min((patch.row + patch.rows) * s + reach, rows_);
+      size_t j_end = std::min((patch.col + patch.cols) * s + reach, cols_);
+      for (size_t i = i_begin; i < i_end && !flags[p]; ++i) {
+        for (size_t j = j_begin; j < j_end; ++j) {
+          if (internal[i * cols_ + j]) {
+            flags[p] = 1;
+            break;
+          }
+        }
+      }
+    }
+
+    if (options_.gradient_threshold > 0 && !flags[p]) {
+      for (size_t a = 0; a < patch.rows && !flags[p]; ++a) {
+        for (size_t b = 0; b < patch.cols; ++b) {
+          if (patch.kind[a * patch.cols + b] != kInterior) {
+            continue;
+          }
+          T dx = (patch.value(a + 1, b + 2) - patch.value(a + 1, b)) / 2;
+          T dy = (patch.value(a + 2, b + 1) - patch.value(a, b + 1)) / 2;
+          if (std::sqrt(dx * dx + dy * dy) > static_cast<T>(options_.gradient_threshold)) {
+            flags[p] = 1;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<size_t> flagged;
+  for (size_t p = 0; p < flags.size(); ++p) {
+    if (flags[p]) {
+      flagged.push_back(p);
+    }
+  }
+
+  return flagged;
+}
+
+template<typename T>
+size_t SolverAmr<T>::Iterate(bool verbose) {
+  size_t max_iter = Solver<T>::max_iter();
+  T epsilon = Solver<T>::epsilon();
+  Profiler& profiler = Solver<T>::profiler();
+  size_t progress_intervals = static_cast<size_t>(max_iter * 0.05);
+  size_t progress_steps = 0;
+  size_t iter;
+  T norm = 0;
+  bool converged = false;
+
+  profiler.Reset();
+  FDSIM_PROFILE_WORKLOAD(profiler, Phase::kStencil, 3 * cells() * sizeof(T), (FivePoint::kFlops + 3) * cells());
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (iter = 0; iter < max_iter; ++iter) {
+    {
+      FDSIM_PROFILE_SCOPE(profiler, Phase::kHaloExchange);
+      for (size_t l = 0; l < levels_.size(); ++l) {
+        FillGhosts(l);
+      }
+    }
+    {
+      FDSIM_PROFILE_SCOPE(profiler, Phase::kStencil);
+      norm = 0;
+      for (size_t l = 0; l < levels_.size(); ++l) {
+        norm += Sweep(l);
+      }
+      for (AmrLevel<T>& level : levels_) {
+        for (AmrPatch<T>& patch : level.patches) {
+          std::swap(patch.value, patch.next);
+        }
+      }
+    }
+    FDSIM_PROFILE_ITERATION(profiler, norm);
+
+    if (norm < epsilon) {
+      converged = true;
+      break;
+    }
+    if (verbose && iter == progress_steps * progress_intervals) {
+      Solver<T>::Progress(iter, max_iter);
+      ++progress_steps;
+    }
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<long double> time_taken = end - start;
+
+  if (verbose) {
+    Solver<T>::Progress(max_iter, max_iter);
+    std::cout << "Level " << levels_.size() - 1 << ", " << levels_.back().patches.size() << " patches" << std::endl;
+    if (converged) {
+      std::cout << "Number of iterations to converge: " << iter << std::endl;
+    } else {
+      std::cout << "Reached maximum number of iterations: " << max_iter << std::endl;
+      std::cout << "Norm: " << norm << std::endl;
+    }
+    std::cout << std::setprecision(6) << "Time Taken: " << time_taken.count() << "s" << std::endl;
+  }
+
+  return converged ? iter + 1 : max_iter;
+}
+
+// Ghost nodes owned by a patch of the same level are copied, the others are interpolated from the
+// parent level. Ghosts outside of the domain are never read since edge nodes are not relaxed.
+template<typename T>
+void SolverAmr<T>::FillGhosts(size_t level) {
+  AmrLevel<T>& lev = levels_[level];
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(lev, level)
+#endif
+  for (size_t p = 0; p < lev.patches.size(); ++p) {
+    AmrPatch<T>& patch = lev.patches[p];
+    auto fill = [&](size_t a, size_t b) {
+      size_t i = patch.row + a - 1;
+      size_t j = patch.col + b - 1;
+      if (patch.row + a == 0 || patch.col + b == 0 || i >= lev.rows || j >= lev.cols) {
+        return;
+      }
+      long t = lev.tiles[(i / options_.block_size) * lev.tile_cols + j / options_.block_size];
+      if (t >= 0) {
+        const AmrPatch<T>& owner = lev.patches[static_cast<size_t>(t)];
+        patch.value(a, b) = owner.value(i - owner.row + 1, j - owner.col + 1);
+      } else if (level > 0) {
+        patch.value(a, b) = Interpolate(level, i, j, patch.parent);
+      }
+    };
+
+    for (size_t b = 0; b < patch.cols + 2; ++b) {
+      fill(0, b);
+      fill(patch.rows + 1, b);
+    }
+    for (size_t a = 1; a < patch.rows + 1; ++a) {
+      fill(a, 0);
+      fill(a, patch.cols + 1);
+    }
+  }
+}
+
+// Covered nodes take the value of the finer level at the same position, so they are excluded from
+// the norm, which otherwise sums the squared change of every composite node.
+template<typename T>
+T SolverAmr<T>::Sweep(size_t level) {
+  AmrLevel<T>& lev = levels_[level];
+  T norm = 0;
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) shared(lev, level) reduction(+:norm)
+#endif
+  for (size_t p = 0; p < lev.patches.size(); ++p) {
+    AmrPatch<T>& patch = lev.patches[p];
+    auto stride = static_cast<std::ptrdiff_t>(patch.value.cols());
+    for (size_t a = 0; a < patch.rows; ++a) {
+      for (size_t b = 0; b < patch.cols; ++b) {
+        const T* center = &patch.value(a + 1, b + 1);
+        T& out = patch.next(a + 1, b + 1);
+        switch (patch.kind[a * patch.cols + b]) {
+          case kInterior:
+            out = Relax<FivePoint>(center, stride, patch.source(a, b));
+            break;
+          case kBoundary:
+            out = patch.fixed(a, b);
+            break;
+          case kKept:
+            out = *center;
+            break;
+          case kCovered:
+            out = ValueAt(level + 1, 2 * (patch.row + a), 2 * (patch.col + b), 0);
+            continue;
+        }
+        norm += (*center - out) * (*center - out);
+      }
+    }
+  }
+
+  return norm;
+}
+
+// Reads a node from the patch owning it, or from the ghost ring of the hint patch otherwise.
+template<typename T>
+T SolverAmr<T>::ValueAt(size_t level, size_t i, size_t j, size_t hint) const {
+  const AmrLevel<T>& lev = levels_[level];
+  long t = -1;
+
+  if (i < lev.rows && j < lev.cols) {
+    t = lev.tiles[(i / options_.block_size) * lev.tile_cols + j / options_.block_size];
+  }
+  const AmrPatch<T>& patch = lev.patches[t >= 0 ? static_cast<size_t>(t) : hint];
+
+  return patch.value(i - patch.row + 1, j - patch.col + 1);
+}
+
+// Bilinear interpolation from the parent level, level nodes between parent nodes are midpoints.
+template<typename T>
+T SolverAmr<T>::Interpolate(size_t level, size_t i, size_t j, size_t parent) const {
+  size_t ci = i / 2;
+  size_t cj = j / 2;
+  T value = ValueAt(level - 1, ci, cj, parent);
+
+  if (i % 2 == 1 && j % 2 == 1) {
+    value += ValueAt(level - 1, ci + 1, cj, parent) + ValueAt(level - 1, ci, cj + 1, parent)
+        + ValueAt(level - 1, ci + 1, cj + 1, parent);
+    return value / 4;
+  }
+  if (i % 2 == 1) {
+    return (value + ValueAt(level - 1, ci + 1, cj, parent)) / 2;
+  }
+  if (j % 2 == 1) {
+    return (value + ValueAt(level - 1, ci, cj + 1, parent)) / 2;
+  }
+
+  return value;
+}
+
+} // namespace fluid_dynamics
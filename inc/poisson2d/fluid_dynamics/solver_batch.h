@@ -0,0 +1,53 @@
+// File: inc/poisson2d/fluid_dynamics/solver_batch.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_BATCH_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_BATCH_H_
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "grid.h"
+#include "bound.h"
+#include "solver.h"
+
+namespace fluid_dynamics {
+
+// Solves a batch of problems that share the boundary conditions of the first Bound but have their
+// own boundary values and sources. Solve throws if a member covers any cell with another boundary. The members are stored interleaved (cell-major, member-minor)
+// so one sweep updates all of them with unit-stride vector loads. Members that converge are
+// retired and the remaining ones are repacked. Convergence uses the squared L2 norm per member.
+template<typename T, typename Stencil = FivePoint>
+class SolverBatch : public Solver<T, Stencil> {
+ public:
+  using Solver<T, Stencil>::Solver;
+
+  [[nodiscard]] const std::vector<size_t>& iterations() const;
+  [[nodiscard]] const std::vector<T>& norms() const;
+
+  std::vector<Grid<T>> Solve(size_t rows, size_t cols, const std::vector<Bound<T>>& bounds, bool verbose = false);
+  std::vector<Grid<T>> Solve(size_t rows, size_t cols, const std::vector<Bound<T>>& bounds,
+                             const std::vector<Grid<T>>& sources, bool verbose = false);
+
+ private:
+  enum class CellKind : unsigned char {
+    kFixed,
+    kBoundary,
+    kFallback,
+    kInterior
+  }; // enum class CellKind
+
+  std::vector<size_t> iterations_;
+  std::vector<T> norms_;
+
+  static size_t FirstBoundary(const Bound<T>& bound, size_t i, size_t j);
+  static Grid<T> Repack(const Grid<T>& grid, const std::vector<size_t>& keep);
+}; // class SolverBatch
+
+} // namespace fluid_dynamics
+
+#include "solver_batch.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_BATCH_H_
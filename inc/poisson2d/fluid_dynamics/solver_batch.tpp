@@ -0,0 +1,269 @@
+// File: inc/poisson2d/fluid_dynamics/solver_batch.tpp
+namespace fluid_dynamics {
+
+template<typename T, typename Stencil>
+const std::vector<size_t>& SolverBatch<T, Stencil>::iterations() const {
+  return iterations_;
+}
+
+template<typename T, typename Stencil>
+const std::vector<T>& SolverBatch<T, Stencil>::norms() const {
+  return norms_;
+}
+
+template<typename T, typename Stencil>
+std::vector<Grid<T>> SolverBatch<T, Stencil>::Solve(size_t rows, size_t cols, const std::vector<Bound<T>>& bounds,
+                                                    bool verbose) {
+  std::vector<Grid<T>> sources(bounds.size(), Solver<T, Stencil>::MaterializeSource(0, 0, rows, cols));
+
+  return Solve(rows, cols, bounds, sources, verbose);
+}
+
+template<typename T, typename Stencil>
+std::vector<Grid<T>> SolverBatch<T, Stencil>::Solve(size_t rows, size_t cols, const std::vector<Bound<T>>& bounds,
+                                                    const std::vector<Grid<T>>& sources, bool verbose) {
+  size_t members = bounds.size();
+  size_t cells = rows * cols;
+  size_t radius = Stencil::kRadius;
+  size_t max_iter = Solver<T, Stencil>::max_iter();
+  T epsilon = Solver<T, Stencil>::epsilon();
+  Profiler& profiler = Solver<T, Stencil>::profiler();
+  size_t progress_intervals = static_cast<size_t>(max_iter * 0.05);
+  size_t progress_steps = 0;
+  size_t iter;
+
+  if (members == 0) {
+    throw std::invalid_argument("Batch must contain at least one member");
+  }
+  if (bounds[0].type() == BoundaryType::kPeriodic) {
+    throw std::invalid_argument("SolverBatch does not support periodic bounds");
+  }
+  if (sources.size() != members) {
+    throw std::invalid_argument("Number of sources does not match the number of bounds");
+  }
+  for (size_t m = 0; m < members; ++m) {
+    if (bounds[m].size() != bounds[0].size()) {
+      throw std::invalid_argument("Bounds in a batch must share their boundary conditions");
+    }
+    if (sources[m].rows() != rows || sources[m].cols() != cols) {
+      throw std::invalid_argument("Source grid does not match the dimensions of the solve");
+    }
+  }
+
+  // The conditions of the first member classify every cell once for the whole batch.
+  std::vector<CellKind> kind(cells, CellKind::kInterior);
+  std::vector<size_t> fixed_index(cells, 0);
+  std::vector<size_t> boundary_cells;
+  std::vector<size_t> boundary_ids;
+
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      size_t c = i * cols + j;
+      size_t k = FirstBoundary(bounds[0], i, j);
+      if (k < bounds[0].size()) {
+        kind[c] = CellKind::kBoundary;
+        fixed_index[c] = boundary_cells.size();
+        boundary_cells.push_back(c);
+        boundary_ids.push_back(k);
+        continue;
+      }
+      if (i == 0 || j == 0 || i == rows - 1 || j == cols - 1) {
+        kind[c] = CellKind::kFixed;
+      } else if (i < radius || i >= rows - radius || j < radius || j >= cols - radius) {
+        kind[c] = CellKind::kFallback;
+      }
+    }
+  }
+
+  // Every other member has to pick the same boundary at every cell, or its values would be sampled
+  // at cells its conditions do not cover.
+  for (size_t m = 1; m < members; ++m) {
+    for (size_t c = 0; c < cells; ++c) {
+      size_t k = kind[c] == CellKind::kBoundary ? boundary_ids[fixed_index[c]] : bounds[0].size();
+      if (FirstBoundary(bounds[m], c / cols, c % cols) != k) {
+        throw std::invalid_argument("Bounds in a batch must share their boundary conditions, member "
+                                    + std::to_string(m) + " differs at cell (" + std::to_string(c / cols)
+                                    + ", " + std::to_string(c % cols) + ")");
+      }
+    }
+  }
+
+  Grid<T> prev{cells, members};
+  Grid<T> next{cells, members};
+  Grid<T> source{cells, members};
+  Grid<T> fixed{boundary_cells.size(), members};
+  Grid<T> row_norms{rows, members};
+  std::vector<T> lane_norms(members, 0);
+  std::vector<size_t> lanes(members);
+  std::vector<Grid<T>> results(members);
+
+  for (size_t m = 0; m < members; ++m) {
+    lanes[m] = m;
+    for (size_t c = 0; c < cells; ++c) {
+      source(c, m) = sources[m](c / cols, c % cols);
+      prev(c, m) = source(c, m);
+    }
+    for (size_t k = 0; k < boundary_cells.size(); ++k) {
+      fixed(k, m) = bounds[m].boundaries()[boundary_ids[k]].value(boundary_cells[k] / cols, boundary_cells[k] % cols);
+    }
+  }
+
+  iterations_.assign(members, max_iter);
+  norms_.assign(members, 0);
+  profiler.Reset();
+  FDSIM_PROFILE_WORKLOAD(profiler, Phase::kStencil, 3 * cells * members * sizeof(T),
+                         (Stencil::kFlops + 3) * cells * members);
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (iter = 0; iter < max_iter && !lanes.empty(); ++iter) {
+    size_t width = lanes.size();
+    auto step = static_cast<std::ptrdiff_t>(width);
+    auto stride = static_cast<std::ptrdiff_t>(cols * width);
+    T max_norm = 0;
+
+    {
+      FDSIM_PROFILE_SCOPE(profiler, Phase::kStencil);
+#ifdef _OPENMP
+      #pragma omp parallel for default(none) \
+              shared(prev, next, source, fixed, row_norms, kind, fixed_index, rows, cols, width, step, stride)
+#endif
+      for (size_t i = 0; i < rows; ++i) {
+        T* row_norm = row_norms.data(i, 0);
+        std::fill_n(row_norm, width, T{0});
+        for (size_t j = 0; j < cols; ++j) {
+          size_t c = i * cols + j;
+          const T* center = &prev(c, 0);
+          const T* rhs = &source(c, 0);
+          T* out = next.data(c, 0);
+          switch (kind[c]) {
+            case CellKind::kInterior:
+#ifdef _OPENMP
+              #pragma omp simd
+#endif
+              for (size_t b = 0; b < width; ++b) {
+                out[b] = Relax<Stencil>(center + b, stride, step, rhs[b]);
+              }
+              break;
+            case CellKind::kFallback:
+#ifdef _OPENMP
+              #pragma omp simd
+#endif
+              for (size_t b = 0; b < width; ++b) {
+                out[b] = Relax<FivePoint>(center + b, stride, step, rhs[b]);
+              }
+              break;
+            case CellKind::kBoundary:
+              std::copy_n(&fixed(fixed_index[c], 0), width, out);
+              break;
+            case CellKind::kFixed:
+              std::copy_n(center, width, out);
+              break;
+          }
+#ifdef _OPENMP
+          #pragma omp simd
+#endif
+          for (size_t b = 0; b < width; ++b) {
+            row_norm[b] += (center[b] - out[b]) * (center[b] - out[b]);
+          }
+        }
+      }
+    }
+    {
+      FDSIM_PROFILE_SCOPE(profiler, Phase::kNorm);
+      std::fill_n(lane_norms.begin(), width, T{0});
+      for (size_t i = 0; i < rows; ++i) {
+        for (size_t b = 0; b < width; ++b) {
+          lane_norms[b] += row_norms(i, b);
+        }
+      }
+    }
+
+    std::vector<size_t> keep;
+    for (size_t b = 0; b < width; ++b) {
+      max_norm = std::max(max_norm, lane_norms[b]);
+      if (lane_norms[b] < epsilon) {
+        size_t m = lanes[b];
+        iterations_[m] = iter + 1;
+        norms_[m] = lane_norms[b];
+        results[m] = Grid<T>{rows, cols};
+        for (size_t c = 0; c < cells; ++c) {
+          results[m].data()[c] = next(c, b);
+        }
+      } else {
+        keep.push_back(b);
+      }
+    }
+    FDSIM_PROFILE_ITERATION(profiler, max_norm);
+
+    if (keep.size() < width) {
+      std::vector<size_t> remaining;
+      std::vector<T> remaining_norms;
+      for (size_t b : keep) {
+        remaining.push_back(lanes[b]);
+        remaining_norms.push_back(lane_norms[b]);
+      }
+      lanes = std::move(remaining);
+      std::copy(remaining_norms.begin(), remaining_norms.end(), lane_norms.begin());
+      prev = Repack(next, keep);
+      next = Grid<T>{cells, keep.size()};
+      source = Repack(source, keep);
+      fixed = Repack(fixed, keep);
+    } else {
+      std::swap(prev, next);
+    }
+
+    if (verbose && iter == progress_steps * progress_intervals) {
+      Solver<T, Stencil>::Progress(iter, max_iter);
+      ++progress_steps;
+    }
+  }
+
+  for (size_t b = 0; b < lanes.size(); ++b) {
+    size_t m = lanes[b];
+    norms_[m] = lane_norms[b];
+    results[m] = Grid<T>{rows, cols};
+    for (size_t c = 0; c < cells; ++c) {
+      results[m].data()[c] = prev(c, b);
+    }
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<long double> time_taken = end - start;
+
+  if (verbose) {
+    Solver<T, Stencil>::Progress(max_iter, max_iter);
+    std::cout << "Converged members: " << members - lanes.size() << "/" << members << std::endl;
+    std::cout << "Number of sweeps: " << iter << std::endl;
+    std::cout << std::setprecision(6) << "Time Taken: " << time_taken.count() << "s" << std::endl;
+  }
+
+  return results;
+}
+
+// Index of the first boundary whose condition covers the cell, the number of boundaries if none does.
+template<typename T, typename Stencil>
+size_t SolverBatch<T, Stencil>::FirstBoundary(const Bound<T>& bound, size_t i, size_t j) {
+  const auto& boundaries = bound.boundaries();
+
+  for (size_t k = 0; k < boundaries.size(); ++k) {
+    if (boundaries[k].condition(i, j)) {
+      return k;
+    }
+  }
+  return boundaries.size();
+}
+
+template<typename T, typename Stencil>
+Grid<T> SolverBatch<T, Stencil>::Repack(const Grid<T>& grid, const std::vector<size_t>& keep) {
+  Grid<T> packed{grid.rows(), keep.size()};
+
+  for (size_t r = 0; r < grid.rows(); ++r) {
+    for (size_t b = 0; b < keep.size(); ++b) {
+      packed(r, b) = grid(r, keep[b]);
+    }
+  }
+
+  return packed;
+}
+
+} // namespace fluid_dynamics
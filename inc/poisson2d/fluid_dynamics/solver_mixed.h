@@ -0,0 +1,59 @@
+// File: inc/poisson2d/fluid_dynamics/solver_mixed.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_MIXED_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_MIXED_H_
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include "grid.h"
+#include "ghosted_grid.h"
+#include "bound.h"
+#include "bound_mask.h"
+#include "stencil.h"
+#include "solver.h"
+
+namespace fluid_dynamics {
+
+namespace mixed_detail {
+
+template<typename Low, typename T> Bound<Low> CorrectionBound(const Bound<T>& bound);
+template<typename T> void FixBoundaries(GhostedGrid<T>& solution, const BoundMask<T>& mask);
+template<typename Stencil, typename T>
+T Residual(const GhostedGrid<T>& solution, const Grid<T>& source, const BoundMask<T>& mask, Grid<T>& residual);
+template<typename Low> Low InnerEpsilon(double reduction, double norm);
+
+} // namespace mixed_detail
+
+// Mixed precision iterative refinement. The residual of the current solution is evaluated in T,
+// the correction is solved with Jacobi sweeps in Low under homogeneous bounds and added in T.
+// Every correction only has to reduce the squared norm by inner_reduction, the solve stops once
+// the squared change a sweep in T would make drops below epsilon. iterations() counts the sweeps
+// in Low over all refinements.
+template<typename T, typename Stencil = FivePoint, typename Low = float>
+class SolverMixed : public Solver<T, Stencil> {
+ public:
+  using Solver<T, Stencil>::Solver;
+
+  [[nodiscard]] T inner_reduction() const;
+  [[nodiscard]] size_t max_refinements() const;
+  [[nodiscard]] size_t refinements() const;
+
+  void inner_reduction(T inner_reduction);
+  void max_refinements(size_t max_refinements);
+
+  Grid<T> Solve(size_t rows, size_t cols, const Bound<T>& bound, bool verbose = false);
+
+ private:
+  T inner_reduction_ = 1e-4;
+  size_t max_refinements_ = 100;
+  size_t refinements_ = 0;
+}; // class SolverMixed
+
+} // namespace fluid_dynamics
+
+#include "solver_mixed.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_MIXED_H_
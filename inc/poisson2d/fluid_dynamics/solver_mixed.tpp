@@ -0,0 +1,157 @@
+// File: inc/poisson2d/fluid_dynamics/solver_mixed.tpp
+namespace fluid_dynamics {
+
+namespace mixed_detail {
+
+// Same conditions as bound with zero values, corrections never move boundary cells.
+template<typename Low, typename T>
+Bound<Low> CorrectionBound(const Bound<T>& bound) {
+  Bound<Low> correction{bound};
+
+  for (Boundary<Low>& boundary : correction.boundaries()) {
+    boundary.value = [](size_t, size_t) -> Low { return Low{0}; };
+  }
+
+  return correction;
+}
+
+template<typename T>
+void FixBoundaries(GhostedGrid<T>& solution, const BoundMask<T>& mask) {
+  size_t halo = solution.ghost();
+
+  for (size_t i = 0; i < solution.rows(); ++i) {
+    for (size_t j = 0; j < solution.cols(); ++j) {
+      if (mask.kind(i + halo, j + halo) == CellKind::kBoundary) {
+        solution(i, j) = mask.value(i + halo, j + halo);
+      }
+    }
+  }
+}
+
+// Writes the residual in units of the source, so that it can be the source of the correction, and
+// returns the squared change of one Jacobi sweep from solution. The ghost cells have to be current.
+template<typename Stencil, typename T>
+T Residual(const GhostedGrid<T>& solution, const Grid<T>& source, const BoundMask<T>& mask, Grid<T>& residual) {
+  constexpr T kScale = static_cast<T>(Stencil::kCenter / (Stencil::kSourceWeight * Stencil::kRelaxation));
+  constexpr T kFallbackScale = static_cast<T>(FivePoint::kCenter / FivePoint::kSourceWeight);
+  auto stride = static_cast<std::ptrdiff_t>(solution.stride());
+  size_t halo = solution.ghost();
+  size_t rows = solution.rows();
+  size_t cols = solution.cols();
+  T norm = 0;
+
+#ifdef _OPENMP
+  #pragma omp parallel for default(none) collapse(2) reduction(+ : norm) \
+          shared(solution, source, mask, residual, stride, halo, rows, cols)
+#endif
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      const T* center = solution.data(i, j);
+      T update = 0;
+      T scale = 0;
+      switch (mask.kind(i + halo, j + halo)) {
+        case CellKind::kInterior:
+          update = Relax<Stencil>(center, stride, source(i, j)) - *center;
+          scale = kScale;
+          break;
+        case CellKind::kFallback:
+          update = Relax<FivePoint>(center, stride, source(i, j)) - *center;
+          scale = kFallbackScale;
+          break;
+        default:
+          break;
+      }
+      residual(i, j) = scale * update;
+      norm += update * update;
+    }
+  }
+
+  return norm;
+}
+
+// The squared norm the correction has to reach, kept above the smallest normal value of Low.
+template<typename Low>
+Low InnerEpsilon(double reduction, double norm) {
+  return static_cast<Low>(std::clamp(reduction * norm, static_cast<double>(std::numeric_limits<Low>::min()),
+                                     static_cast<double>(std::numeric_limits<Low>::max())));
+}
+
+} // namespace mixed_detail
+
+template<typename T, typename Stencil, typename Low>
+T SolverMixed<T, Stencil, Low>::inner_reduction() const {
+  return inner_reduction_;
+}
+
+template<typename T, typename Stencil, typename Low>
+size_t SolverMixed<T, Stencil, Low>::max_refinements() const {
+  return max_refinements_;
+}
+
+template<typename T, typename Stencil, typename Low>
+size_t SolverMixed<T, Stencil, Low>::refinements() const {
+  return refinements_;
+}
+
+template<typename T, typename Stencil, typename Low>
+void SolverMixed<T, Stencil, Low>::inner_reduction(T inner_reduction) {
+  inner_reduction_ = inner_reduction;
+}
+
+template<typename T, typename Stencil, typename Low>
+void SolverMixed<T, Stencil, Low>::max_refinements(size_t max_refinements) {
+  max_refinements_ = max_refinements;
+}
+
+// Starts from the source like Solver, uncovered edge cells keep that value since their correction
+// starts and stays at zero.
+template<typename T, typename Stencil, typename Low>
+Grid<T> SolverMixed<T, Stencil, Low>::Solve(size_t rows, size_t cols, const Bound<T>& bound, bool verbose) {
+  constexpr size_t kHalo = Stencil::kRadius;
+  if (bound.type() == BoundaryType::kPeriodic) {
+    throw std::invalid_argument("SolverMixed does not support periodic bounds");
+  }
+  BoundMask<T> mask{bound, rows, cols, kHalo, Stencil::kRadius};
+  Grid<T> source = Solver<T, Stencil>::MaterializeSource(0, 0, rows, cols);
+  GhostedGrid<T> solution{source, kHalo, Solver<T, Stencil>::resource()};
+  Grid<T> residual{rows, cols, Solver<T, Stencil>::resource()};
+  Grid<Low> zero{rows, cols, Solver<T, Stencil>::resource()};
+  Bound<Low> correction_bound = mixed_detail::CorrectionBound<Low>(bound);
+  Solver<Low, Stencil> low{Solver<T, Stencil>::max_iter()};
+  size_t sweeps = 0;
+
+  low.pool(Solver<T, Stencil>::pool());
+  auto start = std::chrono::high_resolution_clock::now();
+  mixed_detail::FixBoundaries(solution, mask);
+  T norm = mixed_detail::Residual<Stencil>(solution, source, mask, residual);
+  for (refinements_ = 0; norm >= Solver<T, Stencil>::epsilon() && refinements_ < max_refinements_; ++refinements_) {
+    low.epsilon(mixed_detail::InnerEpsilon<Low>(inner_reduction_, norm));
+    low.source(Grid<Low>{residual});
+    Grid<Low> correction = low.Solve(rows, cols, correction_bound, zero);
+    sweeps += low.iterations();
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < cols; ++j) {
+        solution(i, j) += static_cast<T>(correction(i, j));
+      }
+    }
+    norm = mixed_detail::Residual<Stencil>(solution, source, mask, residual);
+  }
+  Solver<T, Stencil>::iterations(sweeps);
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<long double> time_taken = end - start;
+
+  if (verbose) {
+    if (norm < Solver<T, Stencil>::epsilon()) {
+      std::cout << "Number of refinements to converge: " << refinements_ << std::endl;
+    } else {
+      std::cout << "Reached maximum number of refinements: " << max_refinements_ << std::endl;
+      std::cout << "Norm: " << norm << std::endl;
+    }
+    std::cout << "Sweeps in reduced precision: " << sweeps << std::endl;
+    std::cout << std::setprecision(6) << "Time taken: " << time_taken.count() << "s" << std::endl;
+  }
+
+  return solution.Interior();
+}
+
+} // namespace fluid_dynamics
@@ -0,0 +1,48 @@
+// File: inc/poisson2d/fluid_dynamics/solver_mixed_mpi.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_MIXED_MPI_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_MIXED_MPI_H_
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include "grid.h"
+#include "ghosted_grid.h"
+#include "bound.h"
+#include "bound_mask.h"
+#include "solver_mixed.h"
+#include "solver_mpi.h"
+#include "mpi_util.h"
+
+namespace fluid_dynamics {
+
+// SolverMixed on an MpiGrid2D. Residuals exchange their halos in T, the corrections are solved by a
+// SolverMpi in Low on the same process grid.
+template<typename T, typename Stencil = FivePoint, typename Low = float>
+class SolverMixedMpi : public SolverMpi<T, Stencil> {
+ public:
+  using SolverMpi<T, Stencil>::SolverMpi;
+
+  [[nodiscard]] T inner_reduction() const;
+  [[nodiscard]] size_t max_refinements() const;
+  [[nodiscard]] size_t refinements() const;
+
+  void inner_reduction(T inner_reduction);
+  void max_refinements(size_t max_refinements);
+
+  Grid<T> Solve(size_t rows, size_t cols, Bound<T>& global_bound, MpiGrid2D& mpi_grid, bool verbose = false);
+
+ private:
+  T inner_reduction_ = 1e-4;
+  size_t max_refinements_ = 100;
+  size_t refinements_ = 0;
+
+  T GlobalResidual(GhostedGrid<T>& solution, const Grid<T>& source, const BoundMask<T>& mask, Grid<T>& residual,
+                   MpiGrid2D& mpi_grid);
+}; // class SolverMixedMpi
+
+} // namespace fluid_dynamics
+
+#include "solver_mixed_mpi.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_MIXED_MPI_H_
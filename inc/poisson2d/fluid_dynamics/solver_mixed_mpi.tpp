@@ -0,0 +1,98 @@
+// File: inc/poisson2d/fluid_dynamics/solver_mixed_mpi.tpp
+namespace fluid_dynamics {
+
+template<typename T, typename Stencil, typename Low>
+T SolverMixedMpi<T, Stencil, Low>::inner_reduction() const {
+  return inner_reduction_;
+}
+
+template<typename T, typename Stencil, typename Low>
+size_t SolverMixedMpi<T, Stencil, Low>::max_refinements() const {
+  return max_refinements_;
+}
+
+template<typename T, typename Stencil, typename Low>
+size_t SolverMixedMpi<T, Stencil, Low>::refinements() const {
+  return refinements_;
+}
+
+template<typename T, typename Stencil, typename Low>
+void SolverMixedMpi<T, Stencil, Low>::inner_reduction(T inner_reduction) {
+  inner_reduction_ = inner_reduction;
+}
+
+template<typename T, typename Stencil, typename Low>
+void SolverMixedMpi<T, Stencil, Low>::max_refinements(size_t max_refinements) {
+  max_refinements_ = max_refinements;
+}
+
+// Uncovered edge cells of the global domain are relaxed like in SolverMpi. The correction solver
+// starts from its source, the residual, which only changes the initial guess.
+template<typename T, typename Stencil, typename Low>
+Grid<T> SolverMixedMpi<T, Stencil, Low>::Solve(size_t rows, size_t cols, Bound<T>& global_bound, MpiGrid2D& mpi_grid,
+                                               bool verbose) {
+  constexpr size_t kHalo = Stencil::kRadius;
+  if (global_bound.type() == BoundaryType::kPeriodic) {
+    throw std::invalid_argument("SolverMixedMpi does not support periodic bounds");
+  }
+  size_t origin_row = mpi_grid.GlobalRow(0, rows);
+  size_t origin_col = mpi_grid.GlobalCol(0, cols);
+  BoundMask<T> mask{global_bound, rows, cols, kHalo, Stencil::kRadius, origin_row, origin_col,
+                    rows * mpi_grid.rows(), cols * mpi_grid.cols(), false};
+  Grid<T> source = Solver<T, Stencil>::MaterializeSource(origin_row, origin_col, rows, cols);
+  GhostedGrid<T> solution{source, kHalo, Solver<T, Stencil>::resource()};
+  Grid<T> residual{rows, cols, Solver<T, Stencil>::resource()};
+  Bound<Low> correction_bound = mixed_detail::CorrectionBound<Low>(global_bound);
+  SolverMpi<Low, Stencil> low{Solver<T, Stencil>::max_iter()};
+  size_t sweeps = 0;
+
+  low.pool(Solver<T, Stencil>::pool());
+  auto start = std::chrono::high_resolution_clock::now();
+  mixed_detail::FixBoundaries(solution, mask);
+  T norm = GlobalResidual(solution, source, mask, residual, mpi_grid);
+  for (refinements_ = 0; norm >= Solver<T, Stencil>::epsilon() && refinements_ < max_refinements_; ++refinements_) {
+    low.epsilon(mixed_detail::InnerEpsilon<Low>(inner_reduction_, norm));
+    low.source(Grid<Low>{residual});
+    Grid<Low> correction = low.Solve(rows, cols, correction_bound, mpi_grid);
+    sweeps += low.iterations();
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < cols; ++j) {
+        solution(i, j) += static_cast<T>(correction(i, j));
+      }
+    }
+    norm = GlobalResidual(solution, source, mask, residual, mpi_grid);
+  }
+  Solver<T, Stencil>::iterations(sweeps);
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<long double> time_taken = end - start;
+
+  if (verbose && mpi_grid.rank() == 0) {
+    if (norm < Solver<T, Stencil>::epsilon()) {
+      std::cout << "Number of refinements to converge: " << refinements_ << std::endl;
+    } else {
+      std::cout << "Reached maximum number of refinements: " << max_refinements_ << std::endl;
+      std::cout << "Norm: " << norm << std::endl;
+    }
+    std::cout << "Sweeps in reduced precision: " << sweeps << std::endl;
+    std::cout << std::setprecision(6) << "Time taken: " << time_taken.count() << "s" << std::endl;
+  }
+
+  return solution.Interior();
+}
+
+// The halo types only live for the exchange, the correction solve creates its own on mpi_grid.
+template<typename T, typename Stencil, typename Low>
+T SolverMixedMpi<T, Stencil, Low>::GlobalResidual(GhostedGrid<T>& solution, const Grid<T>& source,
+                                                  const BoundMask<T>& mask, Grid<T>& residual, MpiGrid2D& mpi_grid) {
+  T local_norm, global_norm;
+
+  mpi_grid.CreateHaloTypes(solution, MpiType<T>());
+  SolverMpi<T, Stencil>::ExchangeBoundaryData(solution.padded(), mpi_grid);
+  mpi_grid.FreeTypes();
+  local_norm = mixed_detail::Residual<Stencil>(solution, source, mask, residual);
+  MPI_Allreduce(&local_norm, &global_norm, 1, MpiType<T>(), MPI_SUM, mpi_grid.comm());
+
+  return global_norm;
+}
+
+} // namespace fluid_dynamics
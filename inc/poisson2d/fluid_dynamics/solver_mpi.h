@@ -2,33 +2,78 @@
 #ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_MPI_H_
 #define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_MPI_H_
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <cmath>
 #include <vector>
 #include <functional>
+#include <stdexcept>
 #include "grid.h"
 #include "bound.h"
+#include "bound_mask.h"
+#include "distributed_grid.h"
 #include "solver.h"
 #include "mpi_util.h"
+#include "resident_memory.h"
+#include "row_window.h"
 
 namespace fluid_dynamics {
 
-template<typename T>
-class SolverMpi : public Solver<T> {
+template<typename T, typename Stencil = FivePoint>
+class SolverMpi : public Solver<T, Stencil> {
  public:
-  using Solver<T>::Solver;
+  using Solver<T, Stencil>::Solver;
+
+  [[nodiscard]] T float_halos() const;
+  [[nodiscard]] bool compensated_norm() const;
+
+  void float_halos(T switch_norm);
+  void compensated_norm(bool compensated_norm);
 
   Grid<T> Solve(size_t rows, size_t cols, Bound<T>& global_bound, MpiGrid2D& mpi_grid, bool verbose = false);
   Grid<std::pair<T, T>> Gradient(const Grid<T>& field, MpiGrid2D& mpi_grid);
   Grid<std::pair<T, T>> Velocity(const Grid<std::pair<T, T>>& grad) override;
+  DistributedGrid<T> Solve(const DistributedGrid<T>& layout, Bound<T>& global_bound, bool verbose = false);
+  DistributedGrid<std::pair<T, T>> Gradient(const DistributedGrid<T>& field);
+  DistributedGrid<std::pair<T, T>> Velocity(const DistributedGrid<std::pair<T, T>>& grad);
+
+ protected:
+  static constexpr size_t kHalo = Stencil::kRadius;
+
+  // Thread parts of the norm are a cache line apart.
+  static constexpr size_t kPartStride = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+
+  size_t IterateRegion(Grid<T>& prev, Grid<T>& curr, const Grid<T>& source, const BoundMask<T>& mask,
+                       MpiGrid2D& mpi_grid, bool verbose, T& global_norm, bool& converged);
+  static void CopyHalo(const Grid<T>& from, Grid<T>& to);
+  static T SweepRows(const Grid<T>& prev, Grid<T>& next, const Grid<T>& source, const BoundMask<T>& mask,
+                     size_t row_begin, size_t row_end);
+  static T SweepRowsInPlace(Grid<T>& grid, const Grid<T>& source, const BoundMask<T>& mask, size_t row_begin,
+                            size_t row_end, RowWindow<T>& window, const std::vector<T>& tail);
+  void UpdateTiles(const Grid<T>& prev, Grid<T>& next, Bound<T>& local_bound, const Grid<T>& source,
+                   MpiGrid2D& mpi_grid, ActiveSet<T>& active);
+  static void WakeFromHalo(const Grid<T>& grid, ActiveSet<T>& active, std::vector<T>& halo);
+  void ExchangeBoundaryData(Grid<T>& grid, MpiGrid2D& mpi_grid);
+  void ExchangeFloatBoundaryData(Grid<T>& grid, MpiGrid2D& mpi_grid);
+  void ExchangeHalos(Grid<T>& grid, MpiGrid2D& mpi_grid);
+  void ReduceSums(const T* sums, const T* compensations, T* global_sums, int count, MpiGrid2D& mpi_grid);
+  size_t IterateInPlace(Grid<T>& solution, Grid<T>& scratch, const Grid<T>& source, T scale,
+                        const BoundMask<T>& mask, MpiGrid2D& mpi_grid);
 
  private:
-  Grid<T> Update(const Grid<T>& prev, Bound<T>& local_bound, MpiGrid2D& mpi_grid);
   Bound<T> LocalBoundaries(const Bound<T>& global_bound, size_t rows, size_t cols, MpiGrid2D& mpi_grid);
   bool TestBoundary(const Boundary<T>& boundary, size_t rows, size_t cols, MpiGrid2D& mpi_grid);
-  void ExchangeBoundaryData(Grid<T>& grid, MpiGrid2D& mpi_grid);
+
+  T float_halos_ = 0;
+  bool compensated_norm_ = false;
+  bool halos_in_float_ = false;
+  T switch_norm_ = 0;
+  MPI_Datatype sum_type_ = MPI_DATATYPE_NULL;
+  MPI_Op sum_op_ = MPI_OP_NULL;
+  std::vector<float> halo_send_;
+  std::vector<float> halo_recv_;
 }; // class SolverMpi
 
 } // namespace fluid_dynamics
@@ -1,94 +1,429 @@
-// File: inc/poisson2d/fluid_dynamics/solver_mpi.h
+// File: inc/poisson2d/fluid_dynamics/solver_mpi.tpp
 namespace fluid_dynamics {
 
-template<typename T>
-Grid<T> SolverMpi<T>::Solve(size_t rows, size_t cols, Bound<T>& global_bound, MpiGrid2D& mpi_grid, bool verbose) {
-  Grid<T> prev{rows, cols};
-  Grid<T> curr{rows, cols};
+template<typename T, typename Stencil>
+T SolverMpi<T, Stencil>::float_halos() const {
+  return float_halos_;
+}
+
+template<typename T, typename Stencil>
+bool SolverMpi<T, Stencil>::compensated_norm() const {
+  return compensated_norm_;
+}
+
+// Halos travel as float until the squared global norm drops below switch_norm and in full
+// precision from then on, 0 keeps them in T. Only has an effect for types wider than float. The
+// switch is raised to epsilon if it lies below, and a sweep on float halos never counts as
+// converged, so the last sweep of a converged solve always saw exact halos.
+template<typename T, typename Stencil>
+void SolverMpi<T, Stencil>::float_halos(T switch_norm) {
+  float_halos_ = switch_norm;
+}
+
+// Sums the norm with compensated summation, within the rank and in MPI_Allreduce. This shrinks the
+// rounding error of the sum and with it the effect of the reduction order on the convergence test,
+// but does not remove it.
+template<typename T, typename Stencil>
+void SolverMpi<T, Stencil>::compensated_norm(bool compensated_norm) {
+  compensated_norm_ = compensated_norm;
+}
+
+// Without an active set the whole solve runs in one parallel region, see IterateRegion.
+template<typename T, typename Stencil>
+Grid<T> SolverMpi<T, Stencil>::Solve(size_t rows, size_t cols, Bound<T>& global_bound, MpiGrid2D& mpi_grid, bool verbose) {
+  GhostedGrid<T> prev_block{rows, cols, kHalo, Solver<T, Stencil>::resource()};
+  Grid<T>& prev = prev_block.padded();
   Bound<T> local_bound{LocalBoundaries(global_bound, rows, cols, mpi_grid)};
-  size_t origin_row = mpi_grid.GlobalRow(0, prev.rows());
-  size_t origin_col = mpi_grid.GlobalCol(0, prev.cols());
+  Profiler& profiler = Solver<T, Stencil>::profiler();
+  size_t origin_row = mpi_grid.GlobalRow(0, rows);
+  size_t origin_col = mpi_grid.GlobalCol(0, cols);
   T local_norm, global_norm;
   size_t iter;
   bool converged = false;
-  int progress_intervals = static_cast<int>(Solver<T>::max_iter() * 0.05);
+  int progress_intervals = static_cast<int>(Solver<T, Stencil>::max_iter() * 0.05);
   int progress_steps = 0;
 
-  #pragma omp parallel for default(none) collapse(2) shared(prev, origin_row, origin_col)
-  for (size_t i = 0; i < prev.rows(); ++i) {
-    for (size_t j = 0; j < prev.cols(); ++j) {
-      prev(i, j) = Solver<T>::source(origin_row + i, origin_col + j);
-    }
+  if (global_bound.type() == BoundaryType::kPeriodic && !mpi_grid.periodic()) {
+    throw std::invalid_argument("Periodic bounds need an MpiGrid2D with a periodic topology");
   }
 
-  mpi_grid.CreateRowType(prev.cols(), MpiType<T>());
-  mpi_grid.CreateColType(prev.rows(), prev.cols() + 2, MpiType<T>());
-  prev.Resize(prev.rows() + 2, prev.cols() + 2, {1, 1});
-  curr.Resize(curr.rows() + 2, curr.cols() + 2, {1, 1});
+  Grid<T> source = Solver<T, Stencil>::MaterializeSource(origin_row, origin_col, rows, cols);
+  ActiveSet<T>* active = Solver<T, Stencil>::StartActiveSet(rows, cols, false, static_cast<size_t>(mpi_grid.size()));
+  // In place the second block is never touched and stays empty.
+  bool in_place = Solver<T, Stencil>::low_memory() && !active && !Solver<T, Stencil>::custom_norm();
+  GhostedGrid<T> curr_block = in_place ? GhostedGrid<T>{} : GhostedGrid<T>{rows, cols, kHalo, Solver<T, Stencil>::resource()};
+  Grid<T>& curr = in_place ? prev : curr_block.padded();
+  std::vector<T> halo;
+  T compensation = 0;
+  unsigned long frozen, global_frozen;
+  MPI_Request frozen_request;
+  bool float_sweep;
+
+  if (Solver<T, Stencil>::report_peak_memory()) {
+    ResetPeakResidentMemory();
+  }
+  prev_block.Assign(source);
+
+  mpi_grid.CreateHaloTypes(prev_block, MpiType<T>());
+  halos_in_float_ = sizeof(T) > sizeof(float) && float_halos_ > 0;
+  switch_norm_ = std::max(float_halos_, Solver<T, Stencil>::epsilon());
+  if (compensated_norm_) {
+    MPI_Type_contiguous(2, MpiType<T>(), &sum_type_);
+    MPI_Type_commit(&sum_type_);
+    MPI_Op_create(&CompensatedSumOp<T>, 1, &sum_op_);
+  }
+  if (active) {
+    curr = prev;
+  }
 
+  profiler.Reset();
+  FDSIM_PROFILE_WORKLOAD(profiler, Phase::kHaloExchange,
+                         4 * kHalo * (rows + cols + 2 * kHalo) * sizeof(T), 0);
+  FDSIM_PROFILE_WORKLOAD(profiler, Phase::kStencil, 2 * rows * cols * sizeof(T),
+                         Stencil::kFlops * rows * cols);
+  FDSIM_PROFILE_WORKLOAD(profiler, Phase::kNorm, 2 * rows * cols * sizeof(T), 3 * rows * cols);
   auto start = std::chrono::high_resolution_clock::now();
 
-  for (iter = 0; iter < Solver<T>::max_iter(); ++iter) {
-    ExchangeBoundaryData(prev, mpi_grid);
-    curr = Update(prev, local_bound, mpi_grid);
-
-    local_norm = Solver<T>::norm(prev, curr, true);
-    MPI_Allreduce(&local_norm, &global_norm, 1, MpiType<T>(), MPI_SUM, mpi_grid.comm());
-    if (global_norm < Solver<T>::epsilon()) {
-      converged = true;
-      break;
-    }
+  if (!active) {
+    BoundMask<T> mask{local_bound, rows, cols, kHalo, Stencil::kRadius, origin_row, origin_col,
+                      rows * mpi_grid.rows(), cols * mpi_grid.cols(), false};
+    iter = IterateRegion(prev, curr, source, mask, mpi_grid, verbose, global_norm, converged);
+  } else {
+    for (iter = 0; iter < Solver<T, Stencil>::max_iter(); ++iter) {
+      {
+        FDSIM_PROFILE_SCOPE(profiler, Phase::kHaloExchange);
+        float_sweep = halos_in_float_;
+        ExchangeHalos(prev, mpi_grid);
+        WakeFromHalo(prev, *active, halo);
+      }
+      {
+        FDSIM_PROFILE_SCOPE(profiler, Phase::kStencil);
+        UpdateTiles(prev, curr, local_bound, source, mpi_grid, *active);
+      }
+      {
+        FDSIM_PROFILE_SCOPE(profiler, Phase::kNorm);
+        local_norm = active->norm();
+      }
+      {
+        FDSIM_PROFILE_SCOPE(profiler, Phase::kAllreduce);
+        // A converged norm only counts when no rank skipped a tile. The frozen tile count is summed as
+        // an integer while the norm is reduced.
+        frozen = active->frozen_count();
+        MPI_Iallreduce(&frozen, &global_frozen, 1, MPI_UNSIGNED_LONG, MPI_SUM, mpi_grid.comm(), &frozen_request);
+        ReduceSums(&local_norm, &compensation, &global_norm, 1, mpi_grid);
+        MPI_Wait(&frozen_request, MPI_STATUS_IGNORE);
+        halos_in_float_ = halos_in_float_ && global_norm >= switch_norm_;
+      }
+      FDSIM_PROFILE_ITERATION(profiler, global_norm);
+      if (global_norm < Solver<T, Stencil>::epsilon() && global_frozen == 0 && !float_sweep) {
+        converged = true;
+        break;
+      }
 
-    prev = curr;
+      Solver<T, Stencil>::CopyTiles(curr, prev, *active, kHalo);
+      active->Advance();
+      if (global_norm < Solver<T, Stencil>::epsilon()) {
+        active->ActivateAll();
+      }
 
-    if (verbose && mpi_grid.rank() == 0 && iter == progress_steps * progress_intervals) {
-      Solver<T>::Progress(iter, Solver<T>::max_iter());
-      ++progress_steps;
+      if (verbose && mpi_grid.rank() == 0 && iter == progress_steps * progress_intervals) {
+        Solver<T, Stencil>::Progress(iter, Solver<T, Stencil>::max_iter());
+        ++progress_steps;
+      }
     }
   }
 
   auto end = std::chrono::high_resolution_clock::now();
   std::chrono::duration<long double> time_taken = end - start;
+  Solver<T, Stencil>::iterations(converged ? iter + 1 : iter);
+  Solver<T, Stencil>::peak_memory(Solver<T, Stencil>::report_peak_memory() ? PeakResidentMemory() : 0);
+  unsigned long long peak_memory = Solver<T, Stencil>::peak_memory();
+  if (Solver<T, Stencil>::report_peak_memory()) {
+    MPI_Reduce(mpi_grid.rank() == 0 ? MPI_IN_PLACE : &peak_memory, &peak_memory, 1, MPI_UNSIGNED_LONG_LONG,
+               MPI_MAX, 0, mpi_grid.comm());
+  }
 
   if (verbose && mpi_grid.rank() == 0) {
-    Solver<T>::Progress(Solver<T>::max_iter(), Solver<T>::max_iter());
+    Solver<T, Stencil>::Progress(Solver<T, Stencil>::max_iter(), Solver<T, Stencil>::max_iter());
     if (converged) {
       std::cout << "Number of iterations to converge: " << iter << std::endl;
     } else {
-      std::cout << "Reached maximum number of iterations: " << Solver<T>::max_iter() << std::endl;
+      std::cout << "Reached maximum number of iterations: " << Solver<T, Stencil>::max_iter() << std::endl;
       std::cout << "Norm: " << global_norm << std::endl;
     }
+    if (peak_memory > 0) {
+      std::cout << "Peak resident memory per rank: " << peak_memory / (1024 * 1024) << " MiB" << std::endl;
+    }
     std::cout << std::setprecision(6) << "Time taken: " << time_taken.count() << "s" << std::endl;
   }
 
-  curr.Resize(curr.rows() - 2, curr.cols() - 2, {-1, -1});
-
   mpi_grid.FreeTypes();
+  if (compensated_norm_) {
+    MPI_Op_free(&sum_op_);
+    MPI_Type_free(&sum_type_);
+  }
+
+  return (in_place ? prev_block : curr_block).Interior();
+}
+
+// One parallel region for the whole solve. Every thread relaxes a fixed band of rows and keeps its
+// part of the norm, the master thread exchanges the halo, sums the parts in thread order, reduces
+// them across ranks and swaps the grids, which needs MPI_THREAD_FUNNELED. With a custom norm the
+// master thread evaluates it instead, on the padded blocks after copying the halo across. Leaves the
+// last sweep in curr and returns the iteration that converged, or max_iter. Passing the same grid
+// twice relaxes it in place: each thread copies the rows around its band before any thread writes,
+// see SweepRowsInPlace.
+template<typename T, typename Stencil>
+size_t SolverMpi<T, Stencil>::IterateRegion(Grid<T>& prev, Grid<T>& curr, const Grid<T>& source,
+                                            const BoundMask<T>& mask, MpiGrid2D& mpi_grid, bool verbose,
+                                            T& global_norm, bool& converged) {
+  [[maybe_unused]] Profiler& profiler = Solver<T, Stencil>::profiler();
+  size_t max_iter = Solver<T, Stencil>::max_iter();
+  T epsilon = Solver<T, Stencil>::epsilon();
+  bool custom_norm = Solver<T, Stencil>::custom_norm();
+  Grid<T>* from = &prev;
+  Grid<T>* to = &curr;
+  size_t iter = max_iter;
+  int progress_intervals = static_cast<int>(max_iter * 0.05);
+  int progress_steps = 0;
+  int threads = 1;
+#ifdef _OPENMP
+  threads = omp_get_max_threads();
+#endif
+  std::vector<T> parts(static_cast<size_t>(threads) * kPartStride, 0);
+  bool in_place = &prev == &curr;
+  bool float_sweep = false;
+
+  #pragma omp parallel
+  {
+    size_t thread = 0;
+    size_t team = 1;
+#ifdef _OPENMP
+    thread = static_cast<size_t>(omp_get_thread_num());
+    team = static_cast<size_t>(omp_get_num_threads());
+#endif
+    size_t row_begin = kHalo + mask.rows() * thread / team;
+    size_t row_end = kHalo + mask.rows() * (thread + 1) / team;
+    RowWindow<T> window = in_place ? RowWindow<T>{kHalo, prev.cols()} : RowWindow<T>{};
+    std::vector<T> tail(in_place ? kHalo * prev.cols() : 0);
+
+    for (size_t it = 0; it < max_iter; ++it) {
+      #pragma omp master
+      {
+        FDSIM_PROFILE_SCOPE(profiler, Phase::kHaloExchange);
+        float_sweep = halos_in_float_;
+        ExchangeHalos(*from, mpi_grid);
+      }
+      #pragma omp barrier
+      if (in_place) {
+        {
+          FDSIM_PROFILE_SCOPE(profiler, Phase::kStencil);
+          window.Reset(row_begin - kHalo);
+          for (size_t i = row_begin - kHalo; i < row_begin; ++i) {
+            window.Push(from->data(i, 0));
+          }
+          std::copy_n(from->data(row_end, 0), tail.size(), tail.data());
+        }
+        #pragma omp barrier
+        {
+          FDSIM_PROFILE_SCOPE(profiler, Phase::kStencil);
+          parts[thread * kPartStride] = SweepRowsInPlace(*from, source, mask, row_begin, row_end, window, tail);
+        }
+      } else {
+        FDSIM_PROFILE_SCOPE(profiler, Phase::kStencil);
+        parts[thread * kPartStride] = SweepRows(*from, *to, source, mask, row_begin, row_end);
+      }
+      #pragma omp barrier
+      #pragma omp master
+      {
+        T local_norm = 0;
+        T compensation = 0;
+        {
+          FDSIM_PROFILE_SCOPE(profiler, Phase::kNorm);
+          if (custom_norm) {
+            CopyHalo(*from, *to);
+            local_norm = Solver<T, Stencil>::norm(*from, *to, true);
+          } else if (compensated_norm_) {
+            for (size_t t = 0; t < team; ++t) {
+              CompensatedAdd(parts[t * kPartStride], T{0}, local_norm, compensation);
+            }
+          } else {
+            for (size_t t = 0; t < team; ++t) {
+              local_norm += parts[t * kPartStride];
+            }
+          }
+        }
+        {
+          FDSIM_PROFILE_SCOPE(profiler, Phase::kAllreduce);
+          ReduceSums(&local_norm, &compensation, &global_norm, 1, mpi_grid);
+          halos_in_float_ = halos_in_float_ && global_norm >= switch_norm_;
+        }
+        FDSIM_PROFILE_ITERATION(profiler, global_norm);
+        if (global_norm < epsilon && !float_sweep) {
+          converged = true;
+          iter = it;
+        } else {
+          std::swap(from, to);
+          if (verbose && mpi_grid.rank() == 0 && it == progress_steps * progress_intervals) {
+            Solver<T, Stencil>::Progress(it, max_iter);
+            ++progress_steps;
+          }
+        }
+      }
+      #pragma omp barrier
+      if (converged) {
+        break;
+      }
+    }
+  }
+
+  // Without convergence the last sweep was swapped into from.
+  if (!in_place && (converged ? to : from) != &curr) {
+    std::swap(prev, curr);
+  }
+  return iter;
+}
+
+// Copies the kHalo ghost rings of from into to. The sweeps never write them, and a norm over the
+// padded blocks that only skips the outer ring would otherwise see the deeper rings change.
+template<typename T, typename Stencil>
+void SolverMpi<T, Stencil>::CopyHalo(const Grid<T>& from, Grid<T>& to) {
+  size_t rows = from.rows();
+  size_t cols = from.cols();
+
+  for (size_t i = 0; i < rows; ++i) {
+    if (i < kHalo || i >= rows - kHalo) {
+      std::copy_n(&from(i, 0), cols, to.data(i, 0));
+    } else {
+      std::copy_n(&from(i, 0), kHalo, to.data(i, 0));
+      std::copy_n(&from(i, cols - kHalo), kHalo, to.data(i, cols - kHalo));
+    }
+  }
+}
+
+// Relaxes rows [row_begin, row_end) of the padded block with the compiled mask and returns the
+// squared change, the source is not padded.
+template<typename T, typename Stencil>
+T SolverMpi<T, Stencil>::SweepRows(const Grid<T>& prev, Grid<T>& next, const Grid<T>& source,
+                                   const BoundMask<T>& mask, size_t row_begin, size_t row_end) {
+  auto stride = static_cast<std::ptrdiff_t>(prev.cols());
+  size_t col_end = kHalo + mask.cols();
+  T norm = 0;
+
+  for (size_t i = row_begin; i < row_end; ++i) {
+    for (size_t j = kHalo; j < col_end; ++j) {
+      T value;
+      switch (mask.kind(i, j)) {
+        case CellKind::kInterior:
+          value = Relax<Stencil>(&prev(i, j), stride, source(i - kHalo, j - kHalo));
+          break;
+        case CellKind::kFallback:
+          value = Relax<FivePoint>(&prev(i, j), stride, source(i - kHalo, j - kHalo));
+          break;
+        case CellKind::kBoundary:
+          value = mask.value(i, j);
+          break;
+        default:
+          value = prev(i, j);
+          break;
+      }
+      norm += (value - prev(i, j)) * (value - prev(i, j));
+      next(i, j) = value;
+    }
+  }
+
+  return norm;
+}
+
+// As SweepRows on a single grid. The window starts with the kHalo rows above the band and tail
+// holds the kHalo rows below it, both copied before the sweep, the rows of the band are pushed
+// into the window before they are overwritten.
+template<typename T, typename Stencil>
+T SolverMpi<T, Stencil>::SweepRowsInPlace(Grid<T>& grid, const Grid<T>& source, const BoundMask<T>& mask,
+                                          size_t row_begin, size_t row_end, RowWindow<T>& window,
+                                          const std::vector<T>& tail) {
+  auto stride = static_cast<std::ptrdiff_t>(grid.cols());
+  size_t col_end = kHalo + mask.cols();
+  T norm = 0;
+
+  for (size_t i = row_begin; i < row_end; ++i) {
+    while (window.end() <= i + kHalo) {
+      size_t k = window.end();
+      window.Push(k < row_end ? grid.data(k, 0) : tail.data() + (k - row_end) * grid.cols());
+    }
+    const T* old = window.row(i);
+    for (size_t j = kHalo; j < col_end; ++j) {
+      T value;
+      switch (mask.kind(i, j)) {
+        case CellKind::kInterior:
+          value = Relax<Stencil>(old + j, stride, source(i - kHalo, j - kHalo));
+          break;
+        case CellKind::kFallback:
+          value = Relax<FivePoint>(old + j, stride, source(i - kHalo, j - kHalo));
+          break;
+        case CellKind::kBoundary:
+          value = mask.value(i, j);
+          break;
+        default:
+          value = old[j];
+          break;
+      }
+      norm += (value - old[j]) * (value - old[j]);
+      grid(i, j) = value;
+    }
+  }
+
+  return norm;
+}
+
+// Solves on the decomposition of layout, its values are not used.
+template<typename T, typename Stencil>
+DistributedGrid<T> SolverMpi<T, Stencil>::Solve(const DistributedGrid<T>& layout, Bound<T>& global_bound, bool verbose) {
+  MpiGrid2D& mpi_grid = layout.mpi_grid();
+  return {mpi_grid, Solve(layout.local().rows(), layout.local().cols(), global_bound, mpi_grid, verbose)};
+}
+
+template<typename T, typename Stencil>
+DistributedGrid<std::pair<T, T>> SolverMpi<T, Stencil>::Gradient(const DistributedGrid<T>& field) {
+  return {field.mpi_grid(), Gradient(field.local(), field.mpi_grid())};
+}
 
-  return curr;
+template<typename T, typename Stencil>
+DistributedGrid<std::pair<T, T>> SolverMpi<T, Stencil>::Velocity(const DistributedGrid<std::pair<T, T>>& grad) {
+  return {grad.mpi_grid(), Velocity(grad.local())};
 }
 
-template<typename T>
-Grid<std::pair<T, T>> SolverMpi<T>::Gradient(const Grid<T>& field, MpiGrid2D& mpi_grid) {
-  Grid<T> expanded_field{field};
-  Grid<std::pair<T, T>> grad{field.rows(), field.cols()};
+template<typename T, typename Stencil>
+Grid<std::pair<T, T>> SolverMpi<T, Stencil>::Gradient(const Grid<T>& field, MpiGrid2D& mpi_grid) {
+  GhostedGrid<T> expanded_field{field, kHalo, Solver<T, Stencil>::resource()};
+  Grid<std::pair<T, T>> grad{field.rows(), field.cols(), Solver<T, Stencil>::resource()};
+  size_t origin_row = mpi_grid.GlobalRow(0, field.rows());
+  size_t origin_col = mpi_grid.GlobalCol(0, field.cols());
+  size_t global_rows = field.rows() * mpi_grid.rows();
+  size_t global_cols = field.cols() * mpi_grid.cols();
   size_t start_row = (mpi_grid.row() == 0) ? 1 : 0;
   size_t start_col = (mpi_grid.col() == 0) ? 1 : 0;
   size_t end_row = (mpi_grid.row() == mpi_grid.rows() - 1) ? field.rows() - 1 : field.rows();
   size_t end_col = (mpi_grid.col() == mpi_grid.cols() - 1) ? field.cols() - 1 : field.cols();
+  auto stride = static_cast<std::ptrdiff_t>(expanded_field.stride());
 
-  mpi_grid.CreateRowType(field.cols(), MpiType<T>());
-  mpi_grid.CreateColType(field.rows(), field.cols() + 2, MpiType<T>());
-  expanded_field.Resize(expanded_field.rows() + 2, expanded_field.cols() + 2, {1, 1});
-
-  ExchangeBoundaryData(expanded_field, mpi_grid);
+  mpi_grid.CreateHaloTypes(expanded_field, MpiType<T>());
+  ExchangeBoundaryData(expanded_field.padded(), mpi_grid);
 
   #pragma omp parallel for default(none) collapse(2) \
-          shared(expanded_field, grad, start_row, end_row, start_col, end_col)
+          shared(expanded_field, grad, start_row, end_row, start_col, end_col, \
+                 origin_row, origin_col, global_rows, global_cols, stride)
   for (size_t i = start_row; i < end_row; ++i) {
     for (size_t j = start_col; j < end_col; ++j) {
-      grad(i, j).first = (expanded_field(i + 1, j + 2) - expanded_field(i + 1, j)) / 2;
-      grad(i, j).second = (expanded_field(i + 2, j + 1) - expanded_field(i, j + 1)) / 2;
+      size_t global_i = origin_row + i;
+      size_t global_j = origin_col + j;
+      const T* center = expanded_field.data(i, j);
+      if (kHalo > 1 && (global_i < kHalo || global_i >= global_rows - kHalo
+                        || global_j < kHalo || global_j >= global_cols - kHalo)) {
+        grad(i, j) = GradientAt<FivePoint>(center, stride);
+      } else {
+        grad(i, j) = GradientAt<Stencil>(center, stride);
+      }
     }
   }
 
@@ -97,9 +432,9 @@ Grid<std::pair<T, T>> SolverMpi<T>::Gradient(const Grid<T>& field, MpiGrid2D& mp
   return grad;
 }
 
-template<typename T>
-Grid<std::pair<T, T>> SolverMpi<T>::Velocity(const Grid<std::pair<T, T>>& grad) {
-  Grid<std::pair<T, T>> velocity{grad.rows(), grad.cols()};
+template<typename T, typename Stencil>
+Grid<std::pair<T, T>> SolverMpi<T, Stencil>::Velocity(const Grid<std::pair<T, T>>& grad) {
+  Grid<std::pair<T, T>> velocity{grad.rows(), grad.cols(), Solver<T, Stencil>::resource()};
 
   #pragma omp parallel for default(none) collapse(2) shared(grad, velocity)
   for (size_t i = 0; i < grad.rows(); ++i) {
@@ -117,40 +452,93 @@ Grid<std::pair<T, T>> SolverMpi<T>::Velocity(const Grid<std::pair<T, T>>& grad)
 }
 
 
-template<typename T>
-Grid<T> SolverMpi<T>::Update(const Grid<T>& prev, Bound<T>& local_bound, MpiGrid2D& mpi_grid) {
-  Grid<T> next{prev.rows(), prev.cols()};
-  size_t origin_row = mpi_grid.GlobalRow(0, prev.rows() - 2);
-  size_t origin_col = mpi_grid.GlobalCol(0, prev.cols() - 2);
-  bool is_boundary = false;
-
-  #pragma omp parallel for default(none) collapse(2) schedule(guided) \
-          shared(prev, next, local_bound, origin_row, origin_col) private(is_boundary)
-  for (size_t i = 1; i < prev.rows() - 1; ++i) {
-    for (size_t j = 1; j < prev.cols() - 1; ++j) {
-      for (Boundary<T> boundary : local_bound.boundaries()) {
-        if (boundary.condition(origin_row + i - 1, origin_col + j - 1)) {
-          next(i, j) = boundary.value(origin_row + i - 1, origin_col + j - 1);
-          is_boundary = true;
-          break;
+// Relaxes the active tiles of the local block, the cells are treated as in SweepRows.
+template<typename T, typename Stencil>
+void SolverMpi<T, Stencil>::UpdateTiles(const Grid<T>& prev, Grid<T>& next, Bound<T>& local_bound,
+                                        const Grid<T>& source, MpiGrid2D& mpi_grid, ActiveSet<T>& active) {
+  const std::vector<size_t>& tiles = active.active();
+  size_t origin_row = mpi_grid.GlobalRow(0, prev.rows() - 2 * kHalo);
+  size_t origin_col = mpi_grid.GlobalCol(0, prev.cols() - 2 * kHalo);
+  size_t global_rows = (prev.rows() - 2 * kHalo) * mpi_grid.rows();
+  size_t global_cols = (prev.cols() - 2 * kHalo) * mpi_grid.cols();
+  auto stride = static_cast<std::ptrdiff_t>(prev.cols());
+
+  #pragma omp parallel for default(none) schedule(dynamic) \
+          shared(prev, next, local_bound, source, active, tiles, origin_row, origin_col, \
+                 global_rows, global_cols, stride)
+  for (size_t k = 0; k < tiles.size(); ++k) {
+    size_t t = tiles[k];
+    T change = 0;
+    for (size_t i = active.RowBegin(t); i < active.RowEnd(t); ++i) {
+      for (size_t j = active.ColBegin(t); j < active.ColEnd(t); ++j) {
+        size_t global_i = origin_row + i;
+        size_t global_j = origin_col + j;
+        const T* center = &prev(i + kHalo, j + kHalo);
+        T& out = next(i + kHalo, j + kHalo);
+        bool is_boundary = false;
+        for (const Boundary<T>& boundary : local_bound.boundaries()) {
+          if (boundary.condition(global_i, global_j)) {
+            out = boundary.value(global_i, global_j);
+            is_boundary = true;
+            break;
+          }
         }
+        if (!is_boundary) {
+          if (kHalo > 1 && (global_i < kHalo || global_i >= global_rows - kHalo
+                            || global_j < kHalo || global_j >= global_cols - kHalo)) {
+            out = Relax<FivePoint>(center, stride, source(i, j));
+          } else {
+            out = Relax<Stencil>(center, stride, source(i, j));
+          }
+        }
+        change += (*center - out) * (*center - out);
       }
-      if (!is_boundary) {
-        next(i, j) = 0.25 * (prev(i - 1, j) + prev(i + 1, j) + prev(i, j - 1) + prev(i, j + 1)
-                             + Solver<T>::source(origin_row + i - 1, origin_col + j - 1));
-      }
-      is_boundary = false;
     }
+    active.Record(t, change);
   }
+}
 
-  return next;
+// Compares the received halo with the one of the previous sweep and wakes the frozen tiles next to
+// a part of the halo that changed by at least the threshold, the neighbouring rank is still relaxing there.
+template<typename T, typename Stencil>
+void SolverMpi<T, Stencil>::WakeFromHalo(const Grid<T>& grid, ActiveSet<T>& active, std::vector<T>& halo) {
+  size_t rows = grid.rows() - 2 * kHalo;
+  size_t cols = grid.cols() - 2 * kHalo;
+  bool first = halo.empty();
+  std::vector<T> changes(active.size(), 0);
+  size_t k = 0;
+
+  if (first) {
+    halo.resize(grid.rows() * grid.cols() - rows * cols);
+  }
+  for (size_t i = 0; i < grid.rows(); ++i) {
+    bool halo_row = i < kHalo || i >= rows + kHalo;
+    for (size_t j = 0; j < grid.cols(); ++j) {
+      if (!halo_row && j >= kHalo && j < cols + kHalo) {
+        continue;
+      }
+      size_t ci = std::min(std::max(i, kHalo), rows + kHalo - 1) - kHalo;
+      size_t cj = std::min(std::max(j, kHalo), cols + kHalo - 1) - kHalo;
+      T diff = grid(i, j) - halo[k];
+      changes[active.TileOf(ci, cj)] += diff * diff;
+      halo[k++] = grid(i, j);
+    }
+  }
+  if (first) {
+    return;
+  }
+  for (size_t t = 0; t < changes.size(); ++t) {
+    if (active.frozen(t) && changes[t] >= active.threshold()) {
+      active.Activate(t);
+    }
+  }
 }
 
-template<typename T>
-Bound<T> SolverMpi<T>::LocalBoundaries(const Bound<T>& global_bound, size_t rows, size_t cols, MpiGrid2D& mpi_grid) {
+template<typename T, typename Stencil>
+Bound<T> SolverMpi<T, Stencil>::LocalBoundaries(const Bound<T>& global_bound, size_t rows, size_t cols, MpiGrid2D& mpi_grid) {
   Bound<T> local_bound(global_bound.type());
 
-  for (Boundary<T> b : global_bound.boundaries()) {
+  for (const Boundary<T>& b : global_bound.boundaries()) {
     if (TestBoundary(b, rows, cols, mpi_grid)) {
       local_bound.AddBoundary(b);
     }
@@ -159,14 +547,20 @@ Bound<T> SolverMpi<T>::LocalBoundaries(const Bound<T>& global_bound, size_t rows
   return local_bound;
 }
 
-template<typename T>
-bool SolverMpi<T>::TestBoundary(const Boundary<T>& boundary, size_t rows, size_t cols, MpiGrid2D& mpi_grid) {
+// Boundaries listing their cells are kept when their box meets the block, which may keep one that
+// has no cell here but costs nothing in the mask. Others are scanned within their box.
+template<typename T, typename Stencil>
+bool SolverMpi<T, Stencil>::TestBoundary(const Boundary<T>& boundary, size_t rows, size_t cols, MpiGrid2D& mpi_grid) {
   size_t origin_row = mpi_grid.GlobalRow(0, rows);
   size_t origin_col = mpi_grid.GlobalCol(0, cols);
+  CellBox clip = boundary.box.Intersect({origin_row, origin_row + rows, origin_col, origin_col + cols});
 
-  for (size_t i = 0; i < rows; ++i) {
-    for (size_t j = 0; j < cols; ++j) {
-      if (boundary.condition(origin_row + i, origin_col + j)) {
+  if (boundary.cells || clip.empty()) {
+    return !clip.empty();
+  }
+  for (size_t i = clip.row_begin; i < clip.row_end; ++i) {
+    for (size_t j = clip.col_begin; j < clip.col_end; ++j) {
+      if (boundary.condition(i, j)) {
         return true;
       }
     }
@@ -174,20 +568,119 @@ bool SolverMpi<T>::TestBoundary(const Boundary<T>& boundary, size_t rows, size_t
   return false;
 }
 
-template<typename T>
-void SolverMpi<T>::ExchangeBoundaryData(Grid<T>& grid, MpiGrid2D& mpi_grid) {
-  MPI_Sendrecv(grid.data(1, 1), 1, mpi_grid.row_type(), mpi_grid.top(), 0,
-               grid.data(grid.rows() - 1, 1), 1, mpi_grid.row_type(), mpi_grid.bot(), 0,
+// As Solver::IterateInPlace, with the halo types of mpi_grid created by the caller for the padded block.
+template<typename T, typename Stencil>
+size_t SolverMpi<T, Stencil>::IterateInPlace(Grid<T>& solution, Grid<T>& scratch, const Grid<T>& source, T scale,
+                                             const BoundMask<T>& mask, MpiGrid2D& mpi_grid) {
+  [[maybe_unused]] Profiler& profiler = Solver<T, Stencil>::profiler();
+  T local_norm, global_norm;
+  size_t iter;
+
+  for (iter = 0; iter < Solver<T, Stencil>::max_iter(); ++iter) {
+    {
+      FDSIM_PROFILE_SCOPE(profiler, Phase::kHaloExchange);
+      ExchangeBoundaryData(solution, mpi_grid);
+    }
+    {
+      FDSIM_PROFILE_SCOPE(profiler, Phase::kStencil);
+      local_norm = Solver<T, Stencil>::Sweep(solution, scratch, source, scale, mask);
+    }
+    {
+      FDSIM_PROFILE_SCOPE(profiler, Phase::kAllreduce);
+      MPI_Allreduce(&local_norm, &global_norm, 1, MpiType<T>(), MPI_SUM, mpi_grid.comm());
+    }
+    std::swap(solution, scratch);
+    FDSIM_PROFILE_ITERATION(profiler, global_norm);
+    if (global_norm < Solver<T, Stencil>::epsilon()) {
+      return iter + 1;
+    }
+  }
+
+  return Solver<T, Stencil>::max_iter();
+}
+
+template<typename T, typename Stencil>
+void SolverMpi<T, Stencil>::ExchangeBoundaryData(Grid<T>& grid, MpiGrid2D& mpi_grid) {
+  MPI_Sendrecv(grid.data(kHalo, kHalo), 1, mpi_grid.row_type(), mpi_grid.top(), 0,
+               grid.data(grid.rows() - kHalo, kHalo), 1, mpi_grid.row_type(), mpi_grid.bot(), 0,
                mpi_grid.comm(), MPI_STATUS_IGNORE);
-  MPI_Sendrecv(grid.data(grid.rows() - 2, 1), 1, mpi_grid.row_type(), mpi_grid.bot(), 0,
-               grid.data(0, 1), 1, mpi_grid.row_type(), mpi_grid.top(), 0,
+  MPI_Sendrecv(grid.data(grid.rows() - 2 * kHalo, kHalo), 1, mpi_grid.row_type(), mpi_grid.bot(), 0,
+               grid.data(0, kHalo), 1, mpi_grid.row_type(), mpi_grid.top(), 0,
                mpi_grid.comm(), MPI_STATUS_IGNORE);
-  MPI_Sendrecv(grid.data(1, 1), 1, mpi_grid.col_type(), mpi_grid.left(), 1,
-               grid.data(1, grid.cols() - 1), 1, mpi_grid.col_type(), mpi_grid.right(), 1,
+  MPI_Sendrecv(grid.data(0, kHalo), 1, mpi_grid.col_type(), mpi_grid.left(), 1,
+               grid.data(0, grid.cols() - kHalo), 1, mpi_grid.col_type(), mpi_grid.right(), 1,
                mpi_grid.comm(), MPI_STATUS_IGNORE);
-  MPI_Sendrecv(grid.data(1, grid.cols() - 2), 1, mpi_grid.col_type(), mpi_grid.right(), 1,
-               grid.data(1, 0), 1, mpi_grid.col_type(), mpi_grid.left(), 1,
+  MPI_Sendrecv(grid.data(0, grid.cols() - 2 * kHalo), 1, mpi_grid.col_type(), mpi_grid.right(), 1,
+               grid.data(0, 0), 1, mpi_grid.col_type(), mpi_grid.left(), 1,
                mpi_grid.comm(), MPI_STATUS_IGNORE);
 }
 
+// Same exchange as ExchangeBoundaryData with the halos converted to float, packed into contiguous
+// buffers. Halos next to MPI_PROC_NULL are left untouched.
+template<typename T, typename Stencil>
+void SolverMpi<T, Stencil>::ExchangeFloatBoundaryData(Grid<T>& grid, MpiGrid2D& mpi_grid) {
+  size_t rows = grid.rows() - 2 * kHalo;
+  size_t cols = grid.cols() - 2 * kHalo;
+  size_t size = kHalo * std::max(cols, rows + 2 * kHalo);
+  halo_send_.resize(size);
+  halo_recv_.resize(size);
+
+  // Sends the block at (send_row, send_col) to dest and stores the one from source at (recv_row, recv_col).
+  auto shift = [&](size_t send_row, size_t send_col, int dest, size_t recv_row, size_t recv_col, int source,
+                   size_t block_rows, size_t block_cols, int tag) {
+    for (size_t i = 0; i < block_rows; ++i) {
+      for (size_t j = 0; j < block_cols; ++j) {
+        halo_send_[i * block_cols + j] = static_cast<float>(grid(send_row + i, send_col + j));
+      }
+    }
+    int count = MpiCount(block_rows * block_cols);
+    MPI_Sendrecv(halo_send_.data(), count, MPI_FLOAT, dest, tag, halo_recv_.data(), count, MPI_FLOAT, source, tag,
+                 mpi_grid.comm(), MPI_STATUS_IGNORE);
+    if (source == MPI_PROC_NULL) {
+      return;
+    }
+    for (size_t i = 0; i < block_rows; ++i) {
+      for (size_t j = 0; j < block_cols; ++j) {
+        grid(recv_row + i, recv_col + j) = static_cast<T>(halo_recv_[i * block_cols + j]);
+      }
+    }
+  };
+
+  shift(kHalo, kHalo, mpi_grid.top(), rows + kHalo, kHalo, mpi_grid.bot(), kHalo, cols, 0);
+  shift(rows, kHalo, mpi_grid.bot(), 0, kHalo, mpi_grid.top(), kHalo, cols, 0);
+  shift(0, kHalo, mpi_grid.left(), 0, cols + kHalo, mpi_grid.right(), rows + 2 * kHalo, kHalo, 1);
+  shift(0, cols, mpi_grid.right(), 0, 0, mpi_grid.left(), rows + 2 * kHalo, kHalo, 1);
+}
+
+template<typename T, typename Stencil>
+void SolverMpi<T, Stencil>::ExchangeHalos(Grid<T>& grid, MpiGrid2D& mpi_grid) {
+  if (halos_in_float_) {
+    ExchangeFloatBoundaryData(grid, mpi_grid);
+  } else {
+    ExchangeBoundaryData(grid, mpi_grid);
+  }
+}
+
+// Sums count values, at most two, over all ranks with their compensations if the norm is compensated.
+template<typename T, typename Stencil>
+void SolverMpi<T, Stencil>::ReduceSums(const T* sums, const T* compensations, T* global_sums, int count,
+                                       MpiGrid2D& mpi_grid) {
+  T local[4];
+  T global[4];
+
+  if (!compensated_norm_) {
+    MPI_Allreduce(sums, global_sums, count, MpiType<T>(), MPI_SUM, mpi_grid.comm());
+    return;
+  }
+
+  for (int n = 0; n < count; ++n) {
+    local[2 * n] = sums[n];
+    local[2 * n + 1] = compensations[n];
+  }
+  MPI_Allreduce(local, global, count, sum_type_, sum_op_, mpi_grid.comm());
+  for (int n = 0; n < count; ++n) {
+    global_sums[n] = global[2 * n] + global[2 * n + 1];
+  }
+}
+
 } // namespace fluid_dynamics
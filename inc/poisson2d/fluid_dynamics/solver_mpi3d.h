@@ -0,0 +1,35 @@
+// File: inc/poisson2d/fluid_dynamics/solver_mpi3d.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_MPI3D_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_MPI3D_H_
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <utility>
+#include "grid3d.h"
+#include "bound3d.h"
+#include "solver3d.h"
+#include "mpi_grid3d.h"
+
+namespace fluid_dynamics {
+
+template<typename T>
+class SolverMpi3D : public Solver3D<T> {
+ public:
+  using Solver3D<T>::Solver3D;
+  using Solver3D<T>::Solve;
+  using Solver3D<T>::Gradient;
+
+  Grid3D<T> Solve(size_t nx, size_t ny, size_t nz, const Bound3D<T>& global_bound, MpiGrid3D& mpi_grid,
+                  bool verbose = false);
+  Grid3D<std::array<T, 3>> Gradient(const Grid3D<T>& field, MpiGrid3D& mpi_grid);
+
+ protected:
+  static void ExchangeHalo(Grid3D<T>& grid, MpiGrid3D& mpi_grid);
+}; // class SolverMpi3D
+
+} // namespace fluid_dynamics
+
+#include "solver_mpi3d.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_SOLVER_MPI3D_H_
@@ -0,0 +1,142 @@
+// File: inc/poisson2d/fluid_dynamics/solver_mpi3d.tpp
+namespace fluid_dynamics {
+
+// nx, ny and nz are the dimensions of the local block, the boundaries are given in global coordinates.
+template<typename T>
+Grid3D<T> SolverMpi3D<T>::Solve(size_t nx, size_t ny, size_t nz, const Bound3D<T>& global_bound,
+                                MpiGrid3D& mpi_grid, bool verbose) {
+  if (global_bound.type() == BoundaryType::kPeriodic) {
+    throw std::invalid_argument("Periodic boundaries are not supported in 3D");
+  }
+
+  std::array<size_t, 3> origin{mpi_grid.GlobalIndex(0, 0, nx), mpi_grid.GlobalIndex(1, 0, ny),
+                               mpi_grid.GlobalIndex(2, 0, nz)};
+  std::array<size_t, 3> global{mpi_grid.dims()[0] * nx, mpi_grid.dims()[1] * ny, mpi_grid.dims()[2] * nz};
+  Grid3D<T> source = this->MaterializeSource(origin, nx, ny, nz);
+  Grid3D<unsigned char> kind{nx, ny, nz};
+  Grid3D<T> fixed{nx, ny, nz};
+  this->Classify(global_bound, origin, global, kind, fixed);
+
+  Grid3D<T> prev{source};
+  prev.Resize(nx + 2, ny + 2, nz + 2, {1, 1, 1});
+  Grid3D<T> curr{prev};
+  T local_norm;
+  T norm = 0;
+  size_t iter;
+  bool converged = false;
+  bool report = verbose && mpi_grid.rank() == 0;
+  size_t max_iter = this->max_iter();
+  size_t progress_intervals = static_cast<size_t>(max_iter * 0.05);
+  size_t progress_steps = 0;
+
+  mpi_grid.CreateFaceTypes(nx, ny, nz, 1, MpiType<T>());
+  this->profiler().Reset();
+  FDSIM_PROFILE_WORKLOAD(this->profiler(), Phase::kStencil, 2 * nx * ny * nz * sizeof(T),
+                         Solver3D<T>::kFlops * nx * ny * nz);
+  MPI_Barrier(mpi_grid.comm());
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (iter = 0; iter < max_iter; ++iter) {
+    {
+      FDSIM_PROFILE_SCOPE(this->profiler(), Phase::kHaloExchange);
+      ExchangeHalo(prev, mpi_grid);
+    }
+    {
+      FDSIM_PROFILE_SCOPE(this->profiler(), Phase::kStencil);
+      local_norm = this->Sweep(prev, curr, kind, fixed, source);
+    }
+    {
+      FDSIM_PROFILE_SCOPE(this->profiler(), Phase::kAllreduce);
+      MPI_Allreduce(&local_norm, &norm, 1, MpiType<T>(), MPI_SUM, mpi_grid.comm());
+    }
+    FDSIM_PROFILE_ITERATION(this->profiler(), norm);
+    if (norm < this->epsilon()) {
+      converged = true;
+      break;
+    }
+    std::swap(prev, curr);
+
+    if (report && iter == progress_steps * progress_intervals) {
+      this->Progress(iter, max_iter);
+      ++progress_steps;
+    }
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<long double> time_taken = end - start;
+  this->iterations_ = converged ? iter + 1 : max_iter;
+  mpi_grid.FreeTypes();
+  if (!converged) {
+    std::swap(prev, curr);
+  }
+  curr.Resize(nx, ny, nz, {-1, -1, -1});
+
+  if (report) {
+    this->Report(converged, iter, norm, time_taken.count());
+  }
+
+  return curr;
+}
+
+// The outermost layer of the global domain is left at zero as in the serial solver.
+template<typename T>
+Grid3D<std::array<T, 3>> SolverMpi3D<T>::Gradient(const Grid3D<T>& field, MpiGrid3D& mpi_grid) {
+  size_t nx = field.nx();
+  size_t ny = field.ny();
+  size_t nz = field.nz();
+  std::array<size_t, 3> origin{mpi_grid.GlobalIndex(0, 0, nx), mpi_grid.GlobalIndex(1, 0, ny),
+                               mpi_grid.GlobalIndex(2, 0, nz)};
+  std::array<size_t, 3> global{mpi_grid.dims()[0] * nx, mpi_grid.dims()[1] * ny, mpi_grid.dims()[2] * nz};
+  Grid3D<std::array<T, 3>> grad{nx, ny, nz};
+  Grid3D<T> padded{field};
+  const T half = static_cast<T>(0.5);
+
+  padded.Resize(nx + 2, ny + 2, nz + 2, {1, 1, 1});
+  mpi_grid.CreateFaceTypes(nx, ny, nz, 1, MpiType<T>());
+  ExchangeHalo(padded, mpi_grid);
+  mpi_grid.FreeTypes();
+
+  #pragma omp parallel for default(none) shared(padded, grad, origin, global, nx, ny, nz, half)
+  for (size_t i = 0; i < nx; ++i) {
+    for (size_t j = 0; j < ny; ++j) {
+      for (size_t k = 0; k < nz; ++k) {
+        size_t gi = origin[0] + i;
+        size_t gj = origin[1] + j;
+        size_t gk = origin[2] + k;
+        if (gi == 0 || gj == 0 || gk == 0 || gi == global[0] - 1 || gj == global[1] - 1 || gk == global[2] - 1) {
+          continue;
+        }
+        grad(i, j, k) = {half * (padded(i + 2, j + 1, k + 1) - padded(i, j + 1, k + 1)),
+                         half * (padded(i + 1, j + 2, k + 1) - padded(i + 1, j, k + 1)),
+                         half * (padded(i + 1, j + 1, k + 2) - padded(i + 1, j + 1, k))};
+      }
+    }
+  }
+
+  return grad;
+}
+
+// Sends the outermost interior layer to each neighbour and receives its layer into the halo,
+// one dimension after the other. Faces at the global domain boundary exchange with MPI_PROC_NULL.
+template<typename T>
+void SolverMpi3D<T>::ExchangeHalo(Grid3D<T>& grid, MpiGrid3D& mpi_grid) {
+  size_t nx = grid.nx() - 2;
+  size_t ny = grid.ny() - 2;
+  size_t nz = grid.nz() - 2;
+  std::array<std::array<T*, 4>, 3> faces{{
+      {grid.data(1, 1, 1), grid.data(nx + 1, 1, 1), grid.data(nx, 1, 1), grid.data(0, 1, 1)},
+      {grid.data(0, 1, 1), grid.data(0, ny + 1, 1), grid.data(0, ny, 1), grid.data(0, 0, 1)},
+      {grid.data(0, 0, 1), grid.data(0, 0, nz + 1), grid.data(0, 0, nz), grid.data(0, 0, 0)}}};
+
+  for (size_t d = 0; d < 3; ++d) {
+    int lower = mpi_grid.neighbor(d, 0);
+    int upper = mpi_grid.neighbor(d, 1);
+    MPI_Datatype face = mpi_grid.face_type(d);
+    MPI_Sendrecv(faces[d][0], 1, face, lower, 0, faces[d][1], 1, face, upper, 0,
+                 mpi_grid.comm(), MPI_STATUS_IGNORE);
+    MPI_Sendrecv(faces[d][2], 1, face, upper, 1, faces[d][3], 1, face, lower, 1,
+                 mpi_grid.comm(), MPI_STATUS_IGNORE);
+  }
+}
+
+} // namespace fluid_dynamics
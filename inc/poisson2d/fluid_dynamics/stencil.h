@@ -0,0 +1,74 @@
+// File: inc/poisson2d/fluid_dynamics/stencil.h
+#ifndef FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_STENCIL_H_
+#define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_STENCIL_H_
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include "grid.h"
+
+namespace fluid_dynamics {
+
+struct StencilTap {
+  int di;
+  int dj;
+  double weight;
+}; // struct StencilTap
+
+struct GradientTap {
+  int offset;
+  double weight;
+}; // struct GradientTap
+
+// Stencil policies discretize -laplace(phi) = source with unit grid spacing as
+// center * phi(i, j) = sum(weight * phi(i + di, j + dj)) + source_weight * source(i, j).
+// Jacobi sweeps are damped by the relaxation factor where the plain iteration diverges.
+// Relax takes the distance between neighbouring columns as step for interleaved layouts.
+
+struct FivePoint {
+  static constexpr size_t kRadius = 1;
+  static constexpr double kCenter = 4.0;
+  static constexpr double kSourceWeight = 1.0;
+  static constexpr double kRelaxation = 1.0;
+  static constexpr size_t kFlops = 6;
+  static constexpr std::array<StencilTap, 4> kTaps{{
+      {-1, 0, 1.0}, {1, 0, 1.0}, {0, -1, 1.0}, {0, 1, 1.0}
+  }};
+  static constexpr std::array<GradientTap, 1> kGradient{{{1, 0.5}}};
+}; // struct FivePoint
+
+struct NinePoint {
+  static constexpr size_t kRadius = 1;
+  static constexpr double kCenter = 20.0;
+  static constexpr double kSourceWeight = 6.0;
+  static constexpr double kRelaxation = 1.0;
+  static constexpr size_t kFlops = 19;
+  static constexpr std::array<StencilTap, 8> kTaps{{
+      {-1, 0, 4.0}, {1, 0, 4.0}, {0, -1, 4.0}, {0, 1, 4.0},
+      {-1, -1, 1.0}, {-1, 1, 1.0}, {1, -1, 1.0}, {1, 1, 1.0}
+  }};
+  static constexpr std::array<GradientTap, 1> kGradient{{{1, 0.5}}};
+}; // struct NinePoint
+
+struct FourthOrder {
+  static constexpr size_t kRadius = 2;
+  static constexpr double kCenter = 60.0;
+  static constexpr double kSourceWeight = 12.0;
+  static constexpr double kRelaxation = 0.8;
+  static constexpr size_t kFlops = 21;
+  static constexpr std::array<StencilTap, 8> kTaps{{
+      {-1, 0, 16.0}, {1, 0, 16.0}, {0, -1, 16.0}, {0, 1, 16.0},
+      {-2, 0, -1.0}, {2, 0, -1.0}, {0, -2, -1.0}, {0, 2, -1.0}
+  }};
+  static constexpr std::array<GradientTap, 2> kGradient{{{1, 2.0 / 3.0}, {2, -1.0 / 12.0}}};
+}; // struct FourthOrder
+
+template<typename Stencil, typename T> T Relax(const T* center, std::ptrdiff_t stride, T source);
+template<typename Stencil, typename T> T Relax(const T* center, std::ptrdiff_t stride, std::ptrdiff_t step, T source);
+template<typename Stencil, typename T> std::pair<T, T> GradientAt(const T* center, std::ptrdiff_t stride);
+
+} // namespace fluid_dynamics
+
+#include "stencil.tpp"
+
+#endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_FLUID_DYNAMICS_STENCIL_H_
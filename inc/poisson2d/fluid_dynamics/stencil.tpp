@@ -0,0 +1,50 @@
+// File: inc/poisson2d/fluid_dynamics/stencil.tpp
+namespace fluid_dynamics {
+
+namespace stencil_detail {
+
+template<typename Stencil, typename T, size_t... K>
+inline T NeighborSum(const T* center, std::ptrdiff_t stride, std::ptrdiff_t step, std::index_sequence<K...>) {
+  return (... + (static_cast<T>(Stencil::kTaps[K].weight)
+                 * center[Stencil::kTaps[K].di * stride + Stencil::kTaps[K].dj * step]));
+}
+
+template<typename Stencil, typename T, size_t... K>
+inline T Difference(const T* center, std::ptrdiff_t step, std::index_sequence<K...>) {
+  return (... + (static_cast<T>(Stencil::kGradient[K].weight)
+                 * (center[Stencil::kGradient[K].offset * step] - center[-Stencil::kGradient[K].offset * step])));
+}
+
+} // namespace stencil_detail
+
+template<typename Stencil, typename T>
+inline T Relax(const T* center, std::ptrdiff_t stride, T source) {
+  return Relax<Stencil>(center, stride, 1, source);
+}
+
+template<typename Stencil, typename T>
+inline T Relax(const T* center, std::ptrdiff_t stride, std::ptrdiff_t step, T source) {
+  T sum = stencil_detail::NeighborSum<Stencil>(center, stride, step,
+                                               std::make_index_sequence<Stencil::kTaps.size()>{});
+
+  if constexpr (Stencil::kSourceWeight == 1.0) {
+    sum += source;
+  } else {
+    sum += static_cast<T>(Stencil::kSourceWeight) * source;
+  }
+
+  if constexpr (Stencil::kRelaxation == 1.0) {
+    return static_cast<T>(1.0 / Stencil::kCenter) * sum;
+  } else {
+    return *center + static_cast<T>(Stencil::kRelaxation)
+        * (static_cast<T>(1.0 / Stencil::kCenter) * sum - *center);
+  }
+}
+
+template<typename Stencil, typename T>
+inline std::pair<T, T> GradientAt(const T* center, std::ptrdiff_t stride) {
+  return {stencil_detail::Difference<Stencil>(center, 1, std::make_index_sequence<Stencil::kGradient.size()>{}),
+          stencil_detail::Difference<Stencil>(center, stride, std::make_index_sequence<Stencil::kGradient.size()>{})};
+}
+
+} // namespace fluid_dynamics
@@ -3,8 +3,18 @@
 #define FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_POISSON2D_H_
 
 #include "fluid_dynamics/grid.h"
+#include "fluid_dynamics/ghosted_grid.h"
 #include "fluid_dynamics/grid_io.h"
+#include "fluid_dynamics/mapped_grid.h"
 #include "fluid_dynamics/bound.h"
+#include "fluid_dynamics/geometry.h"
 #include "fluid_dynamics/solver.h"
+#include "fluid_dynamics/solver_batch.h"
+#include "fluid_dynamics/solver_amr.h"
+#include "fluid_dynamics/solver_mixed.h"
+#include "fluid_dynamics/flow_simulation.h"
+#include "fluid_dynamics/grid3d.h"
+#include "fluid_dynamics/bound3d.h"
+#include "fluid_dynamics/solver3d.h"
 
 #endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_POISSON2D_H_
@@ -4,7 +4,14 @@
 
 #include "fluid_dynamics/mpi_util.h"
 #include "fluid_dynamics/grid.h"
+#include "fluid_dynamics/distributed_grid.h"
 #include "fluid_dynamics/bound.h"
+#include "fluid_dynamics/geometry.h"
 #include "fluid_dynamics/solver_mpi.h"
+#include "fluid_dynamics/solver_mixed_mpi.h"
+#include "fluid_dynamics/mpi_ensemble.h"
+#include "fluid_dynamics/flow_simulation_mpi.h"
+#include "fluid_dynamics/mpi_grid3d.h"
+#include "fluid_dynamics/solver_mpi3d.h"
 
 #endif // FLUID_DYNAMICS_SIMULATION_INC_POISSON2D_POISSON2D_MPI_H_
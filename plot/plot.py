@@ -3,10 +3,23 @@ import numpy as np
 import matplotlib
 import matplotlib.pyplot as plt
 
+PYRAMID_MAGIC = b'FDSPYR01'
+
+
+# Copy-on-write map: nothing is read up front, and create_plots masking cells only copies the pages it
+# touches, never the file.
 def read_data(file = 'vec.bin'):
-    with open(file, 'rb') as f:
-        data = f.read()
-    return np.frombuffer(data, dtype=np.float64).copy()
+    return np.memmap(file, dtype=np.float64, mode='c')
+
+
+def read_pyramid_level(file, level = 0, dtype = np.float64, components = 2):
+    header = np.memmap(file, dtype=np.uint64, mode='r', offset=len(PYRAMID_MAGIC), shape=(2,))
+    levels = int(header[0])
+    if level >= levels:
+        raise ValueError(f'{file} has only {levels} levels')
+    index = np.memmap(file, dtype=np.uint64, mode='r', offset=len(PYRAMID_MAGIC) + 16, shape=(levels, 3))
+    rows, cols, offset = (int(v) for v in index[level])
+    return np.memmap(file, dtype=dtype, mode='r', offset=offset, shape=(rows, cols, components))
 
 
 def transform_data(data):
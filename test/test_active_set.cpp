@@ -0,0 +1,85 @@
+// File: test/test_active_set.cpp
+#include <cmath>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+#include "poisson2d/poisson2d.h"
+
+using ActiveSetTypes = ::testing::Types<float, double>;
+
+template<typename T>
+class ActiveSetTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kSize = 40;
+
+  // Grounded frame with a point source close to one corner, most of the domain never changes.
+  static fluid_dynamics::Bound<T> GroundedBound() {
+    fluid_dynamics::Bound<T> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+    bound.AddBoundary({[](size_t i, size_t j) { return i == 0 || j == 0 || i == kSize - 1 || j == kSize - 1; },
+                       [](size_t, size_t) { return T{0}; }});
+
+    return bound;
+  }
+
+  static T CornerSource(size_t i, size_t j) {
+    return (i >= 4 && i < 8 && j >= 4 && j < 8) ? T{1} : T{0};
+  }
+};
+
+TYPED_TEST_SUITE(ActiveSetTest, ActiveSetTypes);
+
+TYPED_TEST(ActiveSetTest, TilesCoverBlock) {
+  fluid_dynamics::ActiveSet<TypeParam> active(10, 7, 4, TypeParam{1});
+
+  EXPECT_EQ(active.tile_rows(), 3u);
+  EXPECT_EQ(active.tile_cols(), 2u);
+  EXPECT_EQ(active.active().size(), 6u);
+  EXPECT_EQ(active.RowEnd(5), 10u);
+  EXPECT_EQ(active.ColEnd(5), 7u);
+  EXPECT_EQ(active.TileOf(9, 6), 5u);
+  EXPECT_THROW(fluid_dynamics::ActiveSet<TypeParam>(4, 4, 0, TypeParam{1}), std::invalid_argument);
+}
+
+TYPED_TEST(ActiveSetTest, FreezesAndWakesNeighbours) {
+  fluid_dynamics::ActiveSet<TypeParam> active(12, 12, 4, TypeParam{1});
+
+  for (size_t t = 0; t < active.size(); ++t) {
+    active.Record(t, TypeParam{0});
+  }
+  active.Record(0, TypeParam{2});
+  active.Advance();
+
+  // Tile 0 keeps changing and wakes its neighbours, which froze in the same sweep.
+  EXPECT_FALSE(active.frozen(0));
+  EXPECT_FALSE(active.frozen(1));
+  EXPECT_FALSE(active.frozen(3));
+  EXPECT_FALSE(active.frozen(4));
+  EXPECT_TRUE(active.frozen(2));
+  EXPECT_TRUE(active.frozen(8));
+  EXPECT_EQ(active.frozen_count(), 5u);
+  EXPECT_EQ(active.updates(), 144u);
+  EXPECT_TYPE_EQ(active.norm(), TypeParam{2});
+
+  active.ActivateAll();
+  EXPECT_EQ(active.frozen_count(), 0u);
+}
+
+TYPED_TEST(ActiveSetTest, SolverSkipsSettledTiles) {
+  fluid_dynamics::Solver<TypeParam> full(static_cast<TypeParam>(1e-5), 100000);
+  fluid_dynamics::Solver<TypeParam> tiled(static_cast<TypeParam>(1e-5), 100000);
+
+  full.source(this->CornerSource);
+  tiled.source(this->CornerSource);
+  tiled.active_set(8);
+  fluid_dynamics::Grid<TypeParam> expected = full.Solve(this->kSize, this->kSize, this->GroundedBound());
+  fluid_dynamics::Grid<TypeParam> result = tiled.Solve(this->kSize, this->kSize, this->GroundedBound());
+
+  EXPECT_LT(tiled.iterations(), 100000u);
+  EXPECT_GT(tiled.active_set().skipped(), 0u);
+  EXPECT_EQ(tiled.active_set().frozen_count(), 0u);
+  for (size_t i = 0; i < this->kSize; ++i) {
+    for (size_t j = 0; j < this->kSize; ++j) {
+      EXPECT_NEAR(result(i, j), expected(i, j), 1e-3);
+    }
+  }
+}
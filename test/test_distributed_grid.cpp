@@ -0,0 +1,69 @@
+// File: test/test_distributed_grid.cpp
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+#include "test_mpi_utils.h"
+
+namespace {
+
+fluid_dynamics::DistributedGrid<double> FilledGrid() {
+  fluid_dynamics::Grid<double> global = GlobalGrid<double>(kRows, kCols);
+  fluid_dynamics::DistributedGrid<double> grid(*mpi_grid, kRows, kCols);
+
+  for (size_t i = 0; i < grid.local().rows(); ++i) {
+    for (size_t j = 0; j < grid.local().cols(); ++j) {
+      grid.local()(i, j) = global(grid.origin_row() + i, grid.origin_col() + j);
+    }
+  }
+  return grid;
+}
+
+} // namespace
+
+// Every cell has exactly one owner, the same on every rank, and it is the rank holding the cell.
+TEST(DistributedGrid, OwnerAgreesWithOwns) {
+  fluid_dynamics::DistributedGrid<double> grid = FilledGrid();
+  std::vector<int> owners(kRows * kCols), lowest(kRows * kCols), highest(kRows * kCols);
+  size_t owned = 0;
+
+  for (size_t i = 0; i < kRows; ++i) {
+    for (size_t j = 0; j < kCols; ++j) {
+      owners[i * kCols + j] = grid.Owner(i, j);
+      EXPECT_EQ(owners[i * kCols + j] == mpi_grid->rank(), grid.Owns(i, j)) << i << " " << j;
+      owned += grid.Owns(i, j) ? 1 : 0;
+    }
+  }
+  MPI_Allreduce(owners.data(), lowest.data(), static_cast<int>(owners.size()), MPI_INT, MPI_MIN, mpi_grid->comm());
+  MPI_Allreduce(owners.data(), highest.data(), static_cast<int>(owners.size()), MPI_INT, MPI_MAX, mpi_grid->comm());
+
+  EXPECT_EQ(lowest, highest);
+  EXPECT_EQ(owned, grid.local().rows() * grid.local().cols());
+}
+
+// Each rank asks for the corners of every block, so most points live on other ranks. The last rank
+// asks for nothing and still has to join the collective call.
+TEST(DistributedGrid, FetchReadsRemotePoints) {
+  fluid_dynamics::DistributedGrid<double> grid = FilledGrid();
+  fluid_dynamics::Grid<double> global = GlobalGrid<double>(kRows, kCols);
+  size_t rows = grid.local().rows();
+  size_t cols = grid.local().cols();
+  std::vector<std::pair<size_t, size_t>> points;
+  std::vector<double> values;
+
+  if (mpi_grid->rank() != mpi_grid->size() - 1 || mpi_grid->size() == 1) {
+    for (size_t i = 0; i < kRows; i += rows) {
+      for (size_t j = 0; j < kCols; j += cols) {
+        points.emplace_back(i, j);
+        points.emplace_back(i + rows - 1, j + cols - 1);
+      }
+    }
+  }
+  values = grid.Fetch(points);
+
+  ASSERT_EQ(values.size(), points.size());
+  for (size_t p = 0; p < points.size(); ++p) {
+    EXPECT_EQ(values[p], global(points[p].first, points[p].second)) << points[p].first << " " << points[p].second;
+  }
+  EXPECT_EQ(grid.Fetch(kRows - 1, 0), global(kRows - 1, 0));
+  EXPECT_THROW(static_cast<void>(grid.Fetch(kRows, 0)), std::out_of_range);
+}
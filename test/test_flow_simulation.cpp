@@ -0,0 +1,91 @@
+// File: test/test_flow_simulation.cpp
+#include <cmath>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "poisson2d/poisson2d.h"
+
+using FlowTypes = ::testing::Types<float, double>;
+
+template<typename T>
+class FlowSimulationTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kSize = 24;
+
+  static fluid_dynamics::FlowOptions Options(double lid_velocity) {
+    fluid_dynamics::FlowOptions options;
+
+    options.time_step = 0.25;
+    options.viscosity = 0.5;
+    options.lid_velocity = lid_velocity;
+    return options;
+  }
+};
+
+TYPED_TEST_SUITE(FlowSimulationTest, FlowTypes);
+
+TYPED_TEST(FlowSimulationTest, FluidAtRestStaysAtRest) {
+  fluid_dynamics::FlowSimulation<TypeParam> flow(static_cast<TypeParam>(1e-6), 1000);
+
+  flow.options(this->Options(0.0));
+  flow.Initialize(this->kSize, this->kSize, fluid_dynamics::Bound<TypeParam>{});
+  flow.Run(10);
+
+  fluid_dynamics::Grid<TypeParam> psi = flow.streamfunction();
+  EXPECT_EQ(flow.steps(), 10u);
+  EXPECT_DOUBLE_EQ(flow.time(), 2.5);
+  for (size_t i = 0; i < this->kSize; ++i) {
+    for (size_t j = 0; j < this->kSize; ++j) {
+      EXPECT_EQ(psi(i, j), TypeParam{0});
+    }
+  }
+}
+
+TYPED_TEST(FlowSimulationTest, LidDrivesRecirculation) {
+  fluid_dynamics::FlowSimulation<TypeParam> flow(static_cast<TypeParam>(1e-4), 5000);
+  size_t mid = this->kSize / 2;
+
+  flow.options(this->Options(1.0));
+  flow.Initialize(this->kSize, this->kSize, fluid_dynamics::Bound<TypeParam>{});
+  flow.Run(100);
+
+  fluid_dynamics::Grid<std::pair<TypeParam, TypeParam>> velocity = flow.velocity();
+  TypeParam return_flow = 0;
+  for (size_t i = mid; i < this->kSize - 1; ++i) {
+    return_flow = std::min(return_flow, velocity(i, mid).first);
+  }
+  EXPECT_EQ(velocity(0, mid).first, TypeParam{1});
+  EXPECT_GT(velocity(1, mid).first, TypeParam{0});
+  EXPECT_LT(return_flow, TypeParam{0});
+}
+
+// The warm started streamfunction matches a cold Solve of the same vorticity and needs fewer sweeps.
+TYPED_TEST(FlowSimulationTest, PoissonSolveIsWarmStarted) {
+  auto epsilon = static_cast<TypeParam>(1e-5);
+  fluid_dynamics::FlowSimulation<TypeParam> flow(epsilon, 20000);
+  fluid_dynamics::Solver<TypeParam> solver(epsilon, 20000);
+  fluid_dynamics::Bound<TypeParam> bound;
+  size_t n = this->kSize;
+
+  flow.options(this->Options(1.0));
+  flow.Initialize(n, n, bound);
+  flow.Run(50);
+  solver.source(flow.vorticity());
+  fluid_dynamics::Grid<TypeParam> expected = solver.Solve(n, n, bound, fluid_dynamics::Grid<TypeParam>{n, n});
+  fluid_dynamics::Grid<TypeParam> psi = flow.streamfunction();
+
+  EXPECT_LT(flow.poisson_iterations(), solver.iterations());
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      EXPECT_NEAR(psi(i, j), expected(i, j), 1e-2);
+    }
+  }
+}
+
+TYPED_TEST(FlowSimulationTest, RejectsUnstableOptions) {
+  fluid_dynamics::FlowSimulation<TypeParam> flow;
+  fluid_dynamics::FlowOptions options = this->Options(1.0);
+
+  options.time_step = 1.0;
+  EXPECT_THROW(flow.options(options), std::invalid_argument);
+  EXPECT_THROW(flow.Step(), std::runtime_error);
+}
@@ -0,0 +1,188 @@
+// File: test/test_geometry.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <vector>
+#include "poisson2d/poisson2d.h"
+
+using GeometryTypes = ::testing::Types<float, double>;
+
+template<typename T>
+class GeometryTest : public ::testing::Test {};
+
+TYPED_TEST_SUITE(GeometryTest, GeometryTypes);
+
+namespace {
+
+template<typename T>
+std::set<fluid_dynamics::Cell> Cells(const fluid_dynamics::Boundary<T>& boundary,
+                                     const fluid_dynamics::CellBox& clip = fluid_dynamics::CellBox::All()) {
+  std::set<fluid_dynamics::Cell> cells;
+
+  boundary.cells(clip, [&cells](size_t i, size_t j) { cells.insert({i, j}); });
+  return cells;
+}
+
+// Cells where condition holds on a rows x cols grid.
+template<typename T>
+std::set<fluid_dynamics::Cell> Covered(const fluid_dynamics::Boundary<T>& boundary, size_t rows, size_t cols) {
+  std::set<fluid_dynamics::Cell> cells;
+
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      if (boundary.condition(i, j)) {
+        cells.insert({i, j});
+      }
+    }
+  }
+  return cells;
+}
+
+} // namespace
+
+TYPED_TEST(GeometryTest, SegmentIsABox) {
+  auto segment = fluid_dynamics::SegmentBoundary<TypeParam>({4, 7}, {4, 2},
+                                                            fluid_dynamics::ConstantValue<TypeParam>(3));
+
+  EXPECT_EQ(segment.box.row_begin, 4u);
+  EXPECT_EQ(segment.box.row_end, 5u);
+  EXPECT_EQ(segment.box.col_begin, 2u);
+  EXPECT_EQ(segment.box.col_end, 8u);
+  EXPECT_EQ(Cells(segment).size(), 6u);
+  EXPECT_EQ(Cells(segment), Covered(segment, 10, 10));
+  EXPECT_EQ(Cells(segment, {0, 10, 5, 10}).size(), 3u);
+  EXPECT_EQ(segment.value(4, 5), TypeParam{3});
+}
+
+TYPED_TEST(GeometryTest, DiagonalSegmentIsEdgeConnected) {
+  auto segment = fluid_dynamics::SegmentBoundary<TypeParam>({9, 1}, {2, 12},
+                                                            fluid_dynamics::ConstantValue<TypeParam>(0));
+  std::set<fluid_dynamics::Cell> cells = Cells(segment);
+
+  // A monotone edge connected path from one end to the other visits rows + cols - 1 cells.
+  EXPECT_EQ(cells.size(), 8u + 12u - 1u);
+  EXPECT_TRUE(cells.count({9, 1}));
+  EXPECT_TRUE(cells.count({2, 12}));
+  for (const fluid_dynamics::Cell& cell : cells) {
+    EXPECT_TRUE(cells.count({cell.first + 1, cell.second}) || cells.count({cell.first - 1, cell.second})
+                || cells.count({cell.first, cell.second + 1}) || cells.count({cell.first, cell.second - 1}));
+  }
+  EXPECT_EQ(cells, Covered(segment, 16, 16));
+  EXPECT_EQ(segment.box.row_begin, 2u);
+  EXPECT_EQ(segment.box.row_end, 10u);
+  EXPECT_EQ(segment.box.col_begin, 1u);
+  EXPECT_EQ(segment.box.col_end, 13u);
+}
+
+TYPED_TEST(GeometryTest, RectangleOutline) {
+  auto outline = fluid_dynamics::RectangleBoundary<TypeParam>({6, 8}, {2, 3},
+                                                              fluid_dynamics::ConstantValue<TypeParam>(1), false);
+  auto filled = fluid_dynamics::RectangleBoundary<TypeParam>({6, 8}, {2, 3},
+                                                             fluid_dynamics::ConstantValue<TypeParam>(1));
+
+  EXPECT_EQ(Cells(outline).size(), 18u);
+  EXPECT_EQ(Cells(outline), Covered(outline, 10, 10));
+  EXPECT_FALSE(outline.condition(4, 5));
+  EXPECT_EQ(Cells(filled).size(), 30u);
+  EXPECT_TRUE(filled.condition(4, 5));
+  EXPECT_EQ(Cells(outline, {0, 4, 0, 5}), (std::set<fluid_dynamics::Cell>{{2, 3}, {2, 4}, {3, 3}}));
+}
+
+TYPED_TEST(GeometryTest, LinearValue) {
+  auto value = fluid_dynamics::LinearValue<TypeParam>(7, 2, -1, {3, 4});
+
+  EXPECT_EQ(value(3, 4), TypeParam{7});
+  EXPECT_EQ(value(5, 4), TypeParam{11});
+  EXPECT_EQ(value(3, 0), TypeParam{11});
+  EXPECT_EQ(value(0, 6), TypeParam{-1});
+}
+
+TYPED_TEST(GeometryTest, ReadGeometry) {
+  std::istringstream in{"# Comment\n"
+                        "type dirichlet\n"
+                        "\n"
+                        "segment L/2 L/4 L/2 3L/4 constant 2.5  # trailing comment\n"
+                        "rectangle 1 1 3 3 outline linear 1 0 4/L\n"
+                        "polyline 0 0 L-1 L-1 L-1 0 constant -1\n"};
+  fluid_dynamics::Bound<TypeParam> bound = fluid_dynamics::ReadGeometry<TypeParam>(in, 16, 8);
+
+  ASSERT_EQ(bound.boundaries().size(), 3u);
+  EXPECT_EQ(bound.type(), fluid_dynamics::BoundaryType::kDirichlet);
+
+  const auto& segment = bound.boundaries()[0];
+  EXPECT_EQ(segment.box.row_begin, 8u);
+  EXPECT_EQ(segment.box.col_begin, 2u);
+  EXPECT_EQ(segment.box.col_end, 7u);
+  EXPECT_EQ(segment.value(8, 3), TypeParam{2.5});
+
+  const auto& rectangle = bound.boundaries()[1];
+  EXPECT_TRUE(rectangle.condition(3, 2));
+  EXPECT_FALSE(rectangle.condition(2, 2));
+  EXPECT_EQ(rectangle.value(1, 3), TypeParam{2});
+
+  const auto& polyline = bound.boundaries()[2];
+  EXPECT_EQ(polyline.box.row_end, 16u);
+  EXPECT_EQ(polyline.box.col_end, 8u);
+  EXPECT_TRUE(polyline.condition(15, 3));
+  EXPECT_EQ(polyline.value(15, 3), TypeParam{-1});
+}
+
+TYPED_TEST(GeometryTest, ReadGeometryRejectsBadLines) {
+  std::vector<std::string> lines{"circle 1 1 2 constant 0",
+                                 "segment 1 1 1 constant 0",
+                                 "segment 1 1 1 4",
+                                 "segment 1 1 1 4 quadratic 0",
+                                 "segment 1 x 1 4 constant 0",
+                                 "segment 1 L-20 1 4 constant 0",
+                                 "segment 1 L/0 1 4 constant 0",
+                                 "segment 1 1 1 4 constant zero",
+                                 "segment 1 1 1 4 constant 0 5",
+                                 "type neumann",
+                                 "polyline constant 0"};
+
+  for (const std::string& line : lines) {
+    std::istringstream in{"type dirichlet\n" + line + "\n"};
+    EXPECT_THROW(fluid_dynamics::ReadGeometry<TypeParam>(in, 16, 16), std::runtime_error) << line;
+  }
+  EXPECT_THROW(fluid_dynamics::ReadGeometry<TypeParam>("missing.geo", 16, 16), std::runtime_error);
+}
+
+// Primitives and equivalent predicates give the same mask, overlaps included, on a block away from the
+// origin.
+TYPED_TEST(GeometryTest, BoundMaskMatchesPredicates) {
+  size_t rows = 20, cols = 24;
+  fluid_dynamics::Bound<TypeParam> primitives, predicates;
+
+  primitives.AddBoundary(fluid_dynamics::SegmentBoundary<TypeParam>(
+      {0, 0}, {0, cols - 1}, fluid_dynamics::LinearValue<TypeParam>(1, 0, 0.5)));
+  primitives.AddBoundary(fluid_dynamics::RectangleBoundary<TypeParam>(
+      {0, 5}, {8, 9}, fluid_dynamics::ConstantValue<TypeParam>(-2)));
+  primitives.AddBoundary(fluid_dynamics::RectangleBoundary<TypeParam>(
+      {7, 7}, {15, 20}, fluid_dynamics::ConstantValue<TypeParam>(3), false));
+  predicates.AddBoundary({[](size_t i, size_t) { return i == 0; },
+                          [](size_t, size_t j) {
+                            return TypeParam{1} + TypeParam{0.5} * static_cast<TypeParam>(j);
+                          }});
+  predicates.AddBoundary({[](size_t i, size_t j) { return i <= 8 && j >= 5 && j <= 9; },
+                          [](size_t, size_t) { return TypeParam{-2}; }});
+  predicates.AddBoundary({[](size_t i, size_t j) {
+                            return i >= 7 && i <= 15 && j >= 7 && j <= 20
+                                   && (i == 7 || i == 15 || j == 7 || j == 20);
+                          },
+                          [](size_t, size_t) { return TypeParam{3}; }});
+
+  for (size_t origin_row : {0u, 6u}) {
+    fluid_dynamics::BoundMask<TypeParam> expected(predicates, 10, 12, 2, 1, origin_row, 4, rows, cols, true);
+    fluid_dynamics::BoundMask<TypeParam> mask(primitives, 10, 12, 2, 1, origin_row, 4, rows, cols, true);
+
+    for (size_t i = 0; i < 14; ++i) {
+      for (size_t j = 0; j < 16; ++j) {
+        ASSERT_EQ(mask.kind(i, j), expected.kind(i, j)) << origin_row << " " << i << " " << j;
+        if (expected.kind(i, j) == fluid_dynamics::CellKind::kBoundary) {
+          EXPECT_EQ(mask.value(i, j), expected.value(i, j));
+        }
+      }
+    }
+  }
+}
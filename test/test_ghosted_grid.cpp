@@ -0,0 +1,63 @@
+// File: test/test_ghosted_grid.cpp
+#include <gtest/gtest.h>
+#include "poisson2d/poisson2d.h"
+
+using GhostedGridTypes = ::testing::Types<int, float, double>;
+
+template<typename T>
+class GhostedGridTest : public ::testing::Test {};
+
+TYPED_TEST_SUITE(GhostedGridTest, GhostedGridTypes);
+
+TYPED_TEST(GhostedGridTest, Dimensions) {
+  fluid_dynamics::GhostedGrid<TypeParam> grid(3, 4, 2);
+
+  EXPECT_EQ(grid.rows(), 3u);
+  EXPECT_EQ(grid.cols(), 4u);
+  EXPECT_EQ(grid.ghost(), 2u);
+  EXPECT_EQ(grid.stride(), 8u);
+  EXPECT_EQ(grid.padded().rows(), 7u);
+  EXPECT_EQ(grid.padded().cols(), 8u);
+}
+
+TYPED_TEST(GhostedGridTest, InteriorIndicesSkipTheGhosts) {
+  fluid_dynamics::Grid<TypeParam> interior(2, 3);
+  interior.Fill([](size_t i, size_t j) { return static_cast<TypeParam>(3 * i + j + 1); });
+  fluid_dynamics::GhostedGrid<TypeParam> grid(interior, 1);
+
+  EXPECT_EQ(grid(0, 0), static_cast<TypeParam>(1));
+  EXPECT_EQ(grid(1, 2), static_cast<TypeParam>(6));
+  EXPECT_EQ(grid.padded()(1, 1), static_cast<TypeParam>(1));
+  EXPECT_EQ(grid.padded()(0, 0), static_cast<TypeParam>(0));
+  EXPECT_EQ(*(grid.data(0, 0) - grid.stride() - 1), static_cast<TypeParam>(0));
+  EXPECT_EQ(grid.data(1, 0), grid.data(0, 0) + grid.stride());
+}
+
+TYPED_TEST(GhostedGridTest, AssignKeepsGhostsAndStorage) {
+  fluid_dynamics::GhostedGrid<TypeParam> grid(2, 2, 1);
+  fluid_dynamics::Grid<TypeParam> interior(2, 2);
+  interior.Fill(static_cast<TypeParam>(5));
+  const TypeParam* storage = grid.padded().data();
+
+  grid.FillGhosts(static_cast<TypeParam>(7));
+  grid.Assign(interior);
+
+  EXPECT_EQ(grid.padded().data(), storage);
+  EXPECT_EQ(grid(1, 1), static_cast<TypeParam>(5));
+  EXPECT_EQ(grid.padded()(0, 2), static_cast<TypeParam>(7));
+  EXPECT_EQ(grid.padded()(3, 3), static_cast<TypeParam>(7));
+  EXPECT_THROW(grid.Assign(fluid_dynamics::Grid<TypeParam>(3, 2)), std::invalid_argument);
+}
+
+TYPED_TEST(GhostedGridTest, InteriorCopiesWithoutGhosts) {
+  fluid_dynamics::GhostedGrid<TypeParam> grid(2, 3, 2);
+  grid.FillGhosts(static_cast<TypeParam>(9));
+  grid(1, 2) = static_cast<TypeParam>(4);
+
+  fluid_dynamics::Grid<TypeParam> interior = grid.Interior();
+
+  ASSERT_EQ(interior.rows(), 2u);
+  ASSERT_EQ(interior.cols(), 3u);
+  EXPECT_EQ(interior(0, 0), static_cast<TypeParam>(0));
+  EXPECT_EQ(interior(1, 2), static_cast<TypeParam>(4));
+}
@@ -0,0 +1,51 @@
+// File: test/test_grid3d.cpp
+#include <vector>
+#include <gtest/gtest.h>
+#include "poisson2d/poisson2d.h"
+
+using Grid3DTypes = ::testing::Types<int, float, double>;
+
+template<typename T>
+class Grid3DTest : public ::testing::Test {};
+
+TYPED_TEST_SUITE(Grid3DTest, Grid3DTypes);
+
+TYPED_TEST(Grid3DTest, Dimensions) {
+  fluid_dynamics::Grid3D<TypeParam> empty;
+  fluid_dynamics::Grid3D<TypeParam> cube(4);
+  fluid_dynamics::Grid3D<TypeParam> box(2, 3, 5);
+
+  EXPECT_EQ(empty.size(), 0u);
+  EXPECT_EQ(cube.size(), 64u);
+  EXPECT_EQ(box.nx(), 2u);
+  EXPECT_EQ(box.ny(), 3u);
+  EXPECT_EQ(box.nz(), 5u);
+  EXPECT_EQ(box.size(), 30u);
+}
+
+TYPED_TEST(Grid3DTest, LastIndexIsContiguous) {
+  std::vector<TypeParam> data(24);
+  for (size_t n = 0; n < data.size(); ++n) {
+    data[n] = static_cast<TypeParam>(n);
+  }
+  fluid_dynamics::Grid3D<TypeParam> grid(2, 3, 4, data);
+
+  EXPECT_EQ(grid(1, 2, 3), static_cast<TypeParam>(23));
+  EXPECT_EQ(grid(1, 0, 0), static_cast<TypeParam>(12));
+  EXPECT_EQ(grid.data(0, 1, 2), grid.data() + 6);
+}
+
+TYPED_TEST(Grid3DTest, ResizeWithOffset) {
+  fluid_dynamics::Grid3D<TypeParam> grid(2, 2, 2);
+  grid.Fill([](size_t i, size_t j, size_t k) { return static_cast<TypeParam>(4 * i + 2 * j + k + 1); });
+
+  grid.Resize(4, 4, 4, {1, 1, 1});
+  EXPECT_EQ(grid(0, 0, 0), static_cast<TypeParam>(0));
+  EXPECT_EQ(grid(1, 1, 1), static_cast<TypeParam>(1));
+  EXPECT_EQ(grid(2, 2, 2), static_cast<TypeParam>(8));
+  EXPECT_EQ(grid(3, 2, 2), static_cast<TypeParam>(0));
+
+  grid.Resize(2, 2, 2, {-1, -1, -1});
+  EXPECT_EQ(grid(0, 0, 0), static_cast<TypeParam>(1));
+  EXPECT_EQ(grid(1, 1, 1), static_cast<TypeParam>(8));
+}
@@ -0,0 +1,83 @@
+// File: test/test_grid_pool.cpp
+#include <memory>
+#include <gtest/gtest.h>
+#include "poisson2d/poisson2d.h"
+
+TEST(GridPool, SizeClasses) {
+  using fluid_dynamics::GridPool;
+
+  EXPECT_EQ(GridPool::SizeClass(0), 64u);
+  EXPECT_EQ(GridPool::SizeClass(1), 64u);
+  EXPECT_EQ(GridPool::SizeClass(64), 64u);
+  EXPECT_EQ(GridPool::SizeClass(65), 128u);
+  EXPECT_EQ(GridPool::SizeClass(1000), 1024u);
+  EXPECT_EQ(GridPool::SizeClass(1025), 1152u);
+  for (size_t bytes = 1; bytes < 100000; bytes += 37) {
+    EXPECT_GE(GridPool::SizeClass(bytes), bytes);
+    EXPECT_LE(GridPool::SizeClass(bytes), bytes + bytes / 8 + 64);
+  }
+}
+
+TEST(GridPool, RecyclesFreedGrids) {
+  auto pool = std::make_shared<fluid_dynamics::GridPool>();
+  const double* first;
+
+  {
+    fluid_dynamics::Grid<double> grid(100, 90, pool.get());
+    first = grid.data();
+    EXPECT_EQ(grid.resource(), pool.get());
+  }
+  fluid_dynamics::Grid<double> grid(90, 100, pool.get());
+  fluid_dynamics::PoolStats stats = pool->stats();
+
+  EXPECT_EQ(grid.data(), first);
+  EXPECT_EQ(grid(89, 99), 0.0);
+  EXPECT_EQ(stats.requests, 2u);
+  EXPECT_EQ(stats.recycled, 1u);
+  EXPECT_EQ(stats.allocations, 1u);
+  EXPECT_EQ(stats.allocated_bytes, fluid_dynamics::GridPool::SizeClass(9000 * sizeof(double)));
+  EXPECT_EQ(stats.bytes_in_use, stats.allocated_bytes);
+  EXPECT_EQ(stats.cached_bytes, 0u);
+}
+
+TEST(GridPool, MovesKeepTheBufferAndCopiesLeaveThePool) {
+  auto pool = std::make_shared<fluid_dynamics::GridPool>();
+  fluid_dynamics::Grid<float> grid(8, 8, pool.get());
+  const float* buffer = grid.data();
+
+  fluid_dynamics::Grid<float> moved{std::move(grid)};
+  fluid_dynamics::Grid<float> copied{moved};
+  fluid_dynamics::Grid<float> pooled_copy{moved, pool.get()};
+
+  EXPECT_EQ(moved.data(), buffer);
+  EXPECT_EQ(moved.resource(), pool.get());
+  EXPECT_NE(copied.resource(), pool.get());
+  EXPECT_EQ(pooled_copy.resource(), pool.get());
+  EXPECT_EQ(pool->stats().requests, 2u);
+}
+
+TEST(GridPool, OutlivesItsOwnerWhileBuffersAreInUse) {
+  auto pool = std::make_shared<fluid_dynamics::GridPool>();
+  std::weak_ptr<fluid_dynamics::GridPool> observer = pool;
+
+  {
+    fluid_dynamics::Grid<double> grid(16, 16, pool.get());
+    pool.reset();
+    EXPECT_FALSE(observer.expired());
+    grid.Resize(20, 20);
+    EXPECT_EQ(grid(19, 19), 0.0);
+  }
+  EXPECT_TRUE(observer.expired());
+}
+
+TEST(GridPool, ReleaseReturnsCachedBuffers) {
+  auto pool = std::make_shared<fluid_dynamics::GridPool>();
+
+  static_cast<void>(fluid_dynamics::Grid<double>(32, 32, pool.get()));
+  EXPECT_GT(pool->stats().cached_bytes, 0u);
+  pool->Release();
+  pool->ResetStats();
+  EXPECT_EQ(pool->stats().cached_bytes, 0u);
+  EXPECT_EQ(pool->stats().allocations, 0u);
+  EXPECT_EQ(pool->stats().peak_bytes_in_use, 0u);
+}
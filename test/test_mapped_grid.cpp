@@ -0,0 +1,105 @@
+// File: test/test_mapped_grid.cpp
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+#include "poisson2d/poisson2d.h"
+
+using MappedGridTypes = ::testing::Types<
+    int,
+    float,
+    double
+>;
+
+template<typename T>
+class MappedGridPublicMethod : public GridTestBase<T> {
+ protected:
+  std::string filename_ = "mapped_grid_test.bin";
+
+  void TearDown() override {
+    std::remove(filename_.c_str());
+  }
+
+  fluid_dynamics::Grid<T> CreateGrid(size_t rows, size_t cols) {
+    fluid_dynamics::Grid<T> grid(rows, cols);
+
+    grid.Fill([cols](size_t i, size_t j) { return static_cast<T>(i * cols + j); });
+
+    return grid;
+  }
+};
+
+TYPED_TEST_SUITE(MappedGridPublicMethod, MappedGridTypes);
+
+TYPED_TEST(MappedGridPublicMethod, MapSquare) {
+  fluid_dynamics::Grid<TypeParam> grid = this->CreateGrid(8, 8);
+
+  fluid_dynamics::WriteGridBinary(grid, this->filename_);
+  fluid_dynamics::MappedGrid<TypeParam> mapped(this->filename_);
+
+  EXPECT_EQ(mapped.rows(), grid.rows());
+  EXPECT_EQ(mapped.cols(), grid.cols());
+  for (size_t i = 0; i < grid.rows(); ++i) {
+    for (size_t j = 0; j < grid.cols(); ++j) {
+      EXPECT_TYPE_EQ(mapped(i, j), grid(i, j));
+    }
+  }
+}
+
+TYPED_TEST(MappedGridPublicMethod, Region) {
+  fluid_dynamics::Grid<TypeParam> grid = this->CreateGrid(6, 10);
+
+  fluid_dynamics::WriteGridBinary(grid, this->filename_);
+  fluid_dynamics::MappedGrid<TypeParam> mapped(this->filename_, 6, 10);
+  fluid_dynamics::Grid<TypeParam> region = mapped.Region(2, 3, 3, 4);
+
+  this->verifyDimensions(region, 3, 4);
+  for (size_t i = 0; i < region.rows(); ++i) {
+    for (size_t j = 0; j < region.cols(); ++j) {
+      EXPECT_TYPE_EQ(region(i, j), grid(i + 2, j + 3));
+    }
+  }
+  EXPECT_THROW(static_cast<void>(mapped.Region(4, 0, 3, 1)), std::out_of_range);
+}
+
+TYPED_TEST(MappedGridPublicMethod, PyramidLevels) {
+  fluid_dynamics::Grid<TypeParam> grid(7, 8);
+
+  grid.Fill(static_cast<TypeParam>(4));
+  fluid_dynamics::WriteGridPyramid(grid, this->filename_, 3);
+
+  EXPECT_EQ(fluid_dynamics::MappedGrid<TypeParam>::Levels(this->filename_), 3);
+  fluid_dynamics::MappedGrid<TypeParam> level0 = fluid_dynamics::MappedGrid<TypeParam>::Level(this->filename_, 0);
+  fluid_dynamics::MappedGrid<TypeParam> level2 = fluid_dynamics::MappedGrid<TypeParam>::Level(this->filename_, 2);
+
+  EXPECT_EQ(level0.rows(), 7);
+  EXPECT_EQ(level0.cols(), 8);
+  EXPECT_EQ(level2.rows(), 2);
+  EXPECT_EQ(level2.cols(), 2);
+  for (size_t i = 0; i < level2.rows(); ++i) {
+    for (size_t j = 0; j < level2.cols(); ++j) {
+      EXPECT_TYPE_EQ(level2(i, j), static_cast<TypeParam>(4));
+    }
+  }
+  EXPECT_THROW(static_cast<void>(fluid_dynamics::MappedGrid<TypeParam>::Level(this->filename_, 3)), std::out_of_range);
+}
+
+TYPED_TEST(MappedGridPublicMethod, PyramidPairs) {
+  fluid_dynamics::Grid<std::pair<TypeParam, TypeParam>> grid(4, 4);
+
+  for (size_t i = 0; i < grid.rows(); ++i) {
+    for (size_t j = 0; j < grid.cols(); ++j) {
+      grid(i, j) = {static_cast<TypeParam>(2 * (j % 2)), static_cast<TypeParam>(2)};
+    }
+  }
+  fluid_dynamics::WriteGridPyramid(grid, this->filename_, 2);
+
+  auto level1 = fluid_dynamics::MappedGrid<std::pair<TypeParam, TypeParam>>::Level(this->filename_, 1);
+
+  EXPECT_EQ(level1.rows(), 2);
+  EXPECT_EQ(level1.cols(), 2);
+  EXPECT_TYPE_EQ(level1(1, 1).first, static_cast<TypeParam>(1));
+  EXPECT_TYPE_EQ(level1(1, 1).second, static_cast<TypeParam>(2));
+  EXPECT_THROW(static_cast<void>(fluid_dynamics::MappedGrid<TypeParam>::Level(this->filename_, 0)), std::runtime_error);
+}
@@ -0,0 +1,84 @@
+// File: test/test_mpi_ensemble.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "test_mpi_utils.h"
+
+namespace {
+
+// 12 splits evenly over groups of one to four ranks.
+constexpr size_t kSize = 12;
+constexpr size_t kCases = 7;
+constexpr size_t kSweeps = 200;
+
+fluid_dynamics::Bound<double> CaseBound(size_t case_id) {
+  fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kDirichlet);
+  auto lid = static_cast<double>(case_id + 1);
+
+  bound.AddBoundary({[](size_t i, size_t j) { return i == 0 || j == 0 || i == kSize - 1 || j == kSize - 1; },
+                     [lid](size_t i, size_t) { return i == 0 ? lid : 0.0; }});
+  return bound;
+}
+
+double CaseSource(size_t case_id) {
+  return 0.1 * static_cast<double>(case_id);
+}
+
+} // namespace
+
+class MpiEnsembleTest : public ::testing::TestWithParam<int> {};
+
+// Every case runs in exactly one group, and its record matches the serial solve of the case. A
+// fixed number of sweeps makes the distributed solve match the serial one bit for bit.
+TEST_P(MpiEnsembleTest, RunsEveryCaseOnceAndWritesItsRecord) {
+  fluid_dynamics::MpiEnsemble ensemble(mpi_grid->comm(), GetParam());
+  fluid_dynamics::MpiGrid2D& group_grid = ensemble.grid();
+  size_t rows = group_grid.LocalRows(kSize);
+  size_t cols = group_grid.LocalCols(kSize);
+  std::string filename = "test_mpi_ensemble_" + std::to_string(GetParam()) + ".bin";
+  std::vector<int> runs(kCases, 0);
+
+  EXPECT_EQ(ensemble.groups(), (mpi_grid->size() + GetParam() - 1) / GetParam());
+  ensemble.OpenOutput(filename, kSize * kSize * sizeof(double));
+  ensemble.Run(kCases, [&](size_t case_id) {
+    fluid_dynamics::SolverMpi<double> solver(0.0, kSweeps);
+    fluid_dynamics::Bound<double> bound = CaseBound(case_id);
+    double source = CaseSource(case_id);
+
+    solver.source([source](size_t, size_t) { return source; });
+    fluid_dynamics::Grid<double> grid = solver.Solve(rows, cols, bound, group_grid);
+    ensemble.WriteRecord(grid, case_id);
+    if (group_grid.rank() == 0) {
+      ++runs[case_id];
+    }
+  });
+  ensemble.CloseOutput();
+  MPI_Allreduce(MPI_IN_PLACE, runs.data(), static_cast<int>(kCases), MPI_INT, MPI_SUM, mpi_grid->comm());
+
+  EXPECT_EQ(runs, std::vector<int>(kCases, 1));
+  if (mpi_grid->rank() == 0) {
+    std::ifstream file{filename, std::ios::binary};
+    fluid_dynamics::Grid<double> record(kSize, kSize);
+
+    for (size_t case_id = 0; case_id < kCases; ++case_id) {
+      fluid_dynamics::Solver<double> serial(0.0, kSweeps);
+      fluid_dynamics::Bound<double> bound = CaseBound(case_id);
+      double source = CaseSource(case_id);
+
+      serial.source([source](size_t, size_t) { return source; });
+      file.read(reinterpret_cast<char*>(record.data()), kSize * kSize * sizeof(double));
+      EXPECT_TRUE(file.good()) << case_id;
+      ExpectGridEq(record, serial.Solve(kSize, kSize, bound));
+    }
+    file.close();
+    std::remove(filename.c_str());
+  }
+  MPI_Barrier(mpi_grid->comm());
+}
+
+// Groups of one and two ranks, and of three, which leaves a smaller last group on four ranks and a
+// single group of two on two.
+INSTANTIATE_TEST_SUITE_P(GroupSizes, MpiEnsembleTest, ::testing::Values(1, 2, 3));
@@ -0,0 +1,169 @@
+// File: test/test_mpi_large_count.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+#include "test_mpi_utils.h"
+
+namespace {
+
+// Lowers the count limit while in scope, so grids of a few thousand cells take the chunked paths of
+// blocks beyond 2^31 elements.
+class CountLimit {
+ public:
+  explicit CountLimit(size_t limit) : previous_{fluid_dynamics::MpiGrid2D::count_limit()} {
+    fluid_dynamics::MpiGrid2D::count_limit(limit);
+  }
+  ~CountLimit() { fluid_dynamics::MpiGrid2D::count_limit(previous_); }
+
+ private:
+  size_t previous_;
+};
+
+} // namespace
+
+using LargeCountTypes = ::testing::Types<int, double>;
+
+template<typename T>
+class MpiLargeCountTest : public ::testing::Test {};
+
+TYPED_TEST_SUITE(MpiLargeCountTest, LargeCountTypes);
+
+TYPED_TEST(MpiLargeCountTest, ContiguousTypeCoversEveryElement) {
+  CountLimit limit{7};
+
+  for (size_t count : {1, 6, 7, 8, 49, 100}) {
+    MPI_Datatype type = fluid_dynamics::ContiguousType(count, fluid_dynamics::MpiType<TypeParam>());
+    MPI_Count size, lower_bound, extent;
+    std::vector<TypeParam> send(count), recv(count);
+    for (size_t n = 0; n < count; ++n) {
+      send[n] = static_cast<TypeParam>(n + 1);
+    }
+
+    MPI_Type_size_x(type, &size);
+    MPI_Type_get_extent_x(type, &lower_bound, &extent);
+    EXPECT_EQ(static_cast<size_t>(size), count * sizeof(TypeParam));
+    EXPECT_EQ(static_cast<size_t>(extent), count * sizeof(TypeParam));
+    MPI_Sendrecv(send.data(), 1, type, 0, 0, recv.data(), 1, type, 0, 0, MPI_COMM_SELF, MPI_STATUS_IGNORE);
+    EXPECT_EQ(recv, send) << count;
+    MPI_Type_free(&type);
+  }
+}
+
+TYPED_TEST(MpiLargeCountTest, ScatterAndGather) {
+  CountLimit limit{13};
+  fluid_dynamics::Grid<TypeParam> global = GlobalGrid<TypeParam>(kRows, kCols);
+  auto grid = fluid_dynamics::DistributedGrid<TypeParam>::Scatter(
+      mpi_grid->rank() == 0 ? global : fluid_dynamics::Grid<TypeParam>{}, *mpi_grid);
+  std::vector<int> ranks(mpi_grid->size());
+
+  for (size_t i = 0; i < grid.local().rows(); ++i) {
+    for (size_t j = 0; j < grid.local().cols(); ++j) {
+      ASSERT_EQ(grid.local()(i, j), global(grid.origin_row() + i, grid.origin_col() + j));
+    }
+  }
+
+  fluid_dynamics::Grid<TypeParam> gathered = grid.Gather();
+  if (mpi_grid->rank() == 0) {
+    ExpectGridEq(gathered, global);
+  } else {
+    EXPECT_EQ(gathered.rows() * gathered.cols(), 0u);
+  }
+
+  for (int r = 0; r < mpi_grid->size(); ++r) {
+    ranks[r] = mpi_grid->size() - 1 - r;
+  }
+  ExpectGridEq(grid.Gather(ranks), global);
+}
+
+TYPED_TEST(MpiLargeCountTest, Redistribute) {
+  CountLimit limit{5};
+  fluid_dynamics::Grid<TypeParam> global = GlobalGrid<TypeParam>(kRows, kCols);
+  fluid_dynamics::MpiGrid2D target(MPI_COMM_WORLD, mpi_grid->size(), 1);
+  fluid_dynamics::DistributedGrid<TypeParam> grid(*mpi_grid, kRows, kCols);
+
+  for (size_t i = 0; i < grid.local().rows(); ++i) {
+    for (size_t j = 0; j < grid.local().cols(); ++j) {
+      grid.local()(i, j) = global(grid.origin_row() + i, grid.origin_col() + j);
+    }
+  }
+
+  fluid_dynamics::DistributedGrid<TypeParam> moved = grid.Redistribute(target);
+  for (size_t i = 0; i < moved.local().rows(); ++i) {
+    for (size_t j = 0; j < moved.local().cols(); ++j) {
+      ASSERT_EQ(moved.local()(i, j), global(moved.origin_row() + i, moved.origin_col() + j));
+    }
+  }
+}
+
+TYPED_TEST(MpiLargeCountTest, WriteGridBinary) {
+  CountLimit limit{5};
+  fluid_dynamics::Grid<TypeParam> global = GlobalGrid<TypeParam>(kRows, kCols);
+  fluid_dynamics::DistributedGrid<TypeParam> grid(*mpi_grid, kRows, kCols);
+  std::string filename = "test_mpi_large_count.bin";
+
+  for (size_t i = 0; i < grid.local().rows(); ++i) {
+    for (size_t j = 0; j < grid.local().cols(); ++j) {
+      grid.local()(i, j) = global(grid.origin_row() + i, grid.origin_col() + j);
+    }
+  }
+  WriteGridBinary(grid, filename);
+
+  if (mpi_grid->rank() == 0) {
+    fluid_dynamics::Grid<TypeParam> written(kRows, kCols);
+    std::ifstream file{filename, std::ios::binary};
+    file.read(reinterpret_cast<char*>(written.data()), kRows * kCols * sizeof(TypeParam));
+    EXPECT_TRUE(file.good());
+    ExpectGridEq(written, global);
+    std::remove(filename.c_str());
+  }
+  MPI_Barrier(mpi_grid->comm());
+}
+
+TEST(MpiLargeCount, SolveMatchesDefaultLimit) {
+  fluid_dynamics::Bound<double> bound;
+  fluid_dynamics::SolverMpi<double> solver(1e-4, 200);
+  fluid_dynamics::Grid<double> expected, chunked;
+  size_t rows = mpi_grid->LocalRows(kRows);
+  size_t cols = mpi_grid->LocalCols(kCols);
+
+  bound.AddBoundary(fluid_dynamics::SegmentBoundary<double>({0, 0}, {0, kCols - 1},
+                                                            fluid_dynamics::ConstantValue<double>(1.0)));
+  bound.AddBoundary(fluid_dynamics::SegmentBoundary<double>({kRows / 2, kCols / 4}, {kRows / 2, kCols / 2},
+                                                            fluid_dynamics::LinearValue<double>(2.0, 0.0, 0.5)));
+  expected = solver.Solve(rows, cols, bound, *mpi_grid);
+  {
+    CountLimit limit{3};
+    chunked = solver.Solve(rows, cols, bound, *mpi_grid);
+  }
+
+  ExpectGridEq(chunked, expected);
+}
+
+// Blocks of 25k x 25k doubles and the file of a 25k x 50k grid of pairs, both far beyond the int
+// range. Only types and offsets are built, nothing is allocated.
+TEST(MpiLargeCount, OversizedDecomposition) {
+  size_t rows = 25000;
+  size_t cols = 25000;
+  MPI_Datatype block = fluid_dynamics::ContiguousType(rows * cols * sizeof(double), MPI_BYTE);
+  MPI_Count size, lower_bound, extent;
+
+  MPI_Type_size_x(block, &size);
+  MPI_Type_get_extent_x(block, &lower_bound, &extent);
+  EXPECT_EQ(static_cast<size_t>(size), rows * cols * sizeof(double));
+  EXPECT_EQ(static_cast<size_t>(extent), rows * cols * sizeof(double));
+  MPI_Type_free(&block);
+
+  fluid_dynamics::MpiGrid2D layout(MPI_COMM_WORLD, 1, mpi_grid->size());
+  size_t local_cols = 2 * cols / static_cast<size_t>(mpi_grid->size());
+  size_t global_cols = local_cols * static_cast<size_t>(mpi_grid->size());
+  unsigned long long expected = ((rows - 1) * global_cols + static_cast<size_t>(layout.col()) * local_cols) * 16;
+  EXPECT_EQ(static_cast<unsigned long long>(fluid_dynamics::RowOffset(layout, rows, local_cols, rows - 1, 16)),
+            expected);
+  EXPECT_GT(expected, static_cast<unsigned long long>(std::numeric_limits<int>::max()));
+
+  EXPECT_THROW(fluid_dynamics::MpiCount(rows * cols * sizeof(double)), std::overflow_error);
+  EXPECT_THROW(fluid_dynamics::MpiGrid2D::count_limit(0), std::invalid_argument);
+}
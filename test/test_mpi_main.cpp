@@ -0,0 +1,20 @@
+// File: test/test_mpi_main.cpp
+#include <gtest/gtest.h>
+#include "test_mpi_utils.h"
+
+// Every rank runs the tests, only the first one reports.
+int main(int argc, char** argv) {
+  fluid_dynamics::MpiGrid2D grid(argc, argv);
+  int result;
+
+  mpi_grid = &grid;
+  ::testing::InitGoogleTest(&argc, argv);
+  if (grid.rank() != 0) {
+    delete ::testing::UnitTest::GetInstance()->listeners().Release(
+        ::testing::UnitTest::GetInstance()->listeners().default_result_printer());
+  }
+  result = RUN_ALL_TESTS();
+  MPI_Allreduce(MPI_IN_PLACE, &result, 1, MPI_INT, MPI_MAX, grid.comm());
+
+  return result;
+}
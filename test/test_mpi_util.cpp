@@ -0,0 +1,82 @@
+// File: test/test_mpi_util.cpp
+#include <gtest/gtest.h>
+#include <cmath>
+#include "test_mpi_utils.h"
+
+// Every addend is below half an ulp of the running sum, so the naive sum never moves while the
+// compensation collects all of them. Powers of two keep the compensation exact.
+TEST(CompensatedAdd, RecoversLostLowOrderBits) {
+  double tiny = std::ldexp(1.0, -60);
+  double naive = 1.0;
+  double sum = 1.0;
+  double compensation = 0.0;
+
+  for (int n = 0; n < 1000; ++n) {
+    naive += tiny;
+    fluid_dynamics::CompensatedAdd(tiny, 0.0, sum, compensation);
+  }
+
+  EXPECT_EQ(naive, 1.0);
+  EXPECT_EQ(sum, 1.0);
+  EXPECT_EQ(compensation, 1000 * tiny);
+}
+
+// The first rank contributes 2^53, where the spacing of doubles is 2, and all others 1. MPI_SUM
+// loses every one of them, the pair reduction keeps them in the compensation.
+TEST(CompensatedAdd, SumOpKeepsSmallContributions) {
+  double big = 9007199254740992.0;
+  double local[2] = {mpi_grid->rank() == 0 ? big : 1.0, 0.0};
+  double global[2];
+  double naive;
+  MPI_Datatype pair;
+  MPI_Op op;
+
+  MPI_Type_contiguous(2, MPI_DOUBLE, &pair);
+  MPI_Type_commit(&pair);
+  MPI_Op_create(&fluid_dynamics::CompensatedSumOp<double>, 1, &op);
+  MPI_Allreduce(local, global, 1, pair, op, mpi_grid->comm());
+  MPI_Allreduce(local, &naive, 1, MPI_DOUBLE, MPI_SUM, mpi_grid->comm());
+  MPI_Op_free(&op);
+  MPI_Type_free(&pair);
+
+  EXPECT_EQ((global[0] - big) + global[1], static_cast<double>(mpi_grid->size() - 1));
+  if (mpi_grid->size() == 2) {
+    EXPECT_EQ(naive, big);
+  }
+}
+
+// Among the blocks that tile the process grid the one with the shortest edge wins, in processes
+// along each dimension.
+TEST(NodeBlock, PicksSmallestSurface) {
+  int square[2] = {4, 4};
+  int wide[2] = {2, 8};
+  int block[2];
+
+  ASSERT_TRUE(fluid_dynamics::MpiGrid2D::NodeBlock(square, 4, block));
+  EXPECT_EQ(block[0], 2);
+  EXPECT_EQ(block[1], 2);
+  ASSERT_TRUE(fluid_dynamics::MpiGrid2D::NodeBlock(wide, 4, block));
+  EXPECT_EQ(block[0], 1);
+  EXPECT_EQ(block[1], 4);
+  ASSERT_TRUE(fluid_dynamics::MpiGrid2D::NodeBlock(square, 1, block));
+  EXPECT_EQ(block[0], 1);
+  EXPECT_EQ(block[1], 1);
+  ASSERT_TRUE(fluid_dynamics::MpiGrid2D::NodeBlock(square, 16, block));
+  EXPECT_EQ(block[0], 4);
+  EXPECT_EQ(block[1], 4);
+}
+
+// Node sizes that no block of whole process rows and columns can tile leave block untouched.
+TEST(NodeBlock, RejectsUnevenNodes) {
+  int odd[2] = {3, 3};
+  int mixed[2] = {4, 6};
+  int small[2] = {2, 2};
+  int block[2] = {-1, -1};
+
+  EXPECT_FALSE(fluid_dynamics::MpiGrid2D::NodeBlock(odd, 2, block));
+  EXPECT_FALSE(fluid_dynamics::MpiGrid2D::NodeBlock(mixed, 5, block));
+  EXPECT_FALSE(fluid_dynamics::MpiGrid2D::NodeBlock(small, 8, block));
+  EXPECT_FALSE(fluid_dynamics::MpiGrid2D::NodeBlock(mixed, 16, block));
+  EXPECT_EQ(block[0], -1);
+  EXPECT_EQ(block[1], -1);
+}
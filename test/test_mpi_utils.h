@@ -0,0 +1,56 @@
+// File: test/test_mpi_utils.h
+#ifndef FLUID_DYNAMICS_SIMULATION_TEST_TEST_MPI_UTILS_H_
+#define FLUID_DYNAMICS_SIMULATION_TEST_TEST_MPI_UTILS_H_
+
+#include <gtest/gtest.h>
+#include "poisson2d/poisson2d_mpi.h"
+
+// The world grid created in test_mpi_main.cpp.
+inline fluid_dynamics::MpiGrid2D* mpi_grid = nullptr;
+
+// 24 x 36 splits evenly over 1, 2, 3, 4 and 6 ranks.
+constexpr size_t kRows = 24;
+constexpr size_t kCols = 36;
+
+template<typename T>
+fluid_dynamics::Grid<T> GlobalGrid(size_t rows, size_t cols) {
+  fluid_dynamics::Grid<T> grid(rows, cols);
+
+  grid.Fill([](size_t i, size_t j) { return static_cast<T>(1000 * i + j); });
+  return grid;
+}
+
+// The block of a global grid that the rank owns when the grid is split over mpi_grid.
+template<typename T>
+fluid_dynamics::Grid<T> LocalBlock(const fluid_dynamics::Grid<T>& global, const fluid_dynamics::MpiGrid2D& grid) {
+  size_t rows = grid.LocalRows(global.rows());
+  size_t cols = grid.LocalCols(global.cols());
+  fluid_dynamics::Grid<T> block(rows, cols);
+
+  block.Fill([&](size_t i, size_t j) { return global(grid.GlobalRow(i, rows), grid.GlobalCol(j, cols)); });
+  return block;
+}
+
+template<typename T>
+void ExpectGridEq(const fluid_dynamics::Grid<T>& actual, const fluid_dynamics::Grid<T>& expected) {
+  ASSERT_EQ(actual.rows(), expected.rows());
+  ASSERT_EQ(actual.cols(), expected.cols());
+  for (size_t i = 0; i < actual.rows(); ++i) {
+    for (size_t j = 0; j < actual.cols(); ++j) {
+      ASSERT_EQ(actual(i, j), expected(i, j)) << i << " " << j;
+    }
+  }
+}
+
+template<typename T>
+void ExpectGridNear(const fluid_dynamics::Grid<T>& actual, const fluid_dynamics::Grid<T>& expected, T tolerance) {
+  ASSERT_EQ(actual.rows(), expected.rows());
+  ASSERT_EQ(actual.cols(), expected.cols());
+  for (size_t i = 0; i < actual.rows(); ++i) {
+    for (size_t j = 0; j < actual.cols(); ++j) {
+      ASSERT_NEAR(actual(i, j), expected(i, j), tolerance) << i << " " << j;
+    }
+  }
+}
+
+#endif // FLUID_DYNAMICS_SIMULATION_TEST_TEST_MPI_UTILS_H_
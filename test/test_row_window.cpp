@@ -0,0 +1,41 @@
+// File: test/test_row_window.cpp
+#include <gtest/gtest.h>
+#include <vector>
+#include "poisson2d/poisson2d.h"
+
+using RowWindowTypes = ::testing::Types<int, float, double>;
+
+template<typename T>
+class RowWindowTest : public ::testing::Test {};
+
+TYPED_TEST_SUITE(RowWindowTest, RowWindowTypes);
+
+TYPED_TEST(RowWindowTest, Dimensions) {
+  fluid_dynamics::RowWindow<TypeParam> window(2, 7, 3);
+
+  EXPECT_EQ(window.radius(), 2u);
+  EXPECT_EQ(window.cols(), 7u);
+  EXPECT_EQ(window.capacity(), 8u);
+  EXPECT_EQ(window.bytes(), 56 * sizeof(TypeParam));
+}
+
+TYPED_TEST(RowWindowTest, SlidingKeepsTheStencilRows) {
+  size_t cols = 3;
+  fluid_dynamics::RowWindow<TypeParam> window(1, cols, 1);
+  fluid_dynamics::Grid<TypeParam> grid(10, cols);
+  grid.Fill([](size_t i, size_t j) { return static_cast<TypeParam>(10 * i + j); });
+
+  window.Reset(2);
+  for (size_t i = 2; i < grid.rows(); ++i) {
+    window.Push(grid.data(i, 0));
+    EXPECT_EQ(window.end(), i + 1);
+    for (size_t k = std::max<size_t>(i, 4) - 2; k <= i; ++k) {
+      EXPECT_EQ(window.row(k)[0], grid(k, 0));
+      EXPECT_EQ(window.row(k)[cols - 1], grid(k, cols - 1));
+    }
+    if (i > 2) {
+      EXPECT_EQ(window.row(i - 1) + cols, window.row(i));
+    }
+  }
+  EXPECT_GT(window.first(), 2u);
+}
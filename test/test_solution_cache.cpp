@@ -0,0 +1,108 @@
+// File: test/test_solution_cache.cpp
+#include <memory>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+#include "poisson2d/poisson2d.h"
+
+using SolutionCacheTypes = ::testing::Types<
+    float,
+    double
+>;
+
+template<typename T>
+class SolutionCacheTest : public ::testing::Test {
+ protected:
+  // Lid driven cavity on an L x L grid with the given lid value.
+  static fluid_dynamics::Bound<T> CavityBound(size_t L, T lid) {
+    fluid_dynamics::Bound<T> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+    bound.AddBoundary({[](size_t i, size_t) { return i == 0; },
+                       [lid](size_t, size_t) { return lid; }});
+    bound.AddBoundary({[L](size_t i, size_t j) { return i == L - 1 || j == 0 || j == L - 1; },
+                       [](size_t, size_t) { return static_cast<T>(0); }});
+
+    return bound;
+  }
+};
+
+TYPED_TEST_SUITE(SolutionCacheTest, SolutionCacheTypes);
+
+TYPED_TEST(SolutionCacheTest, KeySeparatesGeometryFromValues) {
+  auto a = fluid_dynamics::SolutionCache<TypeParam>::Key(8, 8, this->CavityBound(8, 1));
+  auto b = fluid_dynamics::SolutionCache<TypeParam>::Key(8, 8, this->CavityBound(8, 2));
+  auto c = fluid_dynamics::SolutionCache<TypeParam>::Key(9, 9, this->CavityBound(9, 1));
+
+  EXPECT_EQ(a.geometry, b.geometry);
+  EXPECT_NE(a.values, b.values);
+  EXPECT_NE(a.geometry, c.geometry);
+}
+
+TYPED_TEST(SolutionCacheTest, LookupReturnsNearestValues) {
+  fluid_dynamics::SolutionCache<TypeParam> cache;
+  fluid_dynamics::Grid<TypeParam> one(8), three(8);
+
+  one.Fill(1);
+  three.Fill(3);
+  cache.Insert(cache.Key(8, 8, this->CavityBound(8, 1)), one, 10);
+  cache.Insert(cache.Key(8, 8, this->CavityBound(8, 3)), three, 30);
+  auto cached = cache.Lookup(cache.Key(8, 8, this->CavityBound(8, static_cast<TypeParam>(2.6))));
+
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_FALSE(cached->prolongated);
+  EXPECT_EQ(cached->iterations, 30u);
+  EXPECT_TYPE_EQ(cached->solution(4, 4), static_cast<TypeParam>(3));
+  EXPECT_EQ(cache.hits(), 1u);
+}
+
+TYPED_TEST(SolutionCacheTest, LookupProlongatesCoarserSolution) {
+  fluid_dynamics::SolutionCache<TypeParam> cache;
+  fluid_dynamics::Grid<TypeParam> coarse(5);
+
+  EXPECT_FALSE(cache.Lookup(cache.Key(9, 9, this->CavityBound(9, 1))).has_value());
+  EXPECT_EQ(cache.misses(), 1u);
+
+  coarse.Fill([](size_t i, size_t j) { return static_cast<TypeParam>(2 * i + j); });
+  cache.Insert(cache.Key(5, 5, this->CavityBound(5, 1)), coarse, 100);
+  auto cached = cache.Lookup(cache.Key(9, 9, this->CavityBound(9, 1)));
+
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_TRUE(cached->prolongated);
+  EXPECT_GT(cached->iterations, 100u);
+  for (size_t i = 0; i < 9; ++i) {
+    for (size_t j = 0; j < 9; ++j) {
+      EXPECT_NEAR(cached->solution(i, j), static_cast<TypeParam>(i + 0.5 * j), 1e-5);
+    }
+  }
+}
+
+TYPED_TEST(SolutionCacheTest, EvictsLeastRecentlyUsed) {
+  fluid_dynamics::SolutionCache<TypeParam> cache(2);
+  fluid_dynamics::Grid<TypeParam> grid(8);
+
+  cache.Insert(cache.Key(8, 8, this->CavityBound(8, 1)), grid, 1);
+  cache.Insert(cache.Key(8, 8, this->CavityBound(8, 2)), grid, 2);
+  cache.Insert(cache.Key(8, 8, this->CavityBound(8, 2)), grid, 3);
+  EXPECT_EQ(cache.size(), 2u);
+  cache.Insert(cache.Key(8, 8, this->CavityBound(8, 5)), grid, 5);
+  EXPECT_EQ(cache.size(), 2u);
+
+  auto cached = cache.Lookup(cache.Key(8, 8, this->CavityBound(8, 1)));
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->iterations, 3u);
+}
+
+TYPED_TEST(SolutionCacheTest, SolverSavesIterationsOnPerturbedBoundary) {
+  size_t L = 16;
+  fluid_dynamics::Solver<TypeParam> solver(static_cast<TypeParam>(1e-3), 5000);
+
+  solver.cache(std::make_shared<fluid_dynamics::SolutionCache<TypeParam>>());
+  static_cast<void>(solver.Solve(L, L, this->CavityBound(L, 1)));
+  size_t cold = solver.iterations();
+  EXPECT_EQ(solver.iterations_saved(), 0u);
+
+  static_cast<void>(solver.Solve(L, L, this->CavityBound(L, static_cast<TypeParam>(1.01))));
+  EXPECT_LT(solver.iterations(), cold);
+  EXPECT_EQ(solver.iterations_saved(), cold - solver.iterations());
+  EXPECT_EQ(solver.cache()->hits(), 1u);
+  EXPECT_EQ(solver.cache()->size(), 2u);
+}
@@ -161,3 +161,128 @@ TYPED_TEST(SolverPublicMethod, MutateSource) {
 
   this->verifyData(computed_source, expected_source);
 }
+
+TYPED_TEST(SolverPublicMethod, MutateSourceGrid) {
+  fluid_dynamics::Grid<TypeParam> computed_source(10, 10), expected_source(10, 10);
+  fluid_dynamics::Solver<TypeParam> solver;
+
+  for (size_t i = 0; i < expected_source.rows(); ++i) {
+    for (size_t j = 0; j < expected_source.cols(); ++j) {
+      expected_source(i, j) = static_cast<TypeParam>(i * expected_source.cols() + j);
+    }
+  }
+
+  solver.source(expected_source);
+
+  for (size_t i = 0; i < computed_source.rows(); ++i) {
+    for (size_t j = 0; j < computed_source.cols(); ++j) {
+      computed_source(i, j) = solver.source(i, j);
+    }
+  }
+
+  this->verifyData(computed_source, expected_source);
+}
+
+TYPED_TEST(SolverPublicMethod, MutateSourceRows) {
+  fluid_dynamics::Grid<TypeParam> computed_source(10, 10), expected_source(10, 10);
+  fluid_dynamics::Solver<TypeParam> solver;
+
+  solver.source_rows([](size_t i, size_t j_begin, size_t j_end, TypeParam* out) {
+    for (size_t j = j_begin; j < j_end; ++j) {
+      out[j - j_begin] = static_cast<TypeParam>(i * 10 + j);
+    }
+  });
+
+  for (size_t i = 0; i < computed_source.rows(); ++i) {
+    for (size_t j = 0; j < computed_source.cols(); ++j) {
+      computed_source(i, j) = solver.source(i, j);
+      expected_source(i, j) = static_cast<TypeParam>(i * 10 + j);
+    }
+  }
+
+  this->verifyData(computed_source, expected_source);
+}
+
+TYPED_TEST(SolverPublicMethod, SourceKindsSolveIdentically) {
+  size_t L = 12;
+  fluid_dynamics::Bound<TypeParam> bound;
+  fluid_dynamics::Grid<TypeParam> source_grid(L, L);
+  fluid_dynamics::Solver<TypeParam> solver(static_cast<TypeParam>(1e-3), 200);
+  auto source = [](size_t i, size_t j) { return static_cast<TypeParam>((i + 2 * j) % 5); };
+
+  bound.AddBoundary({[L](size_t i, size_t j) { return i == 0 || j == 0 || i == L - 1 || j == L - 1; },
+                     [](size_t, size_t) { return static_cast<TypeParam>(1); }});
+  for (size_t i = 0; i < L; ++i) {
+    for (size_t j = 0; j < L; ++j) {
+      source_grid(i, j) = source(i, j);
+    }
+  }
+
+  solver.source(source);
+  fluid_dynamics::Grid<TypeParam> expected = solver.Solve(L, L, bound, false);
+  solver.source(source_grid);
+  fluid_dynamics::Grid<TypeParam> from_grid = solver.Solve(L, L, bound, false);
+  solver.source_rows([&source](size_t i, size_t j_begin, size_t j_end, TypeParam* out) {
+    for (size_t j = j_begin; j < j_end; ++j) {
+      out[j - j_begin] = source(i, j);
+    }
+  });
+  fluid_dynamics::Grid<TypeParam> from_rows = solver.Solve(L, L, bound, false);
+
+  this->verifyData(from_grid, expected);
+  this->verifyData(from_rows, expected);
+}
+
+TYPED_TEST(SolverPublicMethod, SourceGridDimensionMismatch) {
+  fluid_dynamics::Bound<TypeParam> bound;
+  fluid_dynamics::Solver<TypeParam> solver;
+
+  solver.source(fluid_dynamics::Grid<TypeParam>(4, 4));
+
+  EXPECT_THROW(solver.Solve(8, 8, bound, false), std::invalid_argument);
+}
+
+TYPED_TEST(SolverPublicMethod, WarmStartFromSolution) {
+  size_t L = 12;
+  fluid_dynamics::Bound<TypeParam> bound;
+  fluid_dynamics::Solver<TypeParam> solver(static_cast<TypeParam>(1e-3), 500);
+
+  bound.AddBoundary({[L](size_t i, size_t j) { return i == 0 || j == 0 || i == L - 1 || j == L - 1; },
+                     [](size_t i, size_t) { return static_cast<TypeParam>(i == 0); }});
+
+  fluid_dynamics::Grid<TypeParam> cold = solver.Solve(L, L, bound, false);
+  size_t cold_iterations = solver.iterations();
+  static_cast<void>(solver.Solve(L, L, bound, cold, false));
+
+  EXPECT_GT(cold_iterations, 1u);
+  EXPECT_EQ(solver.iterations(), 1u);
+  EXPECT_THROW(solver.Solve(L + 1, L, bound, cold, false), std::invalid_argument);
+}
+
+// Once a solve has run, further solves of the same size and their post-processing only reuse
+// buffers of the pool.
+TYPED_TEST(SolverPublicMethod, PoolAllocatesNothingInSteadyState) {
+  size_t L = 24;
+  fluid_dynamics::Bound<TypeParam> bound;
+  fluid_dynamics::Solver<TypeParam> solver(static_cast<TypeParam>(1e-3), 50);
+
+  bound.AddBoundary({[L](size_t i, size_t j) { return i == 0 || j == 0 || i == L - 1 || j == L - 1; },
+                     [](size_t i, size_t) { return static_cast<TypeParam>(i == 0); }});
+
+  static_cast<void>(solver.Velocity(solver.Gradient(solver.Solve(L, L, bound, false))));
+  solver.pool()->ResetStats();
+  for (int repeat = 0; repeat < 3; ++repeat) {
+    fluid_dynamics::Grid<TypeParam> solution = solver.Solve(L, L, bound, false);
+    static_cast<void>(solver.Velocity(solver.Gradient(solution)));
+  }
+  fluid_dynamics::PoolStats stats = solver.pool()->stats();
+
+  EXPECT_EQ(stats.allocations, 0u);
+  EXPECT_EQ(stats.allocated_bytes, 0u);
+  EXPECT_GT(stats.recycled, 3u * solver.iterations());
+  EXPECT_EQ(stats.bytes_in_use, 0u);
+
+  solver.pool(nullptr);
+  fluid_dynamics::Grid<TypeParam> solution = solver.Solve(L, L, bound, false);
+  EXPECT_EQ(solution.resource(), std::pmr::get_default_resource());
+}
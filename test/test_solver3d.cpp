@@ -0,0 +1,76 @@
+// File: test/test_solver3d.cpp
+#include <cmath>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "poisson2d/poisson2d.h"
+
+using Solver3DTypes = ::testing::Types<float, double>;
+
+template<typename T>
+class Solver3DTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kSize = 9;
+
+  // Harmonic for the 7-point Laplacian, so the discrete solution is exact.
+  static T Harmonic(size_t i, size_t j, size_t k) {
+    auto x = static_cast<T>(i);
+    auto y = static_cast<T>(j);
+    auto z = static_cast<T>(k);
+    return x * x + y * y - 2 * z * z;
+  }
+
+  static fluid_dynamics::Bound3D<T> FaceBound(size_t size) {
+    fluid_dynamics::Bound3D<T> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+    bound.AddBoundary({[size](size_t i, size_t j, size_t k) {
+                         return i == 0 || j == 0 || k == 0 || i == size - 1 || j == size - 1 || k == size - 1;
+                       },
+                       Harmonic});
+    return bound;
+  }
+};
+
+TYPED_TEST_SUITE(Solver3DTest, Solver3DTypes);
+
+TYPED_TEST(Solver3DTest, ReproducesHarmonicFunction) {
+  fluid_dynamics::Solver3D<TypeParam> solver(static_cast<TypeParam>(1e-6), 10000);
+  size_t n = this->kSize;
+
+  fluid_dynamics::Grid3D<TypeParam> result = solver.Solve(n, n, n, this->FaceBound(n));
+
+  EXPECT_LT(solver.iterations(), 10000u);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      for (size_t k = 0; k < n; ++k) {
+        EXPECT_NEAR(result(i, j, k), this->Harmonic(i, j, k), 1e-3);
+      }
+    }
+  }
+}
+
+TYPED_TEST(Solver3DTest, GradientIsExactForQuadratics) {
+  fluid_dynamics::Solver3D<TypeParam> solver;
+  size_t n = this->kSize;
+  fluid_dynamics::Grid3D<TypeParam> field(n, n, n);
+  field.Fill(this->Harmonic);
+
+  fluid_dynamics::Grid3D<std::array<TypeParam, 3>> velocity = solver.Velocity(solver.Gradient(field));
+
+  EXPECT_EQ(velocity(0, 4, 4)[0], TypeParam{0});
+  for (size_t i = 1; i < n - 1; ++i) {
+    for (size_t j = 1; j < n - 1; ++j) {
+      for (size_t k = 1; k < n - 1; ++k) {
+        EXPECT_FLOAT_EQ(velocity(i, j, k)[0], static_cast<TypeParam>(2 * i));
+        EXPECT_FLOAT_EQ(velocity(i, j, k)[1], static_cast<TypeParam>(2 * j));
+        EXPECT_FLOAT_EQ(velocity(i, j, k)[2], -static_cast<TypeParam>(4 * k));
+      }
+    }
+  }
+}
+
+TYPED_TEST(Solver3DTest, RejectsPeriodicBoundaries) {
+  fluid_dynamics::Solver3D<TypeParam> solver;
+  fluid_dynamics::Bound3D<TypeParam> bound(fluid_dynamics::BoundaryType::kPeriodic);
+
+  EXPECT_THROW(static_cast<void>(solver.Solve(4, 4, 4, bound)), std::invalid_argument);
+}
@@ -0,0 +1,114 @@
+// File: test/test_solver_amr.cpp
+#include <cmath>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+#include "poisson2d/poisson2d.h"
+
+using AmrTypes = ::testing::Types<float, double>;
+
+template<typename T>
+class SolverAmrTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kSize = 33;
+
+  // Driven lid with a plate held at half the lid value below the centre line.
+  static fluid_dynamics::Bound<T> PlateBound(size_t size) {
+    fluid_dynamics::Bound<T> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+    bound.AddBoundary({[size](size_t i, size_t j) { return i == 0 || j == 0 || i == size - 1 || j == size - 1; },
+                       [](size_t i, size_t) { return i == 0 ? T{1} : T{0}; }});
+    bound.AddBoundary({[size](size_t i, size_t j) { return i == size / 2 + 3 && j > size / 4 && j < 3 * size / 4; },
+                       [](size_t, size_t) { return T{0.5}; }});
+
+    return bound;
+  }
+
+  static fluid_dynamics::AmrOptions Options(size_t levels, size_t block_size) {
+    fluid_dynamics::AmrOptions options;
+
+    options.levels = levels;
+    options.block_size = block_size;
+    return options;
+  }
+};
+
+TYPED_TEST_SUITE(SolverAmrTest, AmrTypes);
+
+TYPED_TEST(SolverAmrTest, BaseLevelMatchesUniformSolve) {
+  fluid_dynamics::SolverAmr<TypeParam> amr(static_cast<TypeParam>(1e-12), 200);
+  fluid_dynamics::Solver<TypeParam> solver(static_cast<TypeParam>(1e-12), 200);
+  fluid_dynamics::Bound<TypeParam> bound = this->PlateBound(this->kSize);
+
+  amr.options(this->Options(0, 8));
+  fluid_dynamics::Grid<TypeParam> result = amr.Solve(this->kSize, this->kSize, bound);
+  fluid_dynamics::Grid<TypeParam> expected = solver.Solve(this->kSize, this->kSize, bound);
+
+  EXPECT_EQ(amr.levels().size(), 1u);
+  EXPECT_EQ(amr.cells(), this->kSize * this->kSize);
+  for (size_t i = 0; i < this->kSize; ++i) {
+    for (size_t j = 0; j < this->kSize; ++j) {
+      EXPECT_TYPE_EQ(result(i, j), expected(i, j));
+    }
+  }
+}
+
+TYPED_TEST(SolverAmrTest, RefinesAroundInternalBoundary) {
+  fluid_dynamics::SolverAmr<TypeParam> amr(static_cast<TypeParam>(1e-9), 100000);
+  fluid_dynamics::Solver<TypeParam> solver(static_cast<TypeParam>(1e-9), 100000);
+  fluid_dynamics::Solver<TypeParam> coarse(static_cast<TypeParam>(1e-9), 100000);
+  size_t coarse_size = (this->kSize - 1) / 4 + 1;
+
+  amr.options(this->Options(2, 4));
+  fluid_dynamics::Grid<TypeParam> result = amr.Solve(this->kSize, this->kSize, this->PlateBound(this->kSize));
+  fluid_dynamics::Grid<TypeParam> expected = solver.Solve(this->kSize, this->kSize, this->PlateBound(this->kSize));
+  fluid_dynamics::Grid<TypeParam> uniform = fluid_dynamics::SolutionCache<TypeParam>::Prolongate(
+      coarse.Solve(coarse_size, coarse_size, this->PlateBound(coarse_size)), this->kSize, this->kSize);
+
+  ASSERT_EQ(amr.levels().size(), 3u);
+  EXPECT_LT(amr.patches(2), amr.levels()[2].tile_rows * amr.levels()[2].tile_cols);
+  EXPECT_LT(amr.cells(), this->kSize * this->kSize);
+
+  TypeParam amr_error = 0;
+  TypeParam uniform_error = 0;
+  for (size_t i = 0; i < this->kSize; ++i) {
+    for (size_t j = 0; j < this->kSize; ++j) {
+      amr_error += (result(i, j) - expected(i, j)) * (result(i, j) - expected(i, j));
+      uniform_error += (uniform(i, j) - expected(i, j)) * (uniform(i, j) - expected(i, j));
+    }
+  }
+  EXPECT_LT(amr_error, uniform_error / 4);
+}
+
+TYPED_TEST(SolverAmrTest, GradientThresholdDrivesRefinement) {
+  fluid_dynamics::Bound<TypeParam> bound(fluid_dynamics::BoundaryType::kDirichlet);
+  fluid_dynamics::AmrOptions options = this->Options(1, 4);
+  size_t size = this->kSize;
+
+  bound.AddBoundary({[size](size_t i, size_t j) { return i == 0 || j == 0 || i == size - 1 || j == size - 1; },
+                     [](size_t i, size_t) { return i == 0 ? TypeParam{1} : TypeParam{0}; }});
+  options.boundary_distance = 0;
+
+  options.gradient_threshold = 10.0;
+  fluid_dynamics::SolverAmr<TypeParam> flat(static_cast<TypeParam>(1e-6), 10000);
+  flat.options(options);
+  flat.Solve(size, size, bound);
+  EXPECT_EQ(flat.levels().size(), 1u);
+
+  options.gradient_threshold = 0.05;
+  fluid_dynamics::SolverAmr<TypeParam> steep(static_cast<TypeParam>(1e-6), 10000);
+  steep.options(options);
+  steep.Solve(size, size, bound);
+  ASSERT_EQ(steep.levels().size(), 2u);
+  EXPECT_GT(steep.patches(1), 0u);
+  EXPECT_LT(steep.patches(1), steep.levels()[1].tile_rows * steep.levels()[1].tile_cols);
+}
+
+TYPED_TEST(SolverAmrTest, RejectsUnsupportedProblems) {
+  fluid_dynamics::SolverAmr<TypeParam> amr;
+  fluid_dynamics::Bound<TypeParam> periodic(fluid_dynamics::BoundaryType::kPeriodic);
+
+  amr.options(this->Options(2, 4));
+  EXPECT_THROW(amr.Solve(this->kSize + 1, this->kSize, this->PlateBound(this->kSize)), std::invalid_argument);
+  EXPECT_THROW(amr.Solve(this->kSize, this->kSize, periodic), std::invalid_argument);
+  EXPECT_THROW(amr.options(this->Options(2, 1)), std::invalid_argument);
+}
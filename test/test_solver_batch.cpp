@@ -0,0 +1,119 @@
+// File: test/test_solver_batch.cpp
+#include <gtest/gtest.h>
+#include "test_utils.h"
+#include "poisson2d/poisson2d.h"
+
+using BatchStencilTypes = ::testing::Types<
+    fluid_dynamics::FivePoint,
+    fluid_dynamics::NinePoint,
+    fluid_dynamics::FourthOrder
+>;
+
+template<typename Stencil>
+class SolverBatchSolve : public ::testing::Test {
+ protected:
+  static constexpr size_t kSize = 14;
+  static constexpr size_t kMembers = 5;
+
+  // Same frame for every member, the lid value and the source scale with the member index.
+  static fluid_dynamics::Bound<double> MemberBound(size_t member) {
+    fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+    bound.AddBoundary({[](size_t i, size_t) { return i == 0; },
+                       [member](size_t, size_t) { return static_cast<double>(member + 1); }});
+    bound.AddBoundary({[](size_t i, size_t j) { return j == 0 || i == kSize - 1 || j == kSize - 1; },
+                       [](size_t, size_t) { return 0.0; }});
+
+    return bound;
+  }
+
+  static fluid_dynamics::Grid<double> MemberSource(size_t member) {
+    fluid_dynamics::Grid<double> source(kSize);
+
+    source.Fill(static_cast<double>(member) * 0.01);
+
+    return source;
+  }
+};
+
+TYPED_TEST_SUITE(SolverBatchSolve, BatchStencilTypes);
+
+TYPED_TEST(SolverBatchSolve, MatchesIndividualSolves) {
+  fluid_dynamics::SolverBatch<double, TypeParam> batch(1e-12, 300);
+  std::vector<fluid_dynamics::Bound<double>> bounds;
+  std::vector<fluid_dynamics::Grid<double>> sources;
+
+  for (size_t m = 0; m < this->kMembers; ++m) {
+    bounds.push_back(this->MemberBound(m));
+    sources.push_back(this->MemberSource(m));
+  }
+  std::vector<fluid_dynamics::Grid<double>> results = batch.Solve(this->kSize, this->kSize, bounds, sources);
+
+  ASSERT_EQ(results.size(), this->kMembers);
+  for (size_t m = 0; m < this->kMembers; ++m) {
+    fluid_dynamics::Solver<double, TypeParam> solver(1e-12, 300);
+    solver.source(sources[m]);
+    fluid_dynamics::Grid<double> expected = solver.Solve(this->kSize, this->kSize, bounds[m]);
+
+    EXPECT_EQ(batch.iterations()[m], 300u);
+    for (size_t i = 0; i < this->kSize; ++i) {
+      for (size_t j = 0; j < this->kSize; ++j) {
+        EXPECT_DOUBLE_EQ(results[m](i, j), expected(i, j));
+      }
+    }
+  }
+}
+
+TYPED_TEST(SolverBatchSolve, RetiresConvergedMembers) {
+  fluid_dynamics::SolverBatch<double, TypeParam> batch(1e-6, 100000);
+  std::vector<fluid_dynamics::Bound<double>> bounds;
+  std::vector<fluid_dynamics::Grid<double>> sources;
+
+  for (size_t m = 0; m < this->kMembers; ++m) {
+    bounds.push_back(this->MemberBound(m));
+    sources.push_back(this->MemberSource(m));
+  }
+  std::vector<fluid_dynamics::Grid<double>> results = batch.Solve(this->kSize, this->kSize, bounds, sources);
+
+  for (size_t m = 0; m < this->kMembers; ++m) {
+    fluid_dynamics::Solver<double, TypeParam> solver(1e-6, 100000);
+    solver.source(sources[m]);
+    fluid_dynamics::Grid<double> expected = solver.Solve(this->kSize, this->kSize, bounds[m]);
+
+    EXPECT_LT(batch.iterations()[m], 100000u);
+    EXPECT_LT(batch.norms()[m], 1e-12);
+    for (size_t i = 0; i < this->kSize; ++i) {
+      for (size_t j = 0; j < this->kSize; ++j) {
+        EXPECT_NEAR(results[m](i, j), expected(i, j), 1e-4);
+      }
+    }
+  }
+  EXPECT_LT(batch.iterations()[0], batch.iterations()[this->kMembers - 1]);
+}
+
+TEST(SolverBatchValidation, RejectsMismatchedInputs) {
+  fluid_dynamics::SolverBatch<double> batch;
+  std::vector<fluid_dynamics::Bound<double>> bounds(2);
+  std::vector<fluid_dynamics::Grid<double>> sources(1, fluid_dynamics::Grid<double>(8));
+
+  EXPECT_THROW(batch.Solve(8, 8, {}), std::invalid_argument);
+  EXPECT_THROW(batch.Solve(8, 8, bounds, sources), std::invalid_argument);
+  bounds[1].AddBoundary({[](size_t, size_t) { return false; }, [](size_t, size_t) { return 0.0; }});
+  sources.push_back(fluid_dynamics::Grid<double>(8));
+  EXPECT_THROW(batch.Solve(8, 8, bounds, sources), std::invalid_argument);
+}
+
+// Same number of boundaries but the second member covers another row, its values must not be
+// sampled at the cells of the first.
+TEST(SolverBatchValidation, RejectsDifferentConditions) {
+  fluid_dynamics::SolverBatch<double> batch;
+  std::vector<fluid_dynamics::Bound<double>> bounds(2);
+
+  bounds[0].AddBoundary({[](size_t i, size_t) { return i == 0; }, [](size_t, size_t) { return 1.0; }});
+  bounds[1].AddBoundary({[](size_t i, size_t) { return i == 1; }, [](size_t, size_t) { return 2.0; }});
+  EXPECT_THROW(batch.Solve(8, 8, bounds), std::invalid_argument);
+
+  bounds[1] = fluid_dynamics::Bound<double>{};
+  bounds[1].AddBoundary({[](size_t i, size_t) { return i == 0; }, [](size_t, size_t) { return 2.0; }});
+  EXPECT_NO_THROW(batch.Solve(8, 8, bounds));
+}
@@ -0,0 +1,75 @@
+// File: test/test_solver_mixed.cpp
+#include <cmath>
+#include <gtest/gtest.h>
+#include "poisson2d/poisson2d.h"
+
+using MixedStencils = ::testing::Types<fluid_dynamics::FivePoint, fluid_dynamics::NinePoint, fluid_dynamics::FourthOrder>;
+
+template<typename Stencil>
+class SolverMixedTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kSize = 24;
+
+  static fluid_dynamics::Bound<double> LidBound(size_t size) {
+    fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+    bound.AddBoundary({[size](size_t i, size_t j) { return i == 0 || j == 0 || i == size - 1 || j == size - 1; },
+                       [](size_t i, size_t j) { return i == 0 ? 1.0 + 0.01 * static_cast<double>(j) : 0.0; }});
+    bound.AddBoundary({[size](size_t i, size_t j) { return i == size / 2 && j > size / 4 && j < 3 * size / 4; },
+                       [](size_t, size_t) { return 0.5; }});
+
+    return bound;
+  }
+};
+
+TYPED_TEST_SUITE(SolverMixedTest, MixedStencils);
+
+TYPED_TEST(SolverMixedTest, MatchesDoubleSolve) {
+  fluid_dynamics::Bound<double> bound = this->LidBound(this->kSize);
+  fluid_dynamics::Solver<double, TypeParam> reference(1e-8, 100000);
+  fluid_dynamics::SolverMixed<double, TypeParam> mixed(1e-8, 100000);
+  reference.source([](size_t i, size_t) { return 0.01 * std::sin(0.3 * static_cast<double>(i)); });
+  mixed.source([](size_t i, size_t) { return 0.01 * std::sin(0.3 * static_cast<double>(i)); });
+
+  fluid_dynamics::Grid<double> expected = reference.Solve(this->kSize, this->kSize, bound);
+  fluid_dynamics::Grid<double> actual = mixed.Solve(this->kSize, this->kSize, bound);
+
+  EXPECT_GT(mixed.refinements(), 1u);
+  EXPECT_LT(mixed.refinements(), mixed.max_refinements());
+  for (size_t i = 0; i < this->kSize; ++i) {
+    for (size_t j = 0; j < this->kSize; ++j) {
+      EXPECT_NEAR(actual(i, j), expected(i, j), 1e-5);
+    }
+  }
+  EXPECT_EQ(actual(this->kSize / 2, this->kSize / 2), 0.5);
+  EXPECT_EQ(actual(0, 3), 1.03);
+}
+
+TYPED_TEST(SolverMixedTest, StopsAfterMaxRefinements) {
+  fluid_dynamics::Bound<double> bound = this->LidBound(this->kSize);
+  fluid_dynamics::SolverMixed<double, TypeParam> mixed(1e-12, 100000);
+  mixed.max_refinements(1);
+
+  mixed.Solve(this->kSize, this->kSize, bound);
+
+  EXPECT_EQ(mixed.refinements(), 1u);
+  EXPECT_GT(mixed.iterations(), 0u);
+}
+
+TEST(SolverMixedConversion, GridAndBoundConvertValues) {
+  fluid_dynamics::Grid<double> grid(2, 3);
+  grid.Fill([](size_t i, size_t j) { return 0.1 + static_cast<double>(3 * i + j); });
+  fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kDirichlet);
+  bound.AddBoundary({[](size_t i, size_t) { return i == 0; }, [](size_t, size_t j) { return 0.1 * static_cast<double>(j); }});
+
+  fluid_dynamics::Grid<float> low_grid{grid};
+  fluid_dynamics::Bound<float> low_bound{bound};
+
+  ASSERT_EQ(low_grid.rows(), 2u);
+  ASSERT_EQ(low_grid.cols(), 3u);
+  EXPECT_FLOAT_EQ(low_grid(1, 2), 5.1f);
+  ASSERT_EQ(low_bound.size(), 1u);
+  EXPECT_TRUE(low_bound.boundaries()[0].condition(0, 7));
+  EXPECT_FALSE(low_bound.boundaries()[0].condition(1, 7));
+  EXPECT_FLOAT_EQ(low_bound.boundaries()[0].value(0, 3), 0.3f);
+}
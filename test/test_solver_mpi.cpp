@@ -0,0 +1,238 @@
+// File: test/test_solver_mpi.cpp
+#include <gtest/gtest.h>
+#include <cmath>
+#include "test_mpi_utils.h"
+
+using MpiStencilTypes = ::testing::Types<
+    fluid_dynamics::FivePoint,
+    fluid_dynamics::NinePoint,
+    fluid_dynamics::FourthOrder
+>;
+
+template<typename Stencil>
+class SolverMpiStencilTest : public ::testing::Test {
+ protected:
+  static double Source(size_t i, size_t j) {
+    return std::sin(static_cast<double>(i + 2 * j));
+  }
+};
+
+TYPED_TEST_SUITE(SolverMpiStencilTest, MpiStencilTypes);
+
+// Only the cell on the corner of both seams is fixed, so the ranks on the edges of the process grid
+// relax against ghosts from the opposite side. A fixed number of sweeps matches the serial solve bit
+// for bit.
+TYPED_TEST(SolverMpiStencilTest, PeriodicMatchesSerial) {
+  fluid_dynamics::MpiGrid2D periodic(MPI_COMM_WORLD, true);
+  fluid_dynamics::Solver<double, TypeParam> serial(0.0, 300);
+  fluid_dynamics::SolverMpi<double, TypeParam> solver(0.0, 300);
+  fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kPeriodic);
+
+  bound.AddBoundary({[](size_t i, size_t j) { return i == 0 && j == 0; },
+                     [](size_t, size_t) { return 1.0; }});
+  serial.source(this->Source);
+  solver.source(this->Source);
+  fluid_dynamics::Grid<double> expected = serial.Solve(kRows, kCols, bound);
+  fluid_dynamics::Grid<double> local = solver.Solve(periodic.LocalRows(kRows), periodic.LocalCols(kCols),
+                                                    bound, periodic);
+
+  ExpectGridEq(local, LocalBlock(expected, periodic));
+  EXPECT_THROW(solver.Solve(mpi_grid->LocalRows(kRows), mpi_grid->LocalCols(kCols), bound, *mpi_grid),
+               std::invalid_argument);
+}
+
+namespace {
+
+fluid_dynamics::Bound<double> GroundedFrame() {
+  fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+  bound.AddBoundary({[](size_t i, size_t j) { return i == 0 || j == 0 || i == kRows - 1 || j == kCols - 1; },
+                     [](size_t, size_t) { return 0.0; }});
+  return bound;
+}
+
+double CornerSource(size_t i, size_t j) {
+  return (i >= 2 && i < 6 && j >= 2 && j < 6) ? 1.0 : 0.0;
+}
+
+} // namespace
+
+// Tiles far from the source freeze, most of them on ranks that do not own it, so the solve only stops
+// once the summed frozen tile count is zero on every rank.
+TEST(SolverMpiActiveSet, MatchesFullSweeps) {
+  fluid_dynamics::SolverMpi<double> full(1e-6, 100000);
+  fluid_dynamics::SolverMpi<double> tiled(1e-6, 100000);
+  fluid_dynamics::Bound<double> bound = GroundedFrame();
+  size_t rows = mpi_grid->LocalRows(kRows);
+  size_t cols = mpi_grid->LocalCols(kCols);
+  unsigned long skipped;
+
+  full.source(CornerSource);
+  tiled.source(CornerSource);
+  tiled.active_set(4);
+  fluid_dynamics::Grid<double> expected = full.Solve(rows, cols, bound, *mpi_grid);
+  fluid_dynamics::Grid<double> result = tiled.Solve(rows, cols, bound, *mpi_grid);
+  skipped = tiled.active_set().skipped();
+  MPI_Allreduce(MPI_IN_PLACE, &skipped, 1, MPI_UNSIGNED_LONG, MPI_SUM, mpi_grid->comm());
+
+  EXPECT_LT(tiled.iterations(), 100000u);
+  EXPECT_GT(skipped, 0u);
+  EXPECT_EQ(tiled.active_set().frozen_count(), 0u);
+  ExpectGridNear(result, expected, 1e-4);
+}
+
+// With a custom norm the master thread compares the padded blocks and exclude_boundaries only skips
+// the outer ghost ring, so the inner ring of the 4th order stencil must not show up as change.
+TEST(SolverMpiCustomNorm, FourthOrderMatchesDefaultNorm) {
+  fluid_dynamics::SolverMpi<double, fluid_dynamics::FourthOrder> reference(1e-6, 20000);
+  fluid_dynamics::SolverMpi<double, fluid_dynamics::FourthOrder> custom(1e-6, 20000);
+  fluid_dynamics::Bound<double> bound = GroundedFrame();
+  size_t rows = mpi_grid->LocalRows(kRows);
+  size_t cols = mpi_grid->LocalCols(kCols);
+
+  reference.source(CornerSource);
+  custom.source(CornerSource);
+  custom.norm([](const fluid_dynamics::Grid<double>& prev, const fluid_dynamics::Grid<double>& curr,
+                 bool exclude_boundaries) {
+    size_t skip = exclude_boundaries ? 1 : 0;
+    double norm = 0;
+    for (size_t i = skip; i < prev.rows() - skip; ++i) {
+      for (size_t j = skip; j < prev.cols() - skip; ++j) {
+        norm += (prev(i, j) - curr(i, j)) * (prev(i, j) - curr(i, j));
+      }
+    }
+    return norm;
+  });
+  fluid_dynamics::Grid<double> expected = reference.Solve(rows, cols, bound, *mpi_grid);
+  fluid_dynamics::Grid<double> result = custom.Solve(rows, cols, bound, *mpi_grid);
+
+  EXPECT_LT(reference.iterations(), 20000u);
+  EXPECT_EQ(custom.iterations(), reference.iterations());
+  ExpectGridEq(result, expected);
+}
+
+// Float halos are only used while the norm is large and the compensated norm only changes the
+// rounding of the convergence test, so both stop at the fixed point of the default solve.
+TEST(SolverMpiNormModes, ConvergeToDefaultFixedPoint) {
+  fluid_dynamics::SolverMpi<double> reference(1e-6, 100000);
+  fluid_dynamics::SolverMpi<double> float_halos(1e-6, 100000);
+  fluid_dynamics::SolverMpi<double> compensated(1e-6, 100000);
+  fluid_dynamics::Bound<double> bound = GroundedFrame();
+  size_t rows = mpi_grid->LocalRows(kRows);
+  size_t cols = mpi_grid->LocalCols(kCols);
+
+  reference.source(CornerSource);
+  float_halos.source(CornerSource);
+  compensated.source(CornerSource);
+  float_halos.float_halos(1e-4);
+  compensated.compensated_norm(true);
+  fluid_dynamics::Grid<double> expected = reference.Solve(rows, cols, bound, *mpi_grid);
+
+  EXPECT_LT(reference.iterations(), 100000u);
+  ExpectGridNear(float_halos.Solve(rows, cols, bound, *mpi_grid), expected, 1e-4);
+  EXPECT_LT(float_halos.iterations(), 100000u);
+  ExpectGridNear(compensated.Solve(rows, cols, bound, *mpi_grid), expected, 1e-4);
+  EXPECT_LT(compensated.iterations(), 100000u);
+}
+
+// Every thread relaxes its band of rows in place against a window of old rows, which reads the same
+// values as the two-grid sweep, so both take the same path on every rank.
+TYPED_TEST(SolverMpiStencilTest, LowMemoryMatchesTwoGrids) {
+  fluid_dynamics::SolverMpi<double, TypeParam> two_grids(1e-6, 20000);
+  fluid_dynamics::SolverMpi<double, TypeParam> in_place(1e-6, 20000);
+  fluid_dynamics::Bound<double> bound = GroundedFrame();
+  size_t rows = mpi_grid->LocalRows(kRows);
+  size_t cols = mpi_grid->LocalCols(kCols);
+
+  two_grids.source(this->Source);
+  in_place.source(this->Source);
+  in_place.low_memory(true);
+  in_place.report_peak_memory(true);
+  fluid_dynamics::Grid<double> expected = two_grids.Solve(rows, cols, bound, *mpi_grid);
+  fluid_dynamics::Grid<double> result = in_place.Solve(rows, cols, bound, *mpi_grid);
+
+  EXPECT_LT(two_grids.iterations(), 20000u);
+  EXPECT_EQ(in_place.iterations(), two_grids.iterations());
+  ExpectGridEq(result, expected);
+  EXPECT_EQ(two_grids.peak_memory(), 0u);
+#ifdef __linux__
+  EXPECT_GT(in_place.peak_memory(), 0u);
+#endif
+}
+
+// The float corrections only change the path, each refinement measures the residual in double, so
+// the mixed solve stops within epsilon of the double solve and keeps the fixed cells exact.
+TYPED_TEST(SolverMpiStencilTest, MixedMatchesDoubleSolve) {
+  fluid_dynamics::SolverMpi<double, TypeParam> reference(1e-8, 100000);
+  fluid_dynamics::SolverMixedMpi<double, TypeParam> mixed(1e-8, 100000);
+  fluid_dynamics::Bound<double> bound = GroundedFrame();
+  size_t rows = mpi_grid->LocalRows(kRows);
+  size_t cols = mpi_grid->LocalCols(kCols);
+
+  reference.source(CornerSource);
+  mixed.source(CornerSource);
+  fluid_dynamics::Grid<double> expected = reference.Solve(rows, cols, bound, *mpi_grid);
+  fluid_dynamics::Grid<double> result = mixed.Solve(rows, cols, bound, *mpi_grid);
+
+  EXPECT_GT(mixed.refinements(), 1u);
+  EXPECT_LT(mixed.refinements(), mixed.max_refinements());
+  ExpectGridNear(result, expected, 1e-5);
+  if (mpi_grid->row() == 0) {
+    EXPECT_EQ(result(0, cols - 1), 0.0);
+  }
+}
+
+// A switch norm below epsilon is raised to it, and the sweep that first drops below epsilon on float
+// halos is followed by one on exact halos, so the solve converges to the double fixed point far
+// below float precision instead of stalling on the rounded halos.
+TEST(SolverMpiNormModes, FloatHalosBelowEpsilonConvergeExactly) {
+  fluid_dynamics::SolverMpi<double> reference(1e-12, 200000);
+  fluid_dynamics::SolverMpi<double> float_halos(1e-12, 200000);
+  fluid_dynamics::Bound<double> bound = GroundedFrame();
+  size_t rows = mpi_grid->LocalRows(kRows);
+  size_t cols = mpi_grid->LocalCols(kCols);
+
+  reference.source(CornerSource);
+  float_halos.source(CornerSource);
+  float_halos.float_halos(1e-26);
+  fluid_dynamics::Grid<double> expected = reference.Solve(rows, cols, bound, *mpi_grid);
+  fluid_dynamics::Grid<double> result = float_halos.Solve(rows, cols, bound, *mpi_grid);
+
+  EXPECT_LT(reference.iterations(), 200000u);
+  EXPECT_LT(float_halos.iterations(), 200000u);
+  ExpectGridNear(result, expected, 1e-9);
+}
+
+// An obstacle straddling the rank seams puts wall cells next to ghost cells, and the lid row only
+// lives on the first rank row. With a fixed number of Poisson sweeps per step every rank computes
+// the serial values, so the gathered fields match the global simulation bit for bit.
+TEST(FlowSimulationMpi, MatchesSerialSimulation) {
+  fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kDirichlet);
+  fluid_dynamics::FlowOptions options;
+  fluid_dynamics::FlowSimulation<double> serial(0.0, 40);
+  fluid_dynamics::Grid<double> psi, omega;
+
+  bound.AddBoundary({[](size_t i, size_t j) { return i >= 10 && i < 14 && j >= 14 && j < 22; },
+                     [](size_t, size_t) { return 0.0; }});
+  options.time_step = 0.25;
+  options.viscosity = 0.5;
+  serial.options(options);
+  serial.Initialize(kRows, kCols, bound);
+  serial.Run(20);
+  {
+    fluid_dynamics::FlowSimulationMpi<double> flow(*mpi_grid, 0.0, 40);
+
+    flow.options(options);
+    flow.Initialize(mpi_grid->LocalRows(kRows), mpi_grid->LocalCols(kCols), bound);
+    flow.Run(20);
+    EXPECT_EQ(flow.steps(), 20u);
+    psi = fluid_dynamics::DistributedGrid<double>(*mpi_grid, flow.streamfunction()).Gather();
+    omega = fluid_dynamics::DistributedGrid<double>(*mpi_grid, flow.vorticity()).Gather();
+  }
+
+  if (mpi_grid->rank() == 0) {
+    EXPECT_NE(serial.vorticity()(0, kCols / 2), 0.0);
+    ExpectGridEq(psi, serial.streamfunction());
+    ExpectGridEq(omega, serial.vorticity());
+  }
+}
@@ -0,0 +1,141 @@
+// File: test/test_solver_mpi3d.cpp
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "test_mpi_utils.h"
+
+namespace {
+
+// Unequal extents divide over the process grids of 1, 2 and 4 ranks for every decomposition and
+// catch a mixed up axis.
+constexpr size_t kNx = 8;
+constexpr size_t kNy = 12;
+constexpr size_t kNz = 6;
+
+double Global(size_t i, size_t j, size_t k) {
+  return static_cast<double>(10000 * i + 100 * j + k);
+}
+
+fluid_dynamics::Bound3D<double> PlateBound() {
+  fluid_dynamics::Bound3D<double> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+  bound.AddBoundary({[](size_t i, size_t j, size_t k) {
+                       return i == 0 || j == 0 || k == 0 || i == kNx - 1 || j == kNy - 1 || k == kNz - 1;
+                     },
+                     [](size_t i, size_t j, size_t k) { return static_cast<double>(i + 2 * j + 3 * k) / 40; }});
+  bound.AddBoundary({[](size_t i, size_t j, size_t k) { return i == kNx / 2 && j >= 3 && j <= 8 && k == 2; },
+                     [](size_t, size_t, size_t) { return 0.5; }});
+  return bound;
+}
+
+double PlateSource(size_t i, size_t j, size_t k) {
+  return 0.01 * static_cast<double>((i * 7 + j * 3 + k) % 5);
+}
+
+// Exposes the halo exchange of the distributed solver.
+class HaloExchange : public fluid_dynamics::SolverMpi3D<double> {
+ public:
+  using fluid_dynamics::SolverMpi3D<double>::ExchangeHalo;
+};
+
+} // namespace
+
+class SolverMpi3DTest : public ::testing::TestWithParam<fluid_dynamics::Decomposition> {};
+
+// The x, y and z exchanges run one after the other and each forwards the halo received before, so
+// edge and corner ghosts are filled from the diagonal neighbours too. Ghosts outside the global
+// domain keep their value.
+TEST_P(SolverMpi3DTest, ExchangeFillsFacesEdgesAndCorners) {
+  fluid_dynamics::MpiGrid3D grid3d(mpi_grid->comm(), GetParam());
+  size_t nx = grid3d.LocalSize(0, kNx);
+  size_t ny = grid3d.LocalSize(1, kNy);
+  size_t nz = grid3d.LocalSize(2, kNz);
+  std::array<size_t, 3> origin{grid3d.GlobalIndex(0, 0, nx), grid3d.GlobalIndex(1, 0, ny),
+                               grid3d.GlobalIndex(2, 0, nz)};
+  fluid_dynamics::Grid3D<double> padded(nx + 2, ny + 2, nz + 2);
+
+  padded.Fill([&](size_t i, size_t j, size_t k) {
+    bool interior = i >= 1 && i <= nx && j >= 1 && j <= ny && k >= 1 && k <= nz;
+    return interior ? Global(origin[0] + i - 1, origin[1] + j - 1, origin[2] + k - 1) : -1.0;
+  });
+  grid3d.CreateFaceTypes(nx, ny, nz, 1, fluid_dynamics::MpiType<double>());
+  HaloExchange::ExchangeHalo(padded, grid3d);
+  grid3d.FreeTypes();
+
+  for (size_t i = 0; i < nx + 2; ++i) {
+    for (size_t j = 0; j < ny + 2; ++j) {
+      for (size_t k = 0; k < nz + 2; ++k) {
+        // Unsigned wrap turns the ghost before the domain into a huge index.
+        size_t gi = origin[0] + i - 1;
+        size_t gj = origin[1] + j - 1;
+        size_t gk = origin[2] + k - 1;
+        bool inside = gi < kNx && gj < kNy && gk < kNz;
+        ASSERT_EQ(padded(i, j, k), inside ? Global(gi, gj, gk) : -1.0) << i << " " << j << " " << k;
+      }
+    }
+  }
+}
+
+// A fixed number of sweeps runs the same kernel on the same values as the serial solve, so the
+// blocks, their gradients and the velocity file match it bit for bit for every decomposition.
+TEST_P(SolverMpi3DTest, MatchesSerialSolve) {
+  fluid_dynamics::MpiGrid3D grid3d(mpi_grid->comm(), GetParam());
+  size_t nx = grid3d.LocalSize(0, kNx);
+  size_t ny = grid3d.LocalSize(1, kNy);
+  size_t nz = grid3d.LocalSize(2, kNz);
+  std::array<size_t, 3> origin{grid3d.GlobalIndex(0, 0, nx), grid3d.GlobalIndex(1, 0, ny),
+                               grid3d.GlobalIndex(2, 0, nz)};
+  fluid_dynamics::Solver3D<double> serial(0.0, 150);
+  fluid_dynamics::SolverMpi3D<double> solver(0.0, 150);
+  std::string filename = "test_solver_mpi3d.bin";
+
+  serial.source(PlateSource);
+  solver.source(PlateSource);
+  fluid_dynamics::Grid3D<double> expected = serial.Solve(kNx, kNy, kNz, PlateBound());
+  fluid_dynamics::Grid3D<std::array<double, 3>> expected_grad = serial.Gradient(expected);
+  fluid_dynamics::Grid3D<double> local = solver.Solve(nx, ny, nz, PlateBound(), grid3d);
+  fluid_dynamics::Grid3D<std::array<double, 3>> grad = solver.Gradient(local, grid3d);
+
+  size_t value_mismatches = 0;
+  size_t grad_mismatches = 0;
+
+  EXPECT_EQ(solver.iterations(), serial.iterations());
+  for (size_t i = 0; i < nx; ++i) {
+    for (size_t j = 0; j < ny; ++j) {
+      for (size_t k = 0; k < nz; ++k) {
+        value_mismatches += local(i, j, k) != expected(origin[0] + i, origin[1] + j, origin[2] + k);
+        grad_mismatches += grad(i, j, k) != expected_grad(origin[0] + i, origin[1] + j, origin[2] + k);
+      }
+    }
+  }
+  EXPECT_EQ(value_mismatches, 0u);
+  EXPECT_EQ(grad_mismatches, 0u);
+
+  fluid_dynamics::Grid3D<std::array<double, 3>> velocity = solver.Velocity(grad);
+  WriteGridBinary(velocity, filename, grid3d);
+  if (mpi_grid->rank() == 0) {
+    fluid_dynamics::Grid3D<std::array<double, 3>> expected_velocity = serial.Velocity(expected_grad);
+    fluid_dynamics::Grid3D<std::array<double, 3>> written(kNx, kNy, kNz);
+    std::ifstream file{filename, std::ios::binary};
+
+    file.read(reinterpret_cast<char*>(written.data()), kNx * kNy * kNz * 3 * sizeof(double));
+    EXPECT_TRUE(file.good());
+    for (size_t i = 0; i < kNx; ++i) {
+      for (size_t j = 0; j < kNy; ++j) {
+        for (size_t k = 0; k < kNz; ++k) {
+          EXPECT_EQ(written(i, j, k), expected_velocity(i, j, k)) << i << " " << j << " " << k;
+        }
+      }
+    }
+    file.close();
+    std::remove(filename.c_str());
+  }
+  MPI_Barrier(mpi_grid->comm());
+}
+
+INSTANTIATE_TEST_SUITE_P(Decompositions, SolverMpi3DTest,
+                         ::testing::Values(fluid_dynamics::Decomposition::kSlab,
+                                           fluid_dynamics::Decomposition::kPencil,
+                                           fluid_dynamics::Decomposition::kBlock));
@@ -0,0 +1,159 @@
+// File: test/test_stencil.cpp
+#include <cmath>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+#include "poisson2d/poisson2d.h"
+
+using StencilTypes = ::testing::Types<
+    fluid_dynamics::FivePoint,
+    fluid_dynamics::NinePoint,
+    fluid_dynamics::FourthOrder
+>;
+
+template<typename Stencil>
+class StencilSolve : public ::testing::Test {
+ protected:
+  static constexpr size_t kSize = 16;
+
+  // phi = i^2 + j^2 solves -laplace(phi) = -4 and is reproduced exactly by every stencil.
+  static double Exact(size_t i, size_t j) {
+    return static_cast<double>(i * i + j * j);
+  }
+
+  static fluid_dynamics::Bound<double> FrameBound() {
+    fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kDirichlet);
+
+    bound.AddBoundary({
+                          [](size_t i, size_t j) {
+                            return i == 0 || j == 0 || i == kSize - 1 || j == kSize - 1;
+                          },
+                          Exact
+                      });
+
+    return bound;
+  }
+};
+
+TYPED_TEST_SUITE(StencilSolve, StencilTypes);
+
+TYPED_TEST(StencilSolve, QuadraticSolution) {
+  fluid_dynamics::Solver<double, TypeParam> solver(1e-13, 50000);
+  fluid_dynamics::Bound<double> bound = this->FrameBound();
+
+  solver.source([](size_t, size_t) { return -4.0; });
+  fluid_dynamics::Grid<double> grid = solver.Solve(this->kSize, this->kSize, bound);
+
+  for (size_t i = 0; i < grid.rows(); ++i) {
+    for (size_t j = 0; j < grid.cols(); ++j) {
+      EXPECT_NEAR(grid(i, j), this->Exact(i, j), 1e-9);
+    }
+  }
+}
+
+// Channel with walls at the first and last row, periodic in the other direction:
+// phi = i * (L - 1 - i) / 2 solves -laplace(phi) = 1 independently of the column.
+TYPED_TEST(StencilSolve, PeriodicChannel) {
+  fluid_dynamics::Solver<double, TypeParam> solver(1e-13, 50000);
+  fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kPeriodic);
+  size_t L = this->kSize;
+
+  bound.AddBoundary({[L](size_t i, size_t) { return i == 0 || i == L - 1; },
+                     [](size_t, size_t) { return 0.0; }});
+  solver.source([](size_t, size_t) { return 1.0; });
+  fluid_dynamics::Grid<double> grid = solver.Solve(L, L + 4, bound);
+
+  ASSERT_EQ(grid.rows(), L);
+  ASSERT_EQ(grid.cols(), L + 4);
+  for (size_t i = 0; i < grid.rows(); ++i) {
+    for (size_t j = 0; j < grid.cols(); ++j) {
+      EXPECT_NEAR(grid(i, j), 0.5 * static_cast<double>(i * (L - 1 - i)), 1e-9);
+    }
+  }
+}
+
+// Only the cell on the corner of both seams is fixed, every other cell relaxes through the wrap. At
+// convergence each satisfies the 5-point equation with neighbours taken modulo the grid size, and the
+// solution mirrors about the fixed cell, so row 1 matches the last row and column 1 the last column.
+TEST(PeriodicSolve, WrapsAcrossBothSeams) {
+  fluid_dynamics::Solver<double> solver(1e-13, 100000);
+  fluid_dynamics::Bound<double> bound(fluid_dynamics::BoundaryType::kPeriodic);
+  size_t rows = 9;
+  size_t cols = 13;
+
+  bound.AddBoundary({[](size_t i, size_t j) { return i == 0 && j == 0; },
+                     [](size_t, size_t) { return 0.0; }});
+  solver.source([](size_t, size_t) { return 1.0; });
+  fluid_dynamics::Grid<double> grid = solver.Solve(rows, cols, bound);
+
+  ASSERT_EQ(grid.rows(), rows);
+  ASSERT_EQ(grid.cols(), cols);
+  EXPECT_EQ(grid(0, 0), 0.0);
+  EXPECT_GT(grid(rows / 2, cols / 2), grid(1, 1));
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      EXPECT_NEAR(grid(i, j), grid((rows - i) % rows, (cols - j) % cols), 1e-9) << i << " " << j;
+      if (i == 0 && j == 0) {
+        continue;
+      }
+      double neighbours = grid((i + rows - 1) % rows, j) + grid((i + 1) % rows, j)
+                          + grid(i, (j + cols - 1) % cols) + grid(i, (j + 1) % cols);
+      EXPECT_NEAR(grid(i, j), 0.25 * (neighbours + 1.0), 1e-9) << i << " " << j;
+    }
+  }
+}
+
+TYPED_TEST(StencilSolve, GradientOfQuadratic) {
+  fluid_dynamics::Solver<double, TypeParam> solver;
+  fluid_dynamics::Grid<double> field(this->kSize);
+
+  field.Fill(this->Exact);
+  fluid_dynamics::Grid<std::pair<double, double>> grad = solver.Gradient(field);
+
+  for (size_t i = 1; i < grad.rows() - 1; ++i) {
+    for (size_t j = 1; j < grad.cols() - 1; ++j) {
+      EXPECT_NEAR(grad(i, j).first, 2.0 * static_cast<double>(j), 1e-12);
+      EXPECT_NEAR(grad(i, j).second, 2.0 * static_cast<double>(i), 1e-12);
+    }
+  }
+}
+
+// The in-place sweep reads the same old values as the two-grid sweep, so both take the same path.
+TYPED_TEST(StencilSolve, LowMemoryMatchesTwoGrids) {
+  fluid_dynamics::Solver<double, TypeParam> two_grids(1e-6, 300);
+  fluid_dynamics::Solver<double, TypeParam> in_place(1e-6, 300);
+  fluid_dynamics::Bound<double> bound;
+  size_t rows = 45;
+  size_t cols = 23;
+
+  bound.AddBoundary({[](size_t i, size_t j) { return i == 0 || (i > 10 && i < 14 && j > 5 && j < 9); },
+                     [](size_t i, size_t j) { return static_cast<double>(i + j); }});
+  auto source = [](size_t i, size_t j) { return std::sin(static_cast<double>(i * j)); };
+  two_grids.source(source);
+  in_place.source(source);
+  in_place.low_memory(true);
+  in_place.report_peak_memory(true);
+
+  fluid_dynamics::Grid<double> expected = two_grids.Solve(rows, cols, bound);
+  fluid_dynamics::Grid<double> computed = in_place.Solve(rows, cols, bound);
+
+  ASSERT_EQ(computed.rows(), rows);
+  ASSERT_EQ(computed.cols(), cols);
+  EXPECT_EQ(in_place.iterations(), two_grids.iterations());
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      EXPECT_EQ(computed(i, j), expected(i, j));
+    }
+  }
+#ifdef __linux__
+  EXPECT_GT(in_place.peak_memory(), 0u);
+#endif
+}
+
+TEST(StencilRelax, FivePointMatchesJacobi) {
+  fluid_dynamics::Grid<double> grid(3);
+
+  grid.Fill([](size_t i, size_t j) { return static_cast<double>(3 * i + j); });
+
+  EXPECT_DOUBLE_EQ(fluid_dynamics::Relax<fluid_dynamics::FivePoint>(&grid(1, 1), 3, 2.0),
+                   0.25 * (grid(0, 1) + grid(2, 1) + grid(1, 0) + grid(1, 2) + 2.0));
+}